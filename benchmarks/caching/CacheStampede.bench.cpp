@@ -0,0 +1,197 @@
+/// Hot key expiry under a burst of concurrent requests.
+///
+/// Every scenario fires N requests (default 10'000) at one key whose entry has just expired,
+/// the loader emulates a PgPool query (fixed latency). Compared:
+///  - naive          : plain cache-aside, every miss queries
+///  - single-flight  : CacheAside, misses coalesced into one loader
+///  - swr            : CacheAside + stale-while-revalidate, stale value served, one background refresh
+///  - xfetch         : arrivals spread around expiry, entry renewed before it dies
+///
+/// Usage: cache_stampede_bench [requests] [query_ms] [threads]
+#include "core/caching/CacheAside.h"
+#include "core/caching/InMemoryCache.h"
+#include "core/loggers/LoggerFactory.h"
+#include "core/loggers/LoggerSingleton.h"
+
+#include <algorithm>
+#include <atomic>
+#include <boost/asio.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace net = boost::asio;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    const std::string kKey = "bench:hot";
+
+    struct Settings {
+        std::size_t requests = 10'000;
+        std::chrono::milliseconds queryLatency{20};
+        unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+        /// Only used to print how many queries would wait for a connection
+        std::size_t poolSize = 10;
+    };
+
+    /// Emulated database: counts queries and the peak of concurrent ones
+    struct FakeDb {
+        std::chrono::milliseconds latency;
+        std::string payload = std::string(1024, 'x');
+        std::atomic<std::size_t> queries{0};
+        std::atomic<std::size_t> inflight{0};
+        std::atomic<std::size_t> peakInflight{0};
+    };
+
+    net::awaitable<std::string> fakeQuery(FakeDb& db) {
+        ++db.queries;
+        const std::size_t now = ++db.inflight;
+        std::size_t peak = db.peakInflight.load();
+        while (now > peak && !db.peakInflight.compare_exchange_weak(peak, now)) {}
+
+        net::steady_timer timer(co_await net::this_coro::executor);
+        timer.expires_after(db.latency);
+        co_await timer.async_wait(net::use_awaitable);
+
+        --db.inflight;
+        co_return db.payload;
+    }
+
+    enum class Mode { Naive, Coalesced };
+
+    struct Scenario {
+        const char* name;
+        Mode mode;
+        CacheAside::Options options;
+        /// Logical expiry of the prefilled entry relative to start, negative -> already expired
+        std::chrono::milliseconds expiresIn{0};
+        /// Arrivals are spread uniformly over this window, 0 -> burst
+        std::chrono::milliseconds arrivalWindow{0};
+        bool prefill = true;
+    };
+
+    struct Run {
+        FakeDb& db;
+        CachingInterface& cache;
+        CacheAside& aside;
+        const Scenario& scenario;
+        std::vector<std::int64_t>& latenciesUs;
+    };
+
+    net::awaitable<std::string> naiveGet(Run& run) {
+        if (auto cached = co_await run.cache.get(kKey)) co_return std::move(*cached);
+        std::string value = co_await fakeQuery(run.db);
+        co_await run.cache.set(kKey, value, run.scenario.options.ttl);
+        co_return value;
+    }
+
+    net::awaitable<void> request(Run& run, const std::size_t index, const std::chrono::microseconds delay) {
+        if (delay.count() > 0) {
+            net::steady_timer timer(co_await net::this_coro::executor);
+            timer.expires_after(delay);
+            co_await timer.async_wait(net::use_awaitable);
+        }
+
+        const auto startedAt = Clock::now();
+        if (run.scenario.mode == Mode::Naive) {
+            co_await naiveGet(run);
+        } else {
+            FakeDb& db = run.db;
+            CacheAside::Loader load = [&db]() { return fakeQuery(db); };
+            co_await run.aside.getOrLoad(kKey, std::move(load), run.scenario.options);
+        }
+        run.latenciesUs[index] = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startedAt).count();
+    }
+
+    std::int64_t percentile(std::vector<std::int64_t>& sorted, const double p) {
+        if (sorted.empty()) return 0;
+        const auto idx = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1));
+        return sorted[idx];
+    }
+
+    void runScenario(const Settings& settings, const Scenario& scenario) {
+        net::io_context ioc{static_cast<int>(settings.threads)};
+        const auto cache = std::make_shared<InMemoryCache>();
+        CacheAside aside(cache, ioc.get_executor());
+        FakeDb db{settings.queryLatency};
+        std::vector<std::int64_t> latenciesUs(settings.requests, 0);
+        Run run{db, *cache, aside, scenario, latenciesUs};
+
+        if (scenario.prefill) {
+            // Envelope as if loaded earlier, physically still present
+            CacheAside::Envelope envelope;
+            envelope.expiresAt = std::chrono::system_clock::now() + scenario.expiresIn;
+            envelope.delta = settings.queryLatency;
+            envelope.value = db.payload;
+            const int physicalTtl = scenario.options.ttl + scenario.options.staleWhileRevalidate;
+            net::co_spawn(ioc, cache->set(kKey, CacheAside::encode(envelope), physicalTtl), net::detached);
+            ioc.run();
+            ioc.restart();
+        }
+
+        const auto window = std::chrono::duration_cast<std::chrono::microseconds>(scenario.arrivalWindow);
+        for (std::size_t i = 0; i < settings.requests; ++i) {
+            const auto delay = window.count() > 0
+                ? std::chrono::microseconds(window.count() * static_cast<std::int64_t>(i) / static_cast<std::int64_t>(settings.requests))
+                : std::chrono::microseconds(0);
+            net::co_spawn(ioc, request(run, i, delay), net::detached);
+        }
+
+        const auto startedAt = Clock::now();
+        std::vector<std::thread> threads;
+        threads.reserve(settings.threads);
+        for (unsigned t = 0; t < settings.threads; ++t) threads.emplace_back([&ioc] { ioc.run(); });
+        for (auto& t : threads) t.join();
+        const auto wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - startedAt).count();
+
+        std::ranges::sort(latenciesUs);
+        const std::size_t peak = db.peakInflight.load();
+        std::printf("%-14s queries=%-6zu peak_concurrent=%-6zu pool_waiters=%-6zu p50_ms=%-8.2f p99_ms=%-8.2f max_ms=%-8.2f wall_ms=%lld\n",
+            scenario.name,
+            db.queries.load(),
+            peak,
+            peak > settings.poolSize ? peak - settings.poolSize : 0,
+            static_cast<double>(percentile(latenciesUs, 0.50)) / 1000.0,
+            static_cast<double>(percentile(latenciesUs, 0.99)) / 1000.0,
+            static_cast<double>(latenciesUs.back()) / 1000.0,
+            static_cast<long long>(wallMs)
+        );
+    }
+} // namespace
+
+int main(const int argc, char** argv) {
+    LoggerSingleton::init(LoggerFactory::create("console"));
+
+    Settings settings;
+    if (argc > 1) settings.requests = std::strtoull(argv[1], nullptr, 10);
+    if (argc > 2) settings.queryLatency = std::chrono::milliseconds(std::strtoll(argv[2], nullptr, 10));
+    if (argc > 3) settings.threads = static_cast<unsigned>(std::max(1L, std::strtol(argv[3], nullptr, 10)));
+
+    std::printf("requests=%zu query_latency=%lldms threads=%u pool_size=%zu\n",
+        settings.requests,
+        static_cast<long long>(settings.queryLatency.count()),
+        settings.threads,
+        settings.poolSize
+    );
+
+    const CacheAside::Options noEarly{.ttl = 30, .beta = 0.0, .staleWhileRevalidate = 0};
+    const CacheAside::Options swr{.ttl = 30, .beta = 0.0, .staleWhileRevalidate = 10};
+    const CacheAside::Options xfetch{.ttl = 30, .beta = 1.0, .staleWhileRevalidate = 0};
+    const auto expired = std::chrono::milliseconds(-1);
+    const auto arrivals = settings.queryLatency * 10;
+
+    const std::vector<Scenario> scenarios = {
+        {"naive", Mode::Naive, noEarly, expired, std::chrono::milliseconds(0), false},
+        {"single-flight", Mode::Coalesced, noEarly, expired},
+        {"swr", Mode::Coalesced, swr, expired},
+        // Arrivals around expiry: without XFetch the requests after expiry wait for the reload
+        {"sf-spread", Mode::Coalesced, noEarly, arrivals / 2, arrivals},
+        {"xfetch-spread", Mode::Coalesced, xfetch, arrivals / 2, arrivals},
+    };
+
+    for (const auto& scenario : scenarios) runScenario(settings, scenario);
+    return 0;
+}
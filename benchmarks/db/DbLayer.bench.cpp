@@ -0,0 +1,320 @@
+/// Database layer against a real Postgres.
+///
+/// BENCH_PG_DSN must point at a throwaway database: the users table is created from migrations/ if missing,
+/// then TRUNCATEd and reseeded (1k / 100k / 1M rows) for the repository benchmarks.
+///  - ExecParams / ExecPrepared : the same statement through both PgConnection paths, 1..1000 rows
+///  - ResultFormat              : text vs binary result transfer (raw libpq + buildResult)
+///  - BuildResult               : PGresult -> PgResult copy only, no network
+///  - PoolAcquire               : N coroutines (1..256) competing for a 10 connection PgPool
+///  - Transaction               : BEGIN / statement / COMMIT round trips
+///  - UsersGetList              : UsersRepository::getList end to end on seeded data
+///
+/// Usage: BENCH_PG_DSN=postgresql://... db_bench --benchmark_out=db.json --benchmark_out_format=json
+#include <benchmark/benchmark.h>
+
+#include <boost/asio.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/configs/EnvConfig.h"
+#include "core/db/postgres/interfaces/PgConnection.h"
+#include "core/db/postgres/interfaces/PgPool.h"
+#include "core/db/postgres/interfaces/Transaction.h"
+#include "core/loggers/LoggerFactory.h"
+#include "core/loggers/LoggerSingleton.h"
+#include "repositories/users/UsersRepository.h"
+
+namespace {
+    constexpr std::chrono::seconds kTimeout{30};
+    constexpr std::size_t kPoolSize = 10;
+
+    /// Same columns UsersRepository::getList selects, generated so the table size does not matter
+    const std::string kGeneratedUsers =
+        "SELECT g AS id, 'user_' || g AS username,"
+        " CASE WHEN g % 2 = 0 THEN 'media/users/' || g || '/avatar.png' END AS picture,"
+        " 'user_' || g || '@example.com' AS email, now() AS created_at, now() AS updated_at"
+        " FROM generate_series(1, $1::int) g";
+
+    /// Synchronous setup connection: schema, seeding, row counts. Never timed
+    class Setup {
+    public:
+        static Setup& get() {
+            static Setup setup;
+            return setup;
+        }
+
+        [[nodiscard]] bool ready() const noexcept { return conn_ != nullptr; }
+        [[nodiscard]] const std::string& dsn() const noexcept { return dsn_; }
+        [[nodiscard]] const std::string& error() const noexcept { return error_; }
+
+        void exec(const std::string& sql) const {
+            PGresult* result = PQexec(conn_, sql.c_str());
+            const ExecStatusType status = PQresultStatus(result);
+            const std::string message = PQresultErrorMessage(result);
+            PQclear(result);
+            if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK) {
+                throw std::runtime_error(sql.substr(0, 60) + ": " + message);
+            }
+        }
+
+        [[nodiscard]] std::int64_t scalar(const std::string& sql) const {
+            PGresult* result = PQexec(conn_, sql.c_str());
+            const std::int64_t value = PQresultStatus(result) == PGRES_TUPLES_OK && PQntuples(result) > 0
+                ? std::stoll(PQgetvalue(result, 0, 0))
+                : -1;
+            PQclear(result);
+            return value;
+        }
+
+        /// TRUNCATE + generate_series when the row count differs, reused between benchmarks of the same size
+        void seedUsers(const std::int64_t count) {
+            if (seeded_ == count) return;
+            if (scalar("SELECT count(*) FROM users") != count) {
+                exec("TRUNCATE users RESTART IDENTITY");
+                exec(
+                    "INSERT INTO users (username, picture, email, password)"
+                    " SELECT 'user_' || g,"
+                    " CASE WHEN g % 2 = 0 THEN 'media/users/' || g || '/avatar.png' END,"
+                    " 'user_' || g || '@example.com', 'bench'"
+                    " FROM generate_series(1, " + std::to_string(count) + ") g"
+                );
+                exec("ANALYZE users");
+            }
+            seeded_ = count;
+        }
+
+    private:
+        std::string dsn_;
+        std::string error_;
+        PGconn* conn_{nullptr};
+        std::int64_t seeded_{-1};
+
+        Setup() {
+            EnvConfig env;
+            env.log_level = "error";
+            LoggerSingleton::init(LoggerFactory::create("console", env));
+
+            const char* dsn = std::getenv("BENCH_PG_DSN");
+            if (!dsn || !*dsn) {
+                error_ = "BENCH_PG_DSN is not set";
+                return;
+            }
+            dsn_ = dsn;
+            conn_ = PQconnectdb(dsn);
+            if (PQstatus(conn_) != CONNECTION_OK) {
+                error_ = std::string("connection failed: ") + PQerrorMessage(conn_);
+                PQfinish(conn_);
+                conn_ = nullptr;
+                return;
+            }
+            try {
+                exec("SET client_min_messages = warning");
+                if (scalar("SELECT count(*) FROM pg_tables WHERE schemaname = 'public' AND tablename = 'users'") == 0) {
+                    std::ifstream migration(std::string(PROJECT_ROOT) + "/migrations/0001_users.up.sql");
+                    std::stringstream sql;
+                    sql << migration.rdbuf();
+                    exec(sql.str());
+                }
+            } catch (const std::exception& e) {
+                error_ = e.what();
+                PQfinish(conn_);
+                conn_ = nullptr;
+            }
+        }
+
+        ~Setup() {
+            if (conn_) PQfinish(conn_);
+        }
+    };
+
+    bool requireDatabase(benchmark::State& state) {
+        if (Setup::get().ready()) return true;
+        state.SkipWithError(Setup::get().error().c_str());
+        return false;
+    }
+
+    /// Body holds the `for (auto _ : state)` loop, every co_await inside is measured
+    template <class Body>
+    void runOnLoop(net::io_context& ioc, Body body) {
+        net::co_spawn(ioc, std::move(body), [](const std::exception_ptr& e) {
+            if (e) std::rethrow_exception(e);
+        });
+        ioc.run();
+        ioc.restart();
+    }
+
+    void BM_ExecParams(benchmark::State& state) {
+        if (!requireDatabase(state)) return;
+        net::io_context ioc{1};
+        PgConnection conn(ioc.get_executor(), Setup::get().dsn());
+        const std::vector<std::optional<std::string>> params{std::to_string(state.range(0))};
+        runOnLoop(ioc, [&]() -> net::awaitable<void> {
+            co_await conn.connect();
+            for (auto _ : state) {
+                PgResult result = co_await conn.execParams(kGeneratedUsers, params, kTimeout);
+                benchmark::DoNotOptimize(result);
+            }
+        });
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_ExecPrepared(benchmark::State& state) {
+        if (!requireDatabase(state)) return;
+        net::io_context ioc{1};
+        PgConnection conn(ioc.get_executor(), Setup::get().dsn());
+        const std::vector<std::optional<std::string>> params{std::to_string(state.range(0))};
+        runOnLoop(ioc, [&]() -> net::awaitable<void> {
+            co_await conn.connect();
+            for (auto _ : state) {
+                PgResult result = co_await conn.execPrepared("bench_generated_users", kGeneratedUsers, params, kTimeout);
+                benchmark::DoNotOptimize(result);
+            }
+        });
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /// PgConnection always asks for text; this is what binary would save on the wire and in buildResult
+    void BM_ResultFormat(benchmark::State& state) {
+        if (!requireDatabase(state)) return;
+        const int format = static_cast<int>(state.range(1));
+        PGconn* conn = PQconnectdb(Setup::get().dsn().c_str());
+        const std::string rows = std::to_string(state.range(0));
+        const char* values[] = {rows.c_str()};
+        std::int64_t bytes = 0;
+        for (auto _ : state) {
+            PGresult* raw = PQexecParams(conn, kGeneratedUsers.c_str(), 1, nullptr, values, nullptr, nullptr, format);
+            PgResult result = PgConnection::buildResult(raw);
+            benchmark::DoNotOptimize(result);
+            for (const auto& row : result.rows) {
+                for (const auto& column : row.columns) bytes += static_cast<std::int64_t>(column.data.size());
+            }
+            PQclear(raw);
+        }
+        PQfinish(conn);
+        state.SetLabel(format ? "binary" : "text");
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(bytes);
+    }
+
+    void BM_BuildResult(benchmark::State& state) {
+        if (!requireDatabase(state)) return;
+        PGconn* conn = PQconnectdb(Setup::get().dsn().c_str());
+        const std::string rows = std::to_string(state.range(0));
+        const char* values[] = {rows.c_str()};
+        PGresult* raw = PQexecParams(conn, kGeneratedUsers.c_str(), 1, nullptr, values, nullptr, nullptr, 0);
+        for (auto _ : state) {
+            PgResult result = PgConnection::buildResult(raw);
+            benchmark::DoNotOptimize(result);
+        }
+        PQclear(raw);
+        PQfinish(conn);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    net::awaitable<void> leaseOnce(PgPool& pool) {
+        PgPool::Lease lease = co_await pool.acquire();
+        // Hold the connection across a scheduling point, as a handler awaiting its query would
+        co_await net::post(co_await net::this_coro::executor, net::use_awaitable);
+        lease.release();
+    }
+
+    /// One iteration = N coroutines each acquiring and releasing once, all on one thread
+    void BM_PoolAcquire(benchmark::State& state) {
+        if (!requireDatabase(state)) return;
+        net::io_context ioc{1};
+        PgPool pool(ioc.get_executor(), Setup::get().dsn(), kPoolSize, 1024);
+        const auto concurrency = state.range(0);
+
+        // Open every connection before measuring
+        for (std::size_t i = 0; i < kPoolSize; ++i) net::co_spawn(ioc, leaseOnce(pool), net::detached);
+        ioc.run();
+        ioc.restart();
+
+        for (auto _ : state) {
+            for (std::int64_t i = 0; i < concurrency; ++i) net::co_spawn(ioc, leaseOnce(pool), net::detached);
+            ioc.run();
+            ioc.restart();
+        }
+        pool.shutdown();
+        ioc.run();
+        state.SetItemsProcessed(state.iterations() * concurrency);
+        state.counters["concurrency"] = static_cast<double>(concurrency);
+    }
+
+    /// range(0): statements inside the transaction, 0 -> BEGIN/COMMIT only
+    void BM_Transaction(benchmark::State& state) {
+        if (!requireDatabase(state)) return;
+        net::io_context ioc{1};
+        PgPool pool(ioc.get_executor(), Setup::get().dsn(), 1);
+        const std::int64_t statements = state.range(0);
+        runOnLoop(ioc, [&]() -> net::awaitable<void> {
+            for (auto _ : state) {
+                const Transaction tx = co_await Transaction::begin(pool, kTimeout);
+                for (std::int64_t i = 0; i < statements; ++i) {
+                    PgResult result = co_await tx.Lease.connection->execParams("SELECT 1", {}, kTimeout);
+                    benchmark::DoNotOptimize(result);
+                }
+                co_await tx.commit();
+            }
+        });
+        pool.shutdown();
+        ioc.run();
+    }
+
+    /// range(0): seeded users, range(1): 0 -> first page, 1 -> middle page (deep OFFSET), 2 -> id__in of 100
+    void BM_UsersGetList(benchmark::State& state) {
+        if (!requireDatabase(state)) return;
+        const std::int64_t seeded = state.range(0);
+        try {
+            Setup::get().seedUsers(seeded);
+        } catch (const std::exception& e) {
+            state.SkipWithError(e.what());
+            return;
+        }
+
+        net::io_context ioc{1};
+        const auto pool = std::make_shared<PgPool>(ioc.get_executor(), Setup::get().dsn(), 1);
+        const UsersRepository repository(pool);
+
+        UserListFilter filter;
+        filter.limit = 50;
+        switch (state.range(1)) {
+            case 1:
+                filter.offset = static_cast<std::size_t>(seeded / 2);
+                state.SetLabel("middle_page");
+                break;
+            case 2: {
+                std::vector<std::int64_t> ids;
+                for (std::int64_t i = 0; i < 100; ++i) ids.push_back(1 + i * (seeded / 100));
+                filter.id__in = std::move(ids);
+                filter.limit = 100;
+                state.SetLabel("id_in_100");
+                break;
+            }
+            default:
+                state.SetLabel("first_page");
+        }
+
+        runOnLoop(ioc, [&]() -> net::awaitable<void> {
+            for (auto _ : state) {
+                std::vector<UserEntity> users = co_await repository.getList(filter);
+                benchmark::DoNotOptimize(users);
+            }
+        });
+        pool->shutdown();
+        ioc.run();
+    }
+}
+
+BENCHMARK(BM_ExecParams)->Arg(1)->Arg(100)->Arg(1000)->UseRealTime();
+BENCHMARK(BM_ExecPrepared)->Arg(1)->Arg(100)->Arg(1000)->UseRealTime();
+BENCHMARK(BM_ResultFormat)->ArgsProduct({{1, 100, 10'000}, {0, 1}})->UseRealTime();
+BENCHMARK(BM_BuildResult)->RangeMultiplier(10)->Range(1, 100'000);
+BENCHMARK(BM_PoolAcquire)->RangeMultiplier(4)->Range(1, 256)->UseRealTime();
+BENCHMARK(BM_Transaction)->Arg(0)->Arg(1)->Arg(5)->UseRealTime();
+// Grouped by size so each table is seeded once
+BENCHMARK(BM_UsersGetList)->ArgsProduct({{1'000, 100'000, 1'000'000}, {0, 1, 2}})->UseRealTime();
@@ -0,0 +1,93 @@
+#include "LoadClient.h"
+
+namespace load {
+    ConnectionPool::ConnectionPool(
+        net::any_io_executor executor,
+        std::string host,
+        std::string port,
+        const std::size_t maxConnections
+    )
+        : executor_(std::move(executor))
+        , host_(std::move(host))
+        , port_(std::move(port))
+        , maxConnections_(maxConnections ? maxConnections : 1)
+        , released_(executor_) {
+        released_.expires_at(net::steady_timer::time_point::max());
+    }
+
+    net::awaitable<std::unique_ptr<ConnectionPool::Connection>> ConnectionPool::acquire() {
+        for (;;) {
+            if (!idle_.empty()) {
+                auto connection = std::move(idle_.back());
+                idle_.pop_back();
+                co_return connection;
+            }
+            if (open_ < maxConnections_) break;
+
+            boost::system::error_code ec;
+            // operation_aborted is the wake-up signal
+            co_await released_.async_wait(net::redirect_error(net::use_awaitable, ec));
+        }
+
+        ++open_;
+        try {
+            if (endpoints_.empty()) {
+                tcp::resolver resolver(executor_);
+                endpoints_ = co_await resolver.async_resolve(host_, port_, net::use_awaitable);
+            }
+            auto connection = std::make_unique<Connection>(executor_);
+            co_await connection->stream.async_connect(endpoints_, net::use_awaitable);
+            connection->stream.socket().set_option(tcp::no_delay(true));
+            ++opened_;
+            co_return connection;
+        } catch (...) {
+            --open_;
+            released_.cancel();
+            throw;
+        }
+    }
+
+    void ConnectionPool::release(std::unique_ptr<Connection> connection) {
+        if (connection) {
+            idle_.push_back(std::move(connection));
+        } else {
+            --open_;
+        }
+        released_.cancel();
+    }
+
+    net::awaitable<HttpResponse> ConnectionPool::send(HttpRequest request) {
+        auto connection = co_await acquire();
+        request.set(http::field::host, host_);
+        request.keep_alive(true);
+        request.prepare_payload();
+
+        HttpResponse response;
+        std::exception_ptr error;
+        try {
+            co_await http::async_write(connection->stream, request, net::use_awaitable);
+            co_await http::async_read(connection->stream, connection->buffer, response, net::use_awaitable);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        if (error || !response.keep_alive()) {
+            if (error) ++reconnects_;
+            beast::error_code ignored;
+            connection->stream.socket().shutdown(tcp::socket::shutdown_both, ignored);
+            connection.reset();
+        }
+        release(std::move(connection));
+        if (error) std::rethrow_exception(error);
+        co_return response;
+    }
+
+    void ConnectionPool::close() {
+        for (const auto& connection : idle_) {
+            beast::error_code ignored;
+            connection->stream.socket().shutdown(tcp::socket::shutdown_both, ignored);
+        }
+        open_ -= idle_.size();
+        idle_.clear();
+    }
+}
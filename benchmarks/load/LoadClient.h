@@ -0,0 +1,55 @@
+#pragma once
+#include <boost/asio.hpp>
+#include <boost/beast.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace load {
+    namespace net = boost::asio;
+    namespace beast = boost::beast;
+    namespace http = beast::http;
+    using tcp = net::ip::tcp;
+
+    using HttpRequest = http::request<http::string_body>;
+    using HttpResponse = http::response<http::string_body>;
+
+    /// Keep-alive connections to one app instance, bounded by maxConnections.
+    /// Single-threaded by design: every worker owns an io_context and its own pool, no locking.
+    class ConnectionPool {
+    public:
+        ConnectionPool(net::any_io_executor executor, std::string host, std::string port, std::size_t maxConnections);
+
+        /// Waits for a free connection when all of them are busy; that wait is part of the measured latency.
+        /// Transport errors drop the connection and rethrow, the next send reconnects
+        net::awaitable<HttpResponse> send(HttpRequest request);
+
+        [[nodiscard]] std::size_t opened() const noexcept { return opened_; }
+        [[nodiscard]] std::size_t reconnects() const noexcept { return reconnects_; }
+
+        void close();
+
+    private:
+        struct Connection {
+            explicit Connection(const net::any_io_executor& executor) : stream(executor) {}
+            beast::tcp_stream stream;
+            beast::flat_buffer buffer;
+        };
+
+        net::any_io_executor executor_;
+        std::string host_;
+        std::string port_;
+        std::size_t maxConnections_;
+        tcp::resolver::results_type endpoints_;
+
+        std::vector<std::unique_ptr<Connection>> idle_;
+        std::size_t open_ = 0;
+        std::size_t opened_ = 0;
+        std::size_t reconnects_ = 0;
+        /// Used as an event: cancel() wakes everybody waiting for a connection
+        net::steady_timer released_;
+
+        net::awaitable<std::unique_ptr<Connection>> acquire();
+        void release(std::unique_ptr<Connection> connection);
+    };
+}
@@ -0,0 +1,423 @@
+/// HTTP load generator for a locally running app.
+///
+/// Modes:
+///  - closed : --vus virtual users run the scenario back to back (optionally --think-ms between runs);
+///             throughput follows the server, latency is measured from the actual send.
+///  - open   : runs arrive at a fixed --rate regardless of how the server keeps up. Latency is measured from
+///             the scheduled arrival, so queueing behind a slow server is counted (no coordinated omission).
+///
+/// Every step has its own histogram (metrics::HdrHistogram, microseconds), "total" covers the whole run.
+/// Workers (--threads) own an io_context and a keep-alive ConnectionPool each, histograms are merged at the end.
+///
+/// Usage: load_gen --scenario crud --mode open --rate 200 --duration 30 --warmup 5 --json out.json --csv out.csv
+#include "LoadClient.h"
+#include "Scenarios.h"
+#include "core/metrics/HdrHistogram.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+    using namespace load;
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings {
+        std::string host = "127.0.0.1";
+        std::string port = "8080";
+        std::string scenario = "list";
+        std::string mode = "closed";
+        /// open: scenario runs per second across all workers
+        double rate = 100.0;
+        /// closed: concurrent virtual users across all workers
+        std::size_t vus = 16;
+        std::chrono::milliseconds think{0};
+        std::chrono::seconds duration{30};
+        /// Runs started before it are executed but not recorded
+        std::chrono::seconds warmup{0};
+        std::size_t connections = 64;
+        unsigned threads = 1;
+        /// open: runs in flight above it are dropped (and reported) instead of queued without bound
+        std::size_t maxInflight = 10'000;
+        std::string picture = std::string(PROJECT_ROOT) + "/tests/e2e/assets/test.png";
+        std::string jsonOut;
+        std::string csvOut;
+    };
+
+    struct StepStats {
+        metrics::HdrHistogram latency;
+        std::uint64_t errors = 0;
+        /// 0 -> transport error
+        std::map<unsigned, std::uint64_t> statuses;
+
+        void merge(const StepStats& other) {
+            latency.merge(other.latency);
+            errors += other.errors;
+            for (const auto& [status, count] : other.statuses) statuses[status] += count;
+        }
+    };
+
+    struct Results {
+        std::vector<StepStats> steps;
+        StepStats total;
+        std::uint64_t dropped = 0;
+        std::size_t connectionsOpened = 0;
+        std::size_t reconnects = 0;
+    };
+
+    /// Setup failures must stop the run, not silently shrink the load
+    void rethrow(const std::exception_ptr& e) {
+        if (e) std::rethrow_exception(e);
+    }
+
+    class Worker {
+    public:
+        Worker(const Settings& settings, const Scenario& scenario, const unsigned index)
+            : settings_(settings)
+            , scenario_(scenario)
+            , index_(index)
+            , pool_(ioc_.get_executor(), settings.host, settings.port, share(settings.connections))
+            , timer_(ioc_) {
+            results_.steps.resize(scenario.steps.size());
+        }
+
+        void run(const Clock::time_point startAt) {
+            warmupEnd_ = startAt + settings_.warmup;
+            deadline_ = startAt + settings_.duration;
+            if (settings_.mode == "open") {
+                prepareSessions();
+                net::co_spawn(ioc_, arrivals(startAt), rethrow);
+            } else {
+                for (std::size_t i = 0; i < share(settings_.vus); ++i) {
+                    net::co_spawn(ioc_, virtualUser(), rethrow);
+                }
+            }
+            ioc_.run();
+            pool_.close();
+            results_.connectionsOpened = pool_.opened();
+            results_.reconnects = pool_.reconnects();
+        }
+
+        [[nodiscard]] const Results& results() const noexcept { return results_; }
+
+    private:
+        const Settings& settings_;
+        const Scenario& scenario_;
+        const unsigned index_;
+        net::io_context ioc_{1};
+        ConnectionPool pool_;
+        net::steady_timer timer_;
+        Results results_;
+        std::vector<Session> sessions_;
+        std::size_t nextSession_ = 0;
+        std::size_t sessionSeq_ = 0;
+        std::size_t inflight_ = 0;
+        Clock::time_point warmupEnd_;
+        Clock::time_point deadline_;
+
+        /// This worker's part of a global amount, remainder goes to the first workers
+        [[nodiscard]] std::size_t share(const std::size_t amount) const {
+            const std::size_t base = amount / settings_.threads;
+            return std::max<std::size_t>(1, base + (index_ < amount % settings_.threads ? 1 : 0));
+        }
+
+        Session newSession() {
+            return Session{.id = std::to_string(::getpid()) + "_" + std::to_string(index_) + "_" + std::to_string(sessionSeq_++)};
+        }
+
+        /// Unmeasured: failures here abort the whole run, the scenario cannot proceed without them
+        net::awaitable<void> setup(Session& session) {
+            for (const auto& step : scenario_.setup) {
+                HttpRequest request = step.build(session);
+                HttpResponse response = co_await pool_.send(std::move(request));
+                if (!step.accept(response, session)) {
+                    throw std::runtime_error(
+                        "setup step " + step.name + " failed: " + std::to_string(response.result_int()) + " " + response.body()
+                    );
+                }
+            }
+        }
+
+        void prepareSessions() {
+            if (scenario_.freshSession || scenario_.setup.empty()) return;
+            sessions_.resize(share(settings_.connections));
+            for (auto& session : sessions_) {
+                session = newSession();
+                net::co_spawn(ioc_, setup(session), rethrow);
+            }
+            ioc_.run();
+            ioc_.restart();
+        }
+
+        /// intended: when the run should have started, open loop measures every first step and the total from it
+        net::awaitable<void> execute(Session session, const Clock::time_point intended) {
+            const bool recording = intended >= warmupEnd_;
+            bool ok = true;
+            for (std::size_t i = 0; i < scenario_.steps.size() && ok; ++i) {
+                const Step& step = scenario_.steps[i];
+                const auto startedAt = i == 0 ? intended : Clock::now();
+                unsigned status = 0;
+                HttpRequest request = step.build(session);
+                try {
+                    HttpResponse response = co_await pool_.send(std::move(request));
+                    status = response.result_int();
+                    ok = step.accept(response, session);
+                } catch (const std::exception&) {
+                    ok = false;
+                }
+                if (!recording) continue;
+
+                StepStats& stats = results_.steps[i];
+                stats.latency.record(static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startedAt).count()
+                ));
+                ++stats.statuses[status];
+                if (!ok) ++stats.errors;
+            }
+            if (!recording) co_return;
+
+            results_.total.latency.record(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - intended).count()
+            ));
+            if (!ok) ++results_.total.errors;
+        }
+
+        net::awaitable<void> virtualUser() {
+            Session session = newSession();
+            if (!scenario_.freshSession) co_await setup(session);
+            net::steady_timer think(ioc_);
+            while (Clock::now() < deadline_) {
+                if (scenario_.freshSession) session = newSession();
+                co_await execute(session, Clock::now());
+                if (settings_.think.count() > 0) {
+                    think.expires_after(settings_.think);
+                    co_await think.async_wait(net::use_awaitable);
+                }
+            }
+        }
+
+        net::awaitable<void> tracked(Session session, const Clock::time_point intended) {
+            ++inflight_;
+            co_await execute(std::move(session), intended);
+            --inflight_;
+        }
+
+        net::awaitable<void> arrivals(const Clock::time_point startAt) {
+            const double workerRate = settings_.rate / settings_.threads;
+            const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / workerRate));
+            // Workers are phase-shifted so the merged arrival stream stays evenly spaced
+            auto intended = startAt + interval * index_ / settings_.threads;
+            while (intended < deadline_) {
+                timer_.expires_at(intended);
+                co_await timer_.async_wait(net::use_awaitable);
+
+                if (inflight_ >= share(settings_.maxInflight)) {
+                    if (intended >= warmupEnd_) ++results_.dropped;
+                } else {
+                    Session session = scenario_.freshSession || sessions_.empty()
+                        ? newSession()
+                        : sessions_[nextSession_++ % sessions_.size()];
+                    net::co_spawn(ioc_, tracked(std::move(session), intended), net::detached);
+                }
+                intended += interval;
+            }
+        }
+    };
+
+    double ms(const std::uint64_t us) { return static_cast<double>(us) / 1000.0; }
+
+    nlohmann::json statsJson(const std::string& name, const StepStats& stats, const double seconds) {
+        nlohmann::json statuses = nlohmann::json::object();
+        for (const auto& [status, count] : stats.statuses) statuses[std::to_string(status)] = count;
+        const auto& h = stats.latency;
+        return {
+            {"name", name},
+            {"count", h.count()},
+            {"errors", stats.errors},
+            {"rps", seconds > 0 ? static_cast<double>(h.count()) / seconds : 0.0},
+            {"statuses", statuses},
+            {"latency_ms", {
+                {"mean", h.mean() / 1000.0},
+                {"p50", ms(h.percentile(50))},
+                {"p90", ms(h.percentile(90))},
+                {"p99", ms(h.percentile(99))},
+                {"p999", ms(h.percentile(99.9))},
+                {"max", ms(h.max())}
+            }}
+        };
+    }
+
+    void printUsage() {
+        std::printf(
+            "load_gen [--host 127.0.0.1] [--port 8080] [--scenario health|list|crud] [--mode closed|open]\n"
+            "         [--rate 100] [--vus 16] [--think-ms 0] [--duration 30] [--warmup 0] [--connections 64]\n"
+            "         [--threads 1] [--max-inflight 10000] [--picture png] [--json file] [--csv file]\n"
+        );
+    }
+
+    Settings parse(const int argc, char** argv) {
+        Settings s;
+        for (int i = 1; i < argc; ++i) {
+            const std::string key = argv[i];
+            if (key == "--help" || key == "-h") {
+                printUsage();
+                std::exit(0);
+            }
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + key);
+            const std::string value = argv[++i];
+            if (key == "--host") s.host = value;
+            else if (key == "--port") s.port = value;
+            else if (key == "--scenario") s.scenario = value;
+            else if (key == "--mode") s.mode = value;
+            else if (key == "--rate") s.rate = std::stod(value);
+            else if (key == "--vus") s.vus = std::stoul(value);
+            else if (key == "--think-ms") s.think = std::chrono::milliseconds(std::stol(value));
+            else if (key == "--duration") s.duration = std::chrono::seconds(std::stol(value));
+            else if (key == "--warmup") s.warmup = std::chrono::seconds(std::stol(value));
+            else if (key == "--connections") s.connections = std::stoul(value);
+            else if (key == "--threads") s.threads = static_cast<unsigned>(std::max(1ul, std::stoul(value)));
+            else if (key == "--max-inflight") s.maxInflight = std::stoul(value);
+            else if (key == "--picture") s.picture = value;
+            else if (key == "--json") s.jsonOut = value;
+            else if (key == "--csv") s.csvOut = value;
+            else throw std::invalid_argument("unknown option " + key);
+        }
+        if (s.mode != "open" && s.mode != "closed") throw std::invalid_argument("--mode must be open or closed");
+        if (s.mode == "open" && s.rate <= 0) throw std::invalid_argument("--rate must be positive");
+        if (s.warmup >= s.duration) throw std::invalid_argument("--warmup must be shorter than --duration");
+        return s;
+    }
+} // namespace
+
+int main(const int argc, char** argv) {
+    Settings settings;
+    Scenario scenario;
+    try {
+        settings = parse(argc, argv);
+        ScenarioOptions options;
+        if (settings.scenario == "crud") {
+            std::ifstream file(settings.picture, std::ios::binary);
+            options.picture.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        scenario = makeScenario(settings.scenario, options);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "load_gen: %s\n", e.what());
+        printUsage();
+        return 2;
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (unsigned i = 0; i < settings.threads; ++i) workers.push_back(std::make_unique<Worker>(settings, scenario, i));
+
+    std::printf("scenario=%s mode=%s %s duration=%llds warmup=%llds threads=%u connections=%zu target=%s:%s\n",
+        scenario.name.c_str(),
+        settings.mode.c_str(),
+        (settings.mode == "open" ? (std::ostringstream{} << "rate=" << settings.rate << "/s").str()
+                                 : "vus=" + std::to_string(settings.vus)).c_str(),
+        static_cast<long long>(settings.duration.count()),
+        static_cast<long long>(settings.warmup.count()),
+        settings.threads,
+        settings.connections,
+        settings.host.c_str(),
+        settings.port.c_str()
+    );
+
+    // Session setup (register/login) happens inside run(), before the first arrival
+    const auto startAt = Clock::now() + std::chrono::milliseconds(200);
+    std::vector<std::thread> threads;
+    std::vector<std::string> failures(workers.size());
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        threads.emplace_back([&, i] {
+            try {
+                workers[i]->run(startAt);
+            } catch (const std::exception& e) {
+                failures[i] = e.what();
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    for (const auto& failure : failures) {
+        if (!failure.empty()) {
+            std::fprintf(stderr, "load_gen: %s\n", failure.c_str());
+            return 1;
+        }
+    }
+
+    Results merged;
+    merged.steps.resize(scenario.steps.size());
+    for (const auto& worker : workers) {
+        const Results& r = worker->results();
+        for (std::size_t i = 0; i < r.steps.size(); ++i) merged.steps[i].merge(r.steps[i]);
+        merged.total.merge(r.total);
+        merged.dropped += r.dropped;
+        merged.connectionsOpened += r.connectionsOpened;
+        merged.reconnects += r.reconnects;
+    }
+
+    const double seconds = static_cast<double>((settings.duration - settings.warmup).count());
+    std::vector<std::pair<std::string, const StepStats*>> rows;
+    for (std::size_t i = 0; i < scenario.steps.size(); ++i) rows.emplace_back(scenario.steps[i].name, &merged.steps[i]);
+    rows.emplace_back("total", &merged.total);
+
+    std::printf("%-10s %9s %7s %9s %9s %9s %9s %9s %9s %9s\n",
+        "step", "count", "errors", "rps", "mean_ms", "p50_ms", "p90_ms", "p99_ms", "p999_ms", "max_ms");
+    for (const auto& [name, stats] : rows) {
+        const auto& h = stats->latency;
+        std::printf("%-10s %9llu %7llu %9.1f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n",
+            name.c_str(),
+            static_cast<unsigned long long>(h.count()),
+            static_cast<unsigned long long>(stats->errors),
+            seconds > 0 ? static_cast<double>(h.count()) / seconds : 0.0,
+            h.mean() / 1000.0,
+            ms(h.percentile(50)),
+            ms(h.percentile(90)),
+            ms(h.percentile(99)),
+            ms(h.percentile(99.9)),
+            ms(h.max())
+        );
+    }
+    std::printf("dropped=%llu connections_opened=%zu reconnects=%zu\n",
+        static_cast<unsigned long long>(merged.dropped), merged.connectionsOpened, merged.reconnects);
+
+    if (!settings.jsonOut.empty()) {
+        nlohmann::json steps = nlohmann::json::array();
+        for (std::size_t i = 0; i < scenario.steps.size(); ++i) steps.push_back(statsJson(scenario.steps[i].name, merged.steps[i], seconds));
+        const nlohmann::json report{
+            {"scenario", scenario.name},
+            {"mode", settings.mode},
+            {"rate", settings.mode == "open" ? nlohmann::json(settings.rate) : nlohmann::json()},
+            {"vus", settings.mode == "closed" ? nlohmann::json(settings.vus) : nlohmann::json()},
+            {"duration_s", settings.duration.count()},
+            {"warmup_s", settings.warmup.count()},
+            {"threads", settings.threads},
+            {"connections", settings.connections},
+            {"dropped", merged.dropped},
+            {"connections_opened", merged.connectionsOpened},
+            {"reconnects", merged.reconnects},
+            {"steps", steps},
+            {"total", statsJson("total", merged.total, seconds)}
+        };
+        std::ofstream(settings.jsonOut) << report.dump(2) << '\n';
+    }
+
+    if (!settings.csvOut.empty()) {
+        std::ofstream csv(settings.csvOut);
+        csv << "step,count,errors,rps,mean_ms,p50_ms,p90_ms,p99_ms,p999_ms,max_ms\n";
+        for (const auto& [name, stats] : rows) {
+            const auto& h = stats->latency;
+            csv << name << ',' << h.count() << ',' << stats->errors << ','
+                << (seconds > 0 ? static_cast<double>(h.count()) / seconds : 0.0) << ','
+                << h.mean() / 1000.0 << ',' << ms(h.percentile(50)) << ',' << ms(h.percentile(90)) << ','
+                << ms(h.percentile(99)) << ',' << ms(h.percentile(99.9)) << ',' << ms(h.max()) << '\n';
+        }
+    }
+
+    return merged.total.errors == 0 && merged.dropped == 0 ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+#include "Scenarios.h"
+
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+namespace load {
+    namespace {
+        const std::string kPassword = "Passw0rd!";
+
+        HttpRequest makeRequest(const http::verb method, const std::string& target, const Session& session) {
+            HttpRequest request{method, target, 11};
+            request.set(http::field::user_agent, "load-gen");
+            request.set(http::field::accept, "application/json");
+            if (!session.bearer.empty()) request.set(http::field::authorization, session.bearer);
+            return request;
+        }
+
+        HttpRequest jsonRequest(const http::verb method, const std::string& target, const nlohmann::json& body, const Session& session) {
+            HttpRequest request = makeRequest(method, target, session);
+            request.set(http::field::content_type, "application/json");
+            request.body() = body.dump();
+            return request;
+        }
+
+        std::string email(const Session& session) { return "load_" + session.id + "@example.com"; }
+
+        bool statusIs(const HttpResponse& response, const http::status status) { return response.result() == status; }
+
+        Step health() {
+            return {
+                "health",
+                [](const Session& s) { return makeRequest(http::verb::get, "/health", s); },
+                [](const HttpResponse& r, Session&) { return statusIs(r, http::status::ok); }
+            };
+        }
+
+        Step registerUser() {
+            return {
+                "register",
+                [](const Session& s) {
+                    return jsonRequest(http::verb::post, "/register", {
+                        {"email", email(s)},
+                        {"username", "load_" + s.id},
+                        {"password", kPassword}
+                    }, s);
+                },
+                [](const HttpResponse& r, Session&) { return statusIs(r, http::status::created); }
+            };
+        }
+
+        Step login() {
+            return {
+                "login",
+                [](const Session& s) {
+                    return jsonRequest(http::verb::post, "/login", {{"email", email(s)}, {"password", kPassword}}, s);
+                },
+                [](const HttpResponse& r, Session& s) {
+                    if (!statusIs(r, http::status::created)) return false;
+                    const auto body = nlohmann::json::parse(r.body(), nullptr, false);
+                    if (!body.is_object() || !body.contains("accessToken")) return false;
+                    s.bearer = "Bearer " + body["accessToken"].get<std::string>();
+                    return true;
+                }
+            };
+        }
+
+        Step list(const std::size_t limit) {
+            return {
+                "list",
+                [limit](const Session& s) {
+                    return makeRequest(http::verb::get, "/users?limit=" + std::to_string(limit), s);
+                },
+                [](const HttpResponse& r, Session&) { return statusIs(r, http::status::ok); }
+            };
+        }
+
+        /// Register returns no body: the list endpoint filtered by email is how a client finds its id
+        Step findSelf() {
+            return {
+                "find",
+                [](const Session& s) { return makeRequest(http::verb::get, "/users?email=" + email(s), s); },
+                [](const HttpResponse& r, Session& s) {
+                    if (!statusIs(r, http::status::ok)) return false;
+                    const auto body = nlohmann::json::parse(r.body(), nullptr, false);
+                    if (!body.is_array() || body.empty() || !body[0].contains("id")) return false;
+                    s.userId = body[0]["id"].get<std::int64_t>();
+                    return true;
+                }
+            };
+        }
+
+        Step patchPicture(const std::string& picture) {
+            return {
+                "patch",
+                [picture](const Session& s) {
+                    const std::string boundary = "----load-gen-" + s.id;
+                    HttpRequest request = makeRequest(http::verb::patch, "/users/" + std::to_string(s.userId), s);
+                    request.set(http::field::content_type, "multipart/form-data; boundary=" + boundary);
+                    std::string& body = request.body();
+                    body.reserve(picture.size() + 256);
+                    body += "--" + boundary + "\r\n";
+                    body += "Content-Disposition: form-data; name=\"picture\"; filename=\"load.png\"\r\n";
+                    body += "Content-Type: image/png\r\n\r\n";
+                    body += picture;
+                    body += "\r\n--" + boundary + "--\r\n";
+                    return request;
+                },
+                [](const HttpResponse& r, Session&) { return statusIs(r, http::status::no_content) || statusIs(r, http::status::ok); }
+            };
+        }
+
+        Step removeSelf() {
+            return {
+                "delete",
+                [](const Session& s) { return makeRequest(http::verb::delete_, "/users/" + std::to_string(s.userId), s); },
+                [](const HttpResponse& r, Session&) { return statusIs(r, http::status::no_content) || statusIs(r, http::status::ok); }
+            };
+        }
+    }
+
+    std::vector<std::string> scenarioNames() { return {"health", "list", "crud"}; }
+
+    Scenario makeScenario(const std::string& name, const ScenarioOptions& options) {
+        if (name == "health") {
+            return {.name = name, .steps = {health()}};
+        }
+        if (name == "list") {
+            return {.name = name, .setup = {registerUser(), login()}, .steps = {list(options.listLimit)}};
+        }
+        if (name == "crud") {
+            if (options.picture.empty()) throw std::invalid_argument("crud scenario needs a picture (--picture)");
+            return {
+                .name = name,
+                .steps = {registerUser(), login(), findSelf(), patchPicture(options.picture), removeSelf()},
+                .freshSession = true
+            };
+        }
+        throw std::invalid_argument("unknown scenario: " + name);
+    }
+}
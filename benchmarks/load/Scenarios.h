@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "LoadClient.h"
+
+namespace load {
+    /// Per virtual user state carried between the steps of one scenario run
+    struct Session {
+        /// Unique per run: emails/usernames derived from it never collide across workers
+        std::string id;
+        std::string bearer;
+        std::int64_t userId = 0;
+    };
+
+    struct Step {
+        std::string name;
+        std::function<HttpRequest(const Session&)> build;
+        /// Validates the response and extracts what later steps need, false -> counted as an error
+        std::function<bool(const HttpResponse&, Session&)> accept;
+    };
+
+    struct Scenario {
+        std::string name;
+        /// Once per session before measuring (closed loop: per virtual user, open loop: per pooled session)
+        std::vector<Step> setup;
+        /// Timed, one histogram per step
+        std::vector<Step> steps;
+        /// Every run starts a fresh session (steps register their own user)
+        bool freshSession = false;
+    };
+
+    struct ScenarioOptions {
+        /// PNG sent by the patch step, must pass the app's content sniffing
+        std::string picture;
+        std::size_t listLimit = 50;
+    };
+
+    /// health | list | crud
+    Scenario makeScenario(const std::string& name, const ScenarioOptions& options);
+    std::vector<std::string> scenarioNames();
+}
@@ -0,0 +1,406 @@
+/// Memory density of a running app: bytes per idle keep-alive connection and per in-flight request.
+///
+/// Every phase is sampled from the app's own GET /metrics (process_resident_memory_bytes, malloc_bytes{state},
+/// heap_live_bytes when built with APP_ALLOC_TRACKING), over one connection kept open for the whole run:
+///  - baseline : after --warmup connections served a request and closed, so lazy statics are in place
+///  - idle     : --idle connections served one GET /health each and stay open, parked in async_read_header
+///  - inflight : --inflight more connections, one --target request each, parked in the backend. Run the app with
+///               DATABASE_DRIVER=fake FAKE_DB_LATENCY_US=5000000 so they are still there when sampled
+///  - released : everything closed, what the allocator keeps
+/// Per-connection and per-request bytes are deltas divided by the count: heap (malloc in use) is the stable
+/// number, RSS follows it in page steps. --max-idle-bytes / --max-request-bytes fail the run (exit 1) when
+/// the heap share is above them, a memory density regression gate.
+///
+/// Thousands of sockets on both sides: raise `ulimit -n` for the app, this tool raises its own soft limit.
+///
+/// Usage: memory_bench --port 8080 --idle 10000 --inflight 500 --json memory.json
+#include <boost/asio.hpp>
+#include <boost/beast.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <thread>
+#include <sys/resource.h>
+
+namespace {
+    namespace net = boost::asio;
+    namespace beast = boost::beast;
+    namespace http = beast::http;
+    using tcp = net::ip::tcp;
+    using HttpRequest = http::request<http::string_body>;
+    using HttpResponse = http::response<http::string_body>;
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings {
+        std::string host = "127.0.0.1";
+        std::string port = "8080";
+        std::size_t idle = 1000;
+        std::size_t inflight = 100;
+        std::size_t warmup = 64;
+        std::string target = "/users?limit=20";
+        /// Empty: POST /login with email/password first (any email logs in on the fake backend)
+        std::string bearer;
+        std::string email = "memory@example.com";
+        std::string password = "Passw0rd!";
+        std::chrono::milliseconds settle{10'000};
+        /// 0 -> no gate
+        double maxIdleBytes = 0;
+        double maxRequestBytes = 0;
+        std::string jsonOut;
+    };
+
+    struct Sample {
+        double rss = 0;
+        double heapInUse = 0;
+        double heapFree = 0;
+        /// Only with APP_ALLOC_TRACKING
+        std::optional<double> liveBytes;
+        double sessions = 0;
+        double requests = 0;
+    };
+
+    struct Phase {
+        std::string name;
+        Sample sample;
+    };
+
+    class Client {
+    public:
+        explicit Client(const Settings& settings)
+            : settings_(settings)
+            , endpoints_(tcp::resolver(ioc_).resolve(settings.host, settings.port)) {}
+
+        [[nodiscard]] tcp::socket connect() {
+            tcp::socket socket(ioc_);
+            net::connect(socket, endpoints_);
+            return socket;
+        }
+
+        [[nodiscard]] HttpRequest request(const http::verb method, const std::string& target) const {
+            HttpRequest request{method, target, 11};
+            request.set(http::field::host, settings_.host);
+            request.set(http::field::user_agent, "memory-bench");
+            request.set(http::field::accept, "application/json");
+            request.keep_alive(true);
+            return request;
+        }
+
+        static HttpResponse read(tcp::socket& socket) {
+            beast::flat_buffer buffer;
+            HttpResponse response;
+            http::read(socket, buffer, response);
+            return response;
+        }
+
+        static HttpResponse roundTrip(tcp::socket& socket, HttpRequest request) {
+            request.prepare_payload();
+            http::write(socket, request);
+            return read(socket);
+        }
+
+    private:
+        const Settings& settings_;
+        net::io_context ioc_;
+        tcp::resolver::results_type endpoints_;
+    };
+
+    /// Unlabelled or fully labelled series name -> value, comments skipped
+    std::map<std::string, double> parseMetrics(const std::string& text) {
+        std::map<std::string, double> values;
+        std::istringstream in(text);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line.front() == '#') continue;
+            const auto space = line.rfind(' ');
+            if (space == std::string::npos) continue;
+            try {
+                values[line.substr(0, space)] = std::stod(line.substr(space + 1));
+            } catch (const std::exception&) {}
+        }
+        return values;
+    }
+
+    Sample scrape(Client& client, tcp::socket& socket) {
+        const HttpResponse response = Client::roundTrip(socket, client.request(http::verb::get, "/metrics"));
+        if (response.result() != http::status::ok) {
+            throw std::runtime_error("GET /metrics answered " + std::to_string(response.result_int()));
+        }
+        const auto values = parseMetrics(response.body());
+        const auto value = [&values](const std::string& series) {
+            const auto it = values.find(series);
+            return it == values.end() ? 0.0 : it->second;
+        };
+        if (!values.contains("process_resident_memory_bytes")) {
+            throw std::runtime_error("/metrics has no process_resident_memory_bytes, is this the app?");
+        }
+
+        Sample sample;
+        sample.rss = value("process_resident_memory_bytes");
+        sample.heapInUse = value("malloc_bytes{state=\"in_use\"}");
+        sample.heapFree = value("malloc_bytes{state=\"free\"}");
+        if (values.contains("heap_live_bytes")) sample.liveBytes = value("heap_live_bytes");
+        sample.sessions = value("http_sessions_in_flight");
+        // The scrape itself is being dispatched while the gauge is rendered
+        sample.requests = value("http_requests_in_flight") - 1;
+        return sample;
+    }
+
+    /// Polls until the app sees what the client did, the server side lags behind connect/write/close
+    template <class Reached>
+    Sample settle(Client& client, tcp::socket& metrics, const Settings& settings, Reached reached, const std::string& expected) {
+        const auto deadline = Clock::now() + settings.settle;
+        Sample sample = scrape(client, metrics);
+        while (!reached(sample) && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            sample = scrape(client, metrics);
+        }
+        if (!reached(sample)) {
+            throw std::runtime_error(
+                "app reports " + std::to_string(static_cast<long long>(sample.sessions)) + " sessions and "
+                + std::to_string(static_cast<long long>(sample.requests)) + " requests in flight, expected " + expected
+            );
+        }
+        // Gauges move before the memory behind them is released: a moment for the stragglers
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        return scrape(client, metrics);
+    }
+
+    std::string login(Client& client, const Settings& settings) {
+        tcp::socket socket = client.connect();
+        HttpRequest request = client.request(http::verb::post, "/login");
+        request.set(http::field::content_type, "application/json");
+        request.body() = nlohmann::json{{"email", settings.email}, {"password", settings.password}}.dump();
+        const HttpResponse response = Client::roundTrip(socket, std::move(request));
+        const auto body = nlohmann::json::parse(response.body(), nullptr, false);
+        if (response.result() != http::status::created || !body.is_object() || !body.contains("accessToken")) {
+            throw std::runtime_error("login failed: " + std::to_string(response.result_int()) + " " + response.body());
+        }
+        return "Bearer " + body["accessToken"].get<std::string>();
+    }
+
+    void raiseFileLimit(const std::size_t needed) {
+        rlimit limit{};
+        if (::getrlimit(RLIMIT_NOFILE, &limit) != 0) return;
+        if (limit.rlim_cur < limit.rlim_max) {
+            limit.rlim_cur = limit.rlim_max;
+            ::setrlimit(RLIMIT_NOFILE, &limit);
+        }
+        if (limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur < needed) {
+            std::fprintf(stderr, "memory_bench: open file limit %llu is below the %zu sockets needed\n",
+                static_cast<unsigned long long>(limit.rlim_cur), needed);
+        }
+    }
+
+    double kib(const double bytes) { return bytes / 1024.0; }
+    double mib(const double bytes) { return bytes / (1024.0 * 1024.0); }
+
+    /// Share of one unit between two samples
+    struct PerUnit {
+        double rss = 0;
+        double heap = 0;
+        std::optional<double> live;
+    };
+
+    PerUnit perUnit(const Sample& before, const Sample& after, const std::size_t count) {
+        const double n = static_cast<double>(std::max<std::size_t>(1, count));
+        PerUnit unit{(after.rss - before.rss) / n, (after.heapInUse - before.heapInUse) / n, std::nullopt};
+        if (before.liveBytes && after.liveBytes) unit.live = (*after.liveBytes - *before.liveBytes) / n;
+        return unit;
+    }
+
+    nlohmann::json sampleJson(const Sample& s) {
+        return {
+            {"rss_bytes", s.rss},
+            {"heap_in_use_bytes", s.heapInUse},
+            {"heap_free_bytes", s.heapFree},
+            {"heap_live_bytes", s.liveBytes ? nlohmann::json(*s.liveBytes) : nlohmann::json()},
+            {"sessions", s.sessions},
+            {"requests", s.requests}
+        };
+    }
+
+    nlohmann::json unitJson(const PerUnit& u) {
+        return {
+            {"rss_bytes", u.rss},
+            {"heap_bytes", u.heap},
+            {"live_bytes", u.live ? nlohmann::json(*u.live) : nlohmann::json()}
+        };
+    }
+
+    void printUsage() {
+        std::printf(
+            "memory_bench [--host 127.0.0.1] [--port 8080] [--idle 1000] [--inflight 100] [--warmup 64]\n"
+            "             [--target /users?limit=20] [--bearer \"Bearer ...\"] [--email e] [--password p]\n"
+            "             [--settle-ms 10000] [--max-idle-bytes 0] [--max-request-bytes 0] [--json file]\n"
+        );
+    }
+
+    Settings parse(const int argc, char** argv) {
+        Settings s;
+        for (int i = 1; i < argc; ++i) {
+            const std::string key = argv[i];
+            if (key == "--help" || key == "-h") {
+                printUsage();
+                std::exit(0);
+            }
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + key);
+            const std::string value = argv[++i];
+            if (key == "--host") s.host = value;
+            else if (key == "--port") s.port = value;
+            else if (key == "--idle") s.idle = std::stoul(value);
+            else if (key == "--inflight") s.inflight = std::stoul(value);
+            else if (key == "--warmup") s.warmup = std::stoul(value);
+            else if (key == "--target") s.target = value;
+            else if (key == "--bearer") s.bearer = value;
+            else if (key == "--email") s.email = value;
+            else if (key == "--password") s.password = value;
+            else if (key == "--settle-ms") s.settle = std::chrono::milliseconds(std::stol(value));
+            else if (key == "--max-idle-bytes") s.maxIdleBytes = std::stod(value);
+            else if (key == "--max-request-bytes") s.maxRequestBytes = std::stod(value);
+            else if (key == "--json") s.jsonOut = value;
+            else throw std::invalid_argument("unknown option " + key);
+        }
+        return s;
+    }
+} // namespace
+
+int main(const int argc, char** argv) {
+    Settings settings;
+    try {
+        settings = parse(argc, argv);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "memory_bench: %s\n", e.what());
+        printUsage();
+        return 2;
+    }
+    raiseFileLimit(settings.idle + settings.inflight + 64);
+
+    std::vector<Phase> phases;
+    std::map<std::string, std::size_t> statuses;
+    try {
+        Client client(settings);
+        tcp::socket metrics = client.connect();
+        if (settings.bearer.empty()) settings.bearer = login(client, settings);
+
+        for (std::size_t i = 0; i < settings.warmup; ++i) {
+            tcp::socket socket = client.connect();
+            (void)Client::roundTrip(socket, client.request(http::verb::get, "/health"));
+        }
+        const Sample baseline = settle(client, metrics, settings,
+            [](const Sample& s) { return s.sessions <= 1 && s.requests <= 0; }, "only the metrics connection");
+        phases.push_back({"baseline", baseline});
+
+        std::vector<tcp::socket> idle;
+        idle.reserve(settings.idle);
+        for (std::size_t i = 0; i < settings.idle; ++i) {
+            idle.push_back(client.connect());
+            const HttpResponse response = Client::roundTrip(idle.back(), client.request(http::verb::get, "/health"));
+            if (response.result() != http::status::ok) throw std::runtime_error("GET /health answered " + std::to_string(response.result_int()));
+        }
+        const double idleSessions = baseline.sessions + static_cast<double>(settings.idle);
+        const Sample idleSample = settle(client, metrics, settings,
+            [idleSessions](const Sample& s) { return s.sessions >= idleSessions; }, "all idle connections");
+        phases.push_back({"idle", idleSample});
+
+        // Requests are written, their responses are read only after the sample
+        std::vector<tcp::socket> inflight;
+        inflight.reserve(settings.inflight);
+        HttpRequest slow = client.request(http::verb::get, settings.target);
+        slow.set(http::field::authorization, settings.bearer);
+        slow.prepare_payload();
+        for (std::size_t i = 0; i < settings.inflight; ++i) {
+            inflight.push_back(client.connect());
+            http::write(inflight.back(), slow);
+        }
+        const double inflightSessions = idleSessions + static_cast<double>(settings.inflight);
+        const double inflightRequests = static_cast<double>(settings.inflight);
+        phases.push_back({"inflight", settle(client, metrics, settings,
+            [inflightSessions, inflightRequests](const Sample& s) {
+                return s.sessions >= inflightSessions && s.requests >= inflightRequests;
+            },
+            "every request parked in the backend (do they finish too early? raise FAKE_DB_LATENCY_US)"
+        )});
+
+        for (auto& socket : inflight) {
+            boost::system::error_code ec;
+            beast::flat_buffer buffer;
+            HttpResponse response;
+            http::read(socket, buffer, response, ec);
+            ++statuses[ec ? "transport" : std::to_string(response.result_int())];
+        }
+        inflight.clear();
+        idle.clear();
+        phases.push_back({"released", settle(client, metrics, settings,
+            [&baseline](const Sample& s) { return s.sessions <= baseline.sessions; }, "only the metrics connection")});
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "memory_bench: %s\n", e.what());
+        return 1;
+    }
+
+    const Sample& baseline = phases[0].sample;
+    const Sample& idleSample = phases[1].sample;
+    const Sample& inflightSample = phases[2].sample;
+    const PerUnit perConnection = perUnit(baseline, idleSample, settings.idle);
+    const PerUnit perInflight = perUnit(idleSample, inflightSample, settings.inflight);
+    // An in-flight request brings its own connection: the request's share is what it adds on top of an idle one
+    const PerUnit perRequest{
+        perInflight.rss - perConnection.rss,
+        perInflight.heap - perConnection.heap,
+        perInflight.live && perConnection.live ? std::optional(*perInflight.live - *perConnection.live) : std::nullopt
+    };
+
+    std::printf("idle=%zu inflight=%zu target=%s %s:%s\n",
+        settings.idle, settings.inflight, settings.target.c_str(), settings.host.c_str(), settings.port.c_str());
+    std::printf("%-10s %9s %9s %10s %10s %10s %10s\n", "phase", "sessions", "requests", "rss_mib", "heap_mib", "free_mib", "live_mib");
+    for (const auto& [name, s] : phases) {
+        std::printf("%-10s %9.0f %9.0f %10.2f %10.2f %10.2f %10s\n",
+            name.c_str(), s.sessions, s.requests, mib(s.rss), mib(s.heapInUse), mib(s.heapFree),
+            s.liveBytes ? std::to_string(mib(*s.liveBytes)).c_str() : "-");
+    }
+    std::printf("%-18s %10s %10s %10s\n", "per", "rss_kib", "heap_kib", "live_kib");
+    const std::pair<const char*, const PerUnit*> rows[] = {
+        {"idle connection", &perConnection},
+        {"in-flight request", &perRequest},
+    };
+    for (const auto& [name, u] : rows) {
+        std::printf("%-18s %10.2f %10.2f %10s\n", name, kib(u->rss), kib(u->heap), u->live ? std::to_string(kib(*u->live)).c_str() : "-");
+    }
+    std::printf("retained after release: heap %+.2f MiB, rss %+.2f MiB\n",
+        mib(phases[3].sample.heapInUse - baseline.heapInUse), mib(phases[3].sample.rss - baseline.rss));
+    std::printf("in-flight responses:");
+    for (const auto& [status, count] : statuses) std::printf(" %s=%zu", status.c_str(), count);
+    std::printf("\n");
+
+    if (!settings.jsonOut.empty()) {
+        nlohmann::json phasesJson = nlohmann::json::object();
+        for (const auto& [name, s] : phases) phasesJson[name] = sampleJson(s);
+        const nlohmann::json report{
+            {"idle", settings.idle},
+            {"inflight", settings.inflight},
+            {"target", settings.target},
+            {"phases", phasesJson},
+            {"per_idle_connection", unitJson(perConnection)},
+            {"per_inflight_request", unitJson(perRequest)},
+            {"inflight_statuses", statuses}
+        };
+        std::ofstream(settings.jsonOut) << report.dump(2) << '\n';
+    }
+
+    std::fflush(stdout);
+    bool failed = false;
+    if (settings.maxIdleBytes > 0 && perConnection.heap > settings.maxIdleBytes) {
+        std::fprintf(stderr, "memory_bench: idle connection holds %.0f heap bytes, over --max-idle-bytes %.0f\n",
+            perConnection.heap, settings.maxIdleBytes);
+        failed = true;
+    }
+    if (settings.maxRequestBytes > 0 && perRequest.heap > settings.maxRequestBytes) {
+        std::fprintf(stderr, "memory_bench: in-flight request holds %.0f heap bytes, over --max-request-bytes %.0f\n",
+            perRequest.heap, settings.maxRequestBytes);
+        failed = true;
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,67 @@
+/// Whole handlers over FakePgPool: controller -> service -> repository -> (fake) pool -> serialization.
+/// Zero latency isolates the framework's share of a request, BM_UsersIndexLatency shows what waiting adds
+#include "MicroCommon.h"
+#include "controllers/UsersController.h"
+#include "core/db/postgres/interfaces/FakePgPool.h"
+#include "repositories/users/UsersRepository.h"
+#include "services/users/UsersService.h"
+
+namespace {
+    struct Users {
+        std::shared_ptr<FakePgPool> pool;
+        UsersRepository repository;
+        FileSystemService fs;
+        net::thread_pool blockingPool{1};
+        UsersService service;
+        UsersController controller;
+
+        explicit Users(FakePgPool::Options options)
+            : pool(std::make_shared<FakePgPool>(std::move(options)))
+            , repository(pool)
+            , fs(FileSystemService::Options{.rootPath = PROJECT_ROOT, .mediaPath = "media"})
+            , service(repository, fs, blockingPool, std::make_shared<app::security::SodiumPasswordHasher>())
+            , controller(service) {}
+    };
+
+    void index(benchmark::State& state, const FakePgPool::Options& options) {
+        const EnvConfig& config = micro::env();
+        Users users(options);
+        const Request::RawRequest raw = micro::rawRequest(
+            http::verb::get,
+            "/users?limit=" + std::to_string(state.range(0))
+        );
+        micro::runOnLoop([&]() -> net::awaitable<void> {
+            for (auto _ : state) {
+                const Request request{raw, config};
+                Outcome outcome = co_await users.controller.index(request);
+                benchmark::DoNotOptimize(outcome);
+            }
+        });
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_UsersIndex(benchmark::State& state) {
+        index(state, {});
+    }
+
+    /// Each iteration sleeps 100us on the loop: the difference to BM_UsersIndex is timer overhead
+    void BM_UsersIndexLatency(benchmark::State& state) {
+        index(state, {.meanLatency = std::chrono::microseconds(100)});
+    }
+
+    /// What the fallback costs on its own, it is part of every number above
+    void BM_FakeSynthesize(benchmark::State& state) {
+        const FakePgPool pool({});
+        const std::string sql = "SELECT id,username,picture,email,created_at,updated_at FROM users ORDER BY id LIMIT $1::int";
+        const std::vector<std::optional<std::string>> params{std::to_string(state.range(0))};
+        for (auto _ : state) {
+            PgResult result = pool.synthesize(sql, params);
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(BM_UsersIndex)->Arg(1)->Arg(50)->Arg(1000);
+BENCHMARK(BM_UsersIndexLatency)->Arg(50)->UseRealTime();
+BENCHMARK(BM_FakeSynthesize)->Arg(1)->Arg(50)->Arg(1000);
@@ -0,0 +1,38 @@
+/// POCOMultipartAdapter::parse on a PATCH /users/{id} shaped form: text fields + one file of growing size
+#include "MicroCommon.h"
+#include "core/multipart/adapters/POCOMultipartAdapter.h"
+
+namespace {
+    constexpr auto kBoundary = "----MicroBenchBoundary7MA4YWxkTrZu0gW";
+
+    std::string multipartBody(const std::size_t fileBytes) {
+        std::string body;
+        const auto field = [&](const std::string& name, const std::string& value) {
+            body += std::string("--") + kBoundary + "\r\n";
+            body += "Content-Disposition: form-data; name=\"" + name + "\"\r\n\r\n";
+            body += value + "\r\n";
+        };
+        field("username", "alice");
+        field("email", "alice@example.com");
+        body += std::string("--") + kBoundary + "\r\n";
+        body += "Content-Disposition: form-data; name=\"picture\"; filename=\"avatar.png\"\r\n";
+        body += "Content-Type: image/png\r\n\r\n";
+        body += std::string(fileBytes, '\x7f');
+        body += "\r\n";
+        body += std::string("--") + kBoundary + "--\r\n";
+        return body;
+    }
+
+    void BM_MultipartParse(benchmark::State& state) {
+        const std::string contentType = std::string("multipart/form-data; boundary=") + kBoundary;
+        const std::string body = multipartBody(static_cast<std::size_t>(state.range(0)));
+        const POCOMultipartAdapter adapter;
+        for (auto _ : state) {
+            auto parts = adapter.parse(contentType, body);
+            benchmark::DoNotOptimize(parts);
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(body.size()));
+    }
+}
+
+BENCHMARK(BM_MultipartParse)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,57 @@
+/// Request-to-SQL path: filter parsing and SQLBuilder assembly as UsersRepository::getList does it
+#include "MicroCommon.h"
+#include "core/db/postgres/builder/SQLBuilder.h"
+#include "core/filters/BaseFilter.h"
+
+namespace {
+    std::string idList(const std::int64_t count) {
+        std::string out;
+        for (std::int64_t i = 0; i < count; ++i) {
+            if (i) out += ',';
+            out += std::to_string(100000 + i);
+        }
+        return out;
+    }
+
+    void BM_BaseFilterParseIds(benchmark::State& state) {
+        const std::string input = idList(state.range(0));
+        for (auto _ : state) {
+            auto ids = BaseFilter::parseIds(input);
+            benchmark::DoNotOptimize(ids);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_SQLBuilderList(benchmark::State& state) {
+        const std::vector<std::string> fields{"id", "username", "picture", "email", "created_at", "updated_at"};
+        const std::vector<std::int64_t> ids = BaseFilter::parseIds(idList(state.range(0)));
+        const std::vector<std::string> names{"alice", "bob", "carol"};
+        for (auto _ : state) {
+            SQLBuilder qb("users");
+            qb.select(fields);
+            qb.whereAny("id", "bigint", ids);
+            qb.whereAny("username", "text", names);
+            qb.where("email", std::string("alice@example.com"));
+            qb.orderBy("id");
+            qb.limit(50);
+            qb.offset(100);
+            benchmark::DoNotOptimize(qb.str());
+            benchmark::DoNotOptimize(qb.params());
+        }
+    }
+
+    void BM_SQLBuilderUpdate(benchmark::State& state) {
+        const std::vector<std::string> fields{"username", "email", "picture", "updated_at"};
+        for (auto _ : state) {
+            SQLBuilder qb("users");
+            qb.update(fields);
+            qb.where("id", 42);
+            qb.returning("id");
+            benchmark::DoNotOptimize(qb.str());
+        }
+    }
+}
+
+BENCHMARK(BM_BaseFilterParseIds)->RangeMultiplier(10)->Range(1, 1000);
+BENCHMARK(BM_SQLBuilderList)->Arg(1)->Arg(100);
+BENCHMARK(BM_SQLBuilderUpdate);
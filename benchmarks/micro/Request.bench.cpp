@@ -0,0 +1,35 @@
+/// Request construction from a parsed Beast message and query() parsing
+#include "MicroCommon.h"
+
+namespace {
+    std::string targetWithParams(const std::int64_t count) {
+        std::string target = "/users?";
+        for (std::int64_t i = 0; i < count; ++i) {
+            if (i) target += '&';
+            target += "param" + std::to_string(i) + "=value%20" + std::to_string(i);
+        }
+        return target;
+    }
+
+    void BM_RequestConstruct(benchmark::State& state) {
+        const EnvConfig& config = micro::env();
+        const Request::RawRequest raw = micro::rawRequest(http::verb::get, "/users?limit=50&offset=0");
+        for (auto _ : state) {
+            Request request{raw, config};
+            benchmark::DoNotOptimize(request);
+        }
+    }
+
+    void BM_RequestQuery(benchmark::State& state) {
+        const EnvConfig& config = micro::env();
+        const Request request{micro::rawRequest(http::verb::get, targetWithParams(state.range(0))), config};
+        for (auto _ : state) {
+            auto query = request.query();
+            benchmark::DoNotOptimize(query);
+        }
+        state.counters["params"] = static_cast<double>(state.range(0));
+    }
+}
+
+BENCHMARK(BM_RequestConstruct);
+BENCHMARK(BM_RequestQuery)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
@@ -0,0 +1,67 @@
+/// Router::dispatch over a realistic route table, and the runChain cost of every extra middleware
+#include "MicroCommon.h"
+#include "core/interfaces/MiddlewareInterface.h"
+#include "core/routers/Router.h"
+
+namespace {
+    net::awaitable<Outcome> okHandler(Request& request) {
+        co_return JsonResult{json{{"ok", true}}, http::status::ok, request.keep_alive()};
+    }
+
+    struct PassThroughMiddleware final : MiddlewareInterface {
+        net::awaitable<Outcome> handle(Request& request, Next next) override {
+            co_return co_await next(request);
+        }
+    };
+
+    /// ~40 routes: the app's own plus the shape of a grown CRUD API, parameterized ones included
+    void addRoutes(Router& router) {
+        router.get("/health", okHandler);
+        router.get("/metrics", okHandler);
+        router.post("/register", okHandler);
+        router.post("/login", okHandler);
+        router.get("/swagger", okHandler);
+        router.get("/openapi.json", okHandler);
+        for (const std::string resource : {"users", "posts", "comments", "teams", "projects", "invoices", "files"}) {
+            router.get("/" + resource, okHandler);
+            router.post("/" + resource, okHandler);
+            router.get("/" + resource + "/{id}", okHandler);
+            router.patch("/" + resource + "/{id}", okHandler);
+            router.delete_("/" + resource + "/{id}", okHandler);
+            router.get("/" + resource + "/{id}/history/{version}", okHandler);
+        }
+    }
+
+    void dispatch(benchmark::State& state, const Router& router, const std::string& target) {
+        const EnvConfig& config = micro::env();
+        const Request::RawRequest raw = micro::rawRequest(http::verb::get, target);
+        micro::runOnLoop([&]() -> net::awaitable<void> {
+            for (auto _ : state) {
+                Response response = co_await router.dispatch(Request{raw, config}, config);
+                benchmark::DoNotOptimize(response);
+            }
+        });
+    }
+
+    void BM_RouterDispatch(benchmark::State& state, const std::string& target) {
+        Router router;
+        addRoutes(router);
+        dispatch(state, router, target);
+    }
+
+    /// Depth 0 is the baseline: the difference is the coroutine frame + std::function hop per link
+    void BM_RouterMiddlewareDepth(benchmark::State& state) {
+        Router router;
+        addRoutes(router);
+        for (std::int64_t i = 0; i < state.range(0); ++i) router.use(std::make_shared<PassThroughMiddleware>());
+        dispatch(state, router, "/users/42");
+        state.counters["depth"] = static_cast<double>(state.range(0));
+    }
+}
+
+BENCHMARK_CAPTURE(BM_RouterDispatch, static_first, std::string("/health"));
+BENCHMARK_CAPTURE(BM_RouterDispatch, param_middle, std::string("/teams/42"));
+BENCHMARK_CAPTURE(BM_RouterDispatch, param_last, std::string("/files/42/history/7"));
+BENCHMARK_CAPTURE(BM_RouterDispatch, query_string, std::string("/users?limit=50&offset=100&username__in=a,b,c"));
+BENCHMARK_CAPTURE(BM_RouterDispatch, not_found, std::string("/nope/42"));
+BENCHMARK(BM_RouterMiddlewareDepth)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
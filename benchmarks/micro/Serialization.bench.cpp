@@ -0,0 +1,73 @@
+/// Response side: UserSerializer -> json, JsonRenderer::render, timestamp conversions
+#include "MicroCommon.h"
+#include "core/renderers/json/JsonRenderer.h"
+#include "helpers/DatetimeConverter.h"
+#include "serializers/users/UserSerializer.h"
+
+namespace {
+    std::vector<UserEntity> users(const std::int64_t count) {
+        std::vector<UserEntity> out;
+        out.reserve(static_cast<std::size_t>(count));
+        const auto now = std::chrono::system_clock::now();
+        for (std::int64_t i = 0; i < count; ++i) {
+            UserEntity user;
+            user.id = i + 1;
+            user.username = "user_" + std::to_string(i);
+            user.email = "user_" + std::to_string(i) + "@example.com";
+            if (i % 2 == 0) user.picture = "media/users/" + std::to_string(i) + "/avatar.png";
+            user.created_at = now;
+            user.updated_at = now;
+            out.push_back(std::move(user));
+        }
+        return out;
+    }
+
+    json usersJson(const std::vector<UserEntity>& entities) {
+        json body = json::array();
+        for (const auto& entity : entities) body.push_back(UserSerializer::fromEntity(entity).to_json());
+        return body;
+    }
+
+    /// What UsersController::index does after the repository returned
+    void BM_UserSerializerToJson(benchmark::State& state) {
+        const std::vector<UserEntity> entities = users(state.range(0));
+        for (auto _ : state) {
+            json body = usersJson(entities);
+            benchmark::DoNotOptimize(body);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_JsonRendererRender(benchmark::State& state) {
+        const EnvConfig& config = micro::env();
+        const Request request{micro::rawRequest(http::verb::get, "/users"), config};
+        const json body = usersJson(users(state.range(0)));
+        JsonRenderer renderer;
+        for (auto _ : state) {
+            Response response = renderer.render(request, http::status::ok, body, true);
+            benchmark::DoNotOptimize(response);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_ParsePgTimestamp(benchmark::State& state) {
+        const std::string value = "2025-09-04 18:32:53.123456";
+        for (auto _ : state) {
+            auto tp = parse_pg_timestamp(value);
+            benchmark::DoNotOptimize(tp);
+        }
+    }
+
+    void BM_ToIsoString(benchmark::State& state) {
+        const auto tp = parse_pg_timestamp("2025-09-04 18:32:53.123456");
+        for (auto _ : state) {
+            auto text = to_iso_string(tp);
+            benchmark::DoNotOptimize(text);
+        }
+    }
+}
+
+BENCHMARK(BM_UserSerializerToJson)->RangeMultiplier(10)->Range(1, 1000);
+BENCHMARK(BM_JsonRendererRender)->RangeMultiplier(10)->Range(1, 1000);
+BENCHMARK(BM_ParsePgTimestamp);
+BENCHMARK(BM_ToIsoString);
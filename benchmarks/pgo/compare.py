@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+"""Compares two directories of load_gen --json reports run by pgo.sh, file by file.
+
+Usage: compare.py <baseline dir> <optimized dir>
+Prints throughput and p50/p99 of the "total" histogram per run and the geometric mean throughput speedup.
+Open-loop runs hold the rate, their gain shows in latency rather than throughput.
+"""
+import json
+import math
+import sys
+from pathlib import Path
+
+
+def load(path):
+    with open(path) as f:
+        return json.load(f)
+
+
+def describe(report):
+    load_shape = f"rate {report['rate']:g}" if report["mode"] == "open" else f"vus {report['vus']}"
+    return f"{report['scenario']} {report['mode']} {load_shape}"
+
+
+def change(before, after):
+    return f"{(after / before - 1) * 100:+.1f}%" if before > 0 else "n/a"
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    baseline, optimized = Path(sys.argv[1]), Path(sys.argv[2])
+
+    # Latency columns: baseline, optimized, speedup (positive = faster)
+    print(f"{'run':<28} {'rps':>10} {'rps':>10} {'':>8} {'p50 ms':>7} {'p50 ms':>7} {'':>8} {'p99 ms':>7} {'p99 ms':>7}")
+    speedups = []
+    for before_path in sorted(baseline.glob("*.json")):
+        after_path = optimized / before_path.name
+        if not after_path.exists():
+            print(f"{before_path.name}: missing in {optimized}", file=sys.stderr)
+            continue
+        before, after = load(before_path), load(after_path)
+        b, a = before["total"], after["total"]
+        if b["errors"] or a["errors"]:
+            print(f"{describe(before)}: {b['errors']} / {a['errors']} errors, compare with care", file=sys.stderr)
+        if before["mode"] == "closed" and b["rps"] > 0 and a["rps"] > 0:
+            speedups.append(a["rps"] / b["rps"])
+        print(f"{describe(before):<28} {b['rps']:>10.0f} {a['rps']:>10.0f} {change(b['rps'], a['rps']):>8}"
+              f" {b['latency_ms']['p50']:>7.3f} {a['latency_ms']['p50']:>7.3f}"
+              f" {change(a['latency_ms']['p50'], b['latency_ms']['p50']):>8}"
+              f" {b['latency_ms']['p99']:>7.3f} {a['latency_ms']['p99']:>7.3f}"
+              f" {change(a['latency_ms']['p99'], b['latency_ms']['p99']):>8}")
+
+    if speedups:
+        geomean = math.exp(sum(math.log(s) for s in speedups) / len(speedups))
+        print(f"closed-loop throughput speedup (geometric mean of {len(speedups)}): {geomean:.3f}x")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,114 @@
+#!/usr/bin/env bash
+# Profile-guided, link-time optimized build of app.
+#
+#  1. plain Release build of app and load_gen (load_gen stays uninstrumented: its app_core objects would add
+#     client-side counts to the profile);
+#  2. APP_PGO=GENERATE build, started on a fake database and driven by training.txt, profiles are written on exit;
+#  3. the same build directory reconfigured with APP_PGO=USE and APP_LTO=ON (GCC finds the profiles by object path);
+#  4. training.txt replayed against the plain and the optimized app, compare.py prints the speedup.
+#
+# Usage: benchmarks/pgo/pgo.sh [output dir, default build-pgo]
+#   PGO_PORT=18080 PGO_JOBS=$(nproc) PGO_TRAINING=benchmarks/pgo/training.txt PGO_COMPARE=1
+#   App settings come from the environment: DATABASE_DRIVER=postgres DATABASE_DSN=... trains against a local database
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/../.." && pwd)"
+OUT="$(realpath -m "${1:-$ROOT/build-pgo}")"
+PORT="${PGO_PORT:-18080}"
+JOBS="${PGO_JOBS:-$(nproc)}"
+TRAINING="$(realpath "${PGO_TRAINING:-$ROOT/benchmarks/pgo/training.txt}")"
+PROFILES="$OUT/optimized/pgo-profiles"
+
+export APP_HOST=127.0.0.1
+export APP_PORT="$PORT"
+export DATABASE_DRIVER="${DATABASE_DRIVER:-fake}"
+export LOG_LEVEL="${LOG_LEVEL:-warn}"
+export SECRET_KEY="${SECRET_KEY:-pgo_training}"
+export MEDIA_PATH="${MEDIA_PATH:-$OUT/media}"
+mkdir -p "$OUT" "$MEDIA_PATH"
+
+APP_PID=""
+cleanup() {
+    if [[ -n "$APP_PID" ]]; then kill "$APP_PID" 2>/dev/null || true; fi
+}
+trap cleanup EXIT
+
+configure() {
+    local dir="$1"
+    shift
+    cmake -S "$ROOT" -B "$dir" -DCMAKE_BUILD_TYPE=Release -DENABLE_TESTS=OFF "$@" >/dev/null
+}
+
+start_app() {
+    "$1" >"$OUT/app.log" 2>&1 &
+    APP_PID=$!
+    for _ in $(seq 100); do
+        if (exec 3<>"/dev/tcp/127.0.0.1/$PORT") 2>/dev/null; then return 0; fi
+        if ! kill -0 "$APP_PID" 2>/dev/null; then break; fi
+        sleep 0.1
+    done
+    echo "app did not start listening on $PORT, see $OUT/app.log" >&2
+    exit 1
+}
+
+# SIGINT stops the loop and main returns: the instrumented build writes its profiles at exit
+stop_app() {
+    kill -INT "$APP_PID"
+    wait "$APP_PID" || true
+    APP_PID=""
+}
+
+# Every line of the training file against the running app, JSON reports into $1 when given
+run_workload() {
+    local results="${1:-}" n=0 line
+    [[ -n "$results" ]] && mkdir -p "$results"
+    while IFS= read -r line || [[ -n "$line" ]]; do
+        [[ -z "${line// }" || "$line" == \#* ]] && continue
+        n=$((n + 1))
+        echo "  load_gen $line"
+        # shellcheck disable=SC2086 # a line holds several arguments
+        if [[ -n "$results" ]]; then
+            "$OUT/baseline/benchmarks/load_gen" --host 127.0.0.1 --port "$PORT" $line --json "$results/$(printf '%02d' "$n").json" >/dev/null
+        else
+            "$OUT/baseline/benchmarks/load_gen" --host 127.0.0.1 --port "$PORT" $line >/dev/null
+        fi
+    done <"$TRAINING"
+}
+
+echo "== plain build"
+configure "$OUT/baseline" -DENABLE_BENCHMARKS=ON -DAPP_PGO=OFF -DAPP_LTO=OFF
+cmake --build "$OUT/baseline" -j"$JOBS" --target app load_gen >/dev/null
+
+echo "== instrumented build"
+rm -rf "$PROFILES"
+configure "$OUT/optimized" -DAPP_PGO=GENERATE -DAPP_PGO_DIR="$PROFILES" -DAPP_LTO=OFF
+cmake --build "$OUT/optimized" -j"$JOBS" --target app >/dev/null
+
+echo "== training ($DATABASE_DRIVER database)"
+start_app "$OUT/optimized/app"
+run_workload
+stop_app
+
+if compgen -G "$PROFILES/*.profraw" >/dev/null; then
+    llvm-profdata merge -output="$PROFILES/app.profdata" "$PROFILES"/*.profraw
+fi
+
+echo "== optimized build (profile use + LTO)"
+configure "$OUT/optimized" -DAPP_PGO=USE -DAPP_LTO=ON
+cmake --build "$OUT/optimized" -j"$JOBS" --target app >/dev/null
+
+if [[ "${PGO_COMPARE:-1}" == "0" ]]; then
+    echo "optimized app: $OUT/optimized/app"
+    exit 0
+fi
+
+for build in baseline optimized; do
+    echo "== measuring $build"
+    rm -rf "$OUT/results/$build"
+    start_app "$OUT/$build/app"
+    run_workload "$OUT/results/$build"
+    stop_app
+done
+
+python3 "$ROOT/benchmarks/pgo/compare.py" "$OUT/results/baseline" "$OUT/results/optimized"
+echo "optimized app: $OUT/optimized/app"
@@ -0,0 +1,278 @@
+/// Replays a capture file (CAPTURE_PATH, core/capture/CaptureLog.h) against a local instance.
+///
+/// Requests are issued at their captured arrival offsets divided by --speed, each on its own coroutine,
+/// so the captured concurrency and burstiness come back as they were. Latency counts from the scheduled
+/// time (no coordinated omission). Routes are grouped by method + path with numeric segments as {id};
+/// the captured durations of the same requests are reported next to the replayed ones (measured inside the app,
+/// without network and parsing, so they are a floor rather than a like-for-like number).
+///
+/// Redacted parts: Authorization is replaced by --bearer (dropped without it), uploads by --picture.
+/// A "mismatch" is a replayed status whose class differs from the captured one.
+///
+/// Usage: replay --file capture.bin --port 8080 --speed 2 --bearer "Bearer ..." --picture a.png --json out.json
+#include "../load/LoadClient.h"
+#include "core/capture/CaptureLog.h"
+#include "core/metrics/HdrHistogram.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <nlohmann/json.hpp>
+
+namespace {
+    using namespace load;
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings {
+        std::string file;
+        std::string host = "127.0.0.1";
+        std::string port = "8080";
+        double speed = 1.0;
+        std::size_t connections = 256;
+        std::string bearer;
+        std::string picture;
+        /// 0 -> every record
+        std::size_t limit = 0;
+        std::string jsonOut;
+    };
+
+    struct RouteStats {
+        metrics::HdrHistogram replayed;
+        metrics::HdrHistogram captured;
+        std::uint64_t errors = 0;
+        std::uint64_t mismatches = 0;
+    };
+
+    /// GET /users/42?x=1 -> "GET /users/{id}"
+    std::string routeOf(const capture::Record& record) {
+        std::string_view path = record.target;
+        path = path.substr(0, path.find('?'));
+        std::string route(http::to_string(record.method));
+        route += ' ';
+        std::size_t pos = 0;
+        while (pos < path.size()) {
+            std::size_t end = path.find('/', pos + 1);
+            if (end == std::string_view::npos) end = path.size();
+            const std::string_view segment = path.substr(pos + 1, end - pos - 1);
+            route += '/';
+            const bool numeric = !segment.empty() && std::ranges::all_of(segment, [](const char c) { return c >= '0' && c <= '9'; });
+            route += numeric ? std::string_view("{id}") : segment;
+            pos = end;
+        }
+        return route;
+    }
+
+    HttpRequest rebuild(const capture::Record& record, const Settings& settings, const std::string& picture) {
+        HttpRequest request{record.method, record.target, 11};
+        std::string contentType;
+        for (const auto& [name, value] : record.headers) {
+            if (boost::beast::iequals(name, "host")) continue;
+            if (value == capture::kRedacted) {
+                if (boost::beast::iequals(name, "authorization") && !settings.bearer.empty()) request.set(name, settings.bearer);
+                continue;
+            }
+            if (boost::beast::iequals(name, "content-type")) contentType = value;
+            request.set(name, value);
+        }
+        request.body() = record.body;
+        if (!picture.empty() && contentType.find("multipart/form-data") != std::string::npos) {
+            auto rewritten = capture::rewriteMultipart(contentType, record.body, [&picture](
+                std::string_view,
+                const std::string_view filename,
+                std::string& content
+            ) {
+                if (!filename.empty()) content = picture;
+            });
+            if (rewritten) request.body() = std::move(*rewritten);
+        }
+        return request;
+    }
+
+    class Replayer {
+    public:
+        Replayer(const Settings& settings, std::vector<capture::Record> records, std::string picture)
+            : settings_(settings)
+            , records_(std::move(records))
+            , picture_(std::move(picture))
+            , pool_(ioc_.get_executor(), settings.host, settings.port, settings.connections) {}
+
+        std::map<std::string, RouteStats> run() {
+            startAt_ = Clock::now() + std::chrono::milliseconds(100);
+            net::co_spawn(ioc_, schedule(), [](const std::exception_ptr& e) {
+                if (e) std::rethrow_exception(e);
+            });
+            ioc_.run();
+            pool_.close();
+            return std::move(routes_);
+        }
+
+    private:
+        const Settings& settings_;
+        std::vector<capture::Record> records_;
+        std::string picture_;
+        net::io_context ioc_{1};
+        ConnectionPool pool_;
+        Clock::time_point startAt_;
+        std::map<std::string, RouteStats> routes_;
+
+        net::awaitable<void> issue(const capture::Record& record, const Clock::time_point intended) {
+            HttpRequest request = rebuild(record, settings_, picture_);
+            unsigned status = 0;
+            try {
+                HttpResponse response = co_await pool_.send(std::move(request));
+                status = response.result_int();
+            } catch (const std::exception&) {
+                status = 0;
+            }
+
+            RouteStats& stats = routes_[routeOf(record)];
+            stats.replayed.record(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - intended).count()
+            ));
+            stats.captured.record(record.durationUs);
+            if (status == 0) ++stats.errors;
+            else if (status / 100 != record.status / 100) ++stats.mismatches;
+        }
+
+        net::awaitable<void> schedule() {
+            net::steady_timer timer(ioc_);
+            const std::uint64_t origin = records_.empty() ? 0 : records_.front().arrivalUs;
+            for (const auto& record : records_) {
+                const auto offset = std::chrono::duration<double, std::micro>(
+                    static_cast<double>(record.arrivalUs - origin) / settings_.speed
+                );
+                const auto intended = startAt_ + std::chrono::duration_cast<Clock::duration>(offset);
+                timer.expires_at(intended);
+                co_await timer.async_wait(net::use_awaitable);
+                net::co_spawn(ioc_, issue(record, intended), net::detached);
+            }
+        }
+    };
+
+    double ms(const std::uint64_t us) { return static_cast<double>(us) / 1000.0; }
+
+    void printUsage() {
+        std::printf(
+            "replay --file capture.bin [--host 127.0.0.1] [--port 8080] [--speed 1] [--connections 256]\n"
+            "       [--bearer \"Bearer ...\"] [--picture png] [--limit N] [--json file]\n"
+        );
+    }
+
+    Settings parse(const int argc, char** argv) {
+        Settings s;
+        for (int i = 1; i < argc; ++i) {
+            const std::string key = argv[i];
+            if (key == "--help" || key == "-h") {
+                printUsage();
+                std::exit(0);
+            }
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + key);
+            const std::string value = argv[++i];
+            if (key == "--file") s.file = value;
+            else if (key == "--host") s.host = value;
+            else if (key == "--port") s.port = value;
+            else if (key == "--speed") s.speed = std::stod(value);
+            else if (key == "--connections") s.connections = std::stoul(value);
+            else if (key == "--bearer") s.bearer = value;
+            else if (key == "--picture") s.picture = value;
+            else if (key == "--limit") s.limit = std::stoul(value);
+            else if (key == "--json") s.jsonOut = value;
+            else throw std::invalid_argument("unknown option " + key);
+        }
+        if (s.file.empty()) throw std::invalid_argument("--file is required");
+        if (s.speed <= 0) throw std::invalid_argument("--speed must be positive");
+        return s;
+    }
+} // namespace
+
+int main(const int argc, char** argv) {
+    Settings settings;
+    std::vector<capture::Record> records;
+    std::string picture;
+    try {
+        settings = parse(argc, argv);
+        capture::Reader reader(settings.file);
+        try {
+            while (auto record = reader.next()) records.push_back(std::move(*record));
+        } catch (const std::runtime_error& e) {
+            // A capture cut by a crash ends with a partial record, everything before it is usable
+            std::fprintf(stderr, "replay: %s after %zu records, ignoring the rest\n", e.what(), records.size());
+        }
+        if (!settings.picture.empty()) {
+            std::ifstream file(settings.picture, std::ios::binary);
+            picture.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "replay: %s\n", e.what());
+        printUsage();
+        return 2;
+    }
+
+    // Appended on completion: arrival order has to be restored
+    std::ranges::stable_sort(records, {}, &capture::Record::arrivalUs);
+    if (settings.limit && records.size() > settings.limit) records.resize(settings.limit);
+    const double spanSeconds = records.empty()
+        ? 0.0
+        : static_cast<double>(records.back().arrivalUs - records.front().arrivalUs) / 1e6 / settings.speed;
+    std::printf("records=%zu speed=%gx span=%.1fs target=%s:%s\n",
+        records.size(), settings.speed, spanSeconds, settings.host.c_str(), settings.port.c_str());
+
+    const auto startedAt = Clock::now();
+    Replayer replayer(settings, std::move(records), std::move(picture));
+    const auto routes = replayer.run();
+    const double wallSeconds = std::chrono::duration<double>(Clock::now() - startedAt).count();
+
+    std::printf("%-32s %8s %6s %8s %10s %10s %10s %10s %10s %10s\n",
+        "route", "count", "errors", "mismatch", "p50_ms", "p90_ms", "p99_ms", "max_ms", "cap_p50", "cap_p99");
+    nlohmann::json report = nlohmann::json::array();
+    std::uint64_t failures = 0;
+    for (const auto& [route, stats] : routes) {
+        const auto& h = stats.replayed;
+        std::printf("%-32s %8llu %6llu %8llu %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n",
+            route.c_str(),
+            static_cast<unsigned long long>(h.count()),
+            static_cast<unsigned long long>(stats.errors),
+            static_cast<unsigned long long>(stats.mismatches),
+            ms(h.percentile(50)),
+            ms(h.percentile(90)),
+            ms(h.percentile(99)),
+            ms(h.max()),
+            ms(stats.captured.percentile(50)),
+            ms(stats.captured.percentile(99))
+        );
+        failures += stats.errors;
+        report.push_back({
+            {"route", route},
+            {"count", h.count()},
+            {"errors", stats.errors},
+            {"mismatches", stats.mismatches},
+            {"latency_ms", {
+                {"mean", h.mean() / 1000.0},
+                {"p50", ms(h.percentile(50))},
+                {"p90", ms(h.percentile(90))},
+                {"p99", ms(h.percentile(99))},
+                {"p999", ms(h.percentile(99.9))},
+                {"max", ms(h.max())}
+            }},
+            {"captured_ms", {
+                {"mean", stats.captured.mean() / 1000.0},
+                {"p50", ms(stats.captured.percentile(50))},
+                {"p99", ms(stats.captured.percentile(99))},
+                {"max", ms(stats.captured.max())}
+            }}
+        });
+    }
+    std::printf("wall=%.1fs\n", wallSeconds);
+
+    if (!settings.jsonOut.empty()) {
+        std::ofstream(settings.jsonOut) << nlohmann::json{
+            {"file", settings.file},
+            {"speed", settings.speed},
+            {"wall_s", wallSeconds},
+            {"routes", report}
+        }.dump(2) << '\n';
+    }
+    return failures == 0 ? 0 : 1;
+}
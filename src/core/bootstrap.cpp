@@ -2,6 +2,8 @@
 #include "core/routers/Router.h"
 #include "core/db/postgres/interfaces/PgPool.h"
 #include "core/loggers/LoggerSingleton.h"
+#include "core/metrics/MetricsRegistry.h"
+#include "core/tracing/TraceContext.h"
 
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
@@ -11,8 +13,11 @@
 #include <boost/asio/detached.hpp>
 #include <boost/asio/signal_set.hpp>
 #include <boost/asio/use_awaitable.hpp>
+#include <deque>
+#include <exception>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include "core/http/interfaces/HttpInterface.h"
 
 namespace beast = boost::beast;
@@ -23,55 +28,298 @@ using net::detached;
 using net::use_awaitable;
 using RawRequest = http::request<http::string_body>;
 
-class HttpSession : public std::enable_shared_from_this<HttpSession> {
+namespace {
+    struct SessionMetrics {
+        metrics::Counter accepted;
+        metrics::Gauge inFlight;
+    };
+
+    const SessionMetrics& sessionMetrics() {
+        auto& registry = metrics::MetricsRegistry::instance();
+        static const SessionMetrics m{
+            registry.counter("http_sessions_total", "Accepted connections"),
+            registry.gauge("http_sessions_in_flight", "Open connections")
+        };
+        return m;
+    }
+
+    /// Lives in the session frame, also decrements when the frame is destroyed on shutdown
+    struct InFlightSession {
+        InFlightSession() {
+            sessionMetrics().accepted.inc();
+            sessionMetrics().inFlight.inc();
+        }
+        ~InFlightSession() { sessionMetrics().inFlight.dec(); }
+        InFlightSession(const InFlightSession&) = delete;
+        InFlightSession& operator=(const InFlightSession&) = delete;
+    };
+}
+
+class HttpSession {
+    /// Request read ahead of its response: written in arrival order, whatever order the dispatches finish in
+    struct Pending {
+        std::shared_ptr<trace::RequestContext> ctx;
+        bool isHead = false;
+        std::optional<Response> response;
+        std::exception_ptr error;
+        /// Request and response body bytes held until the response is written
+        std::size_t bytes = 0;
+
+        [[nodiscard]] bool done() const noexcept { return response.has_value() || error; }
+    };
+
     tcp::socket socket_;
     Router& router_;
     const EnvConfig& env_;
     beast::flat_buffer buffer_;
+    /// With pipelining a strand: the reader, the writer and the dispatches of a connection share the state below
+    net::any_io_executor executor_;
+    /// Trace context of the request being served (pipelined: written), current on every resumption of run()
+    std::shared_ptr<trace::ContextSlot> traceSlot_ = std::make_shared<trace::ContextSlot>();
+
+    std::deque<std::shared_ptr<Pending>> pipeline_;
+    std::size_t pipelineBytes_ = 0;
+    bool readerDone_ = false;
+    /// Writer gave up (error, response without keep-alive): the reader stops
+    bool closed_ = false;
+    /// Used as events: cancel() wakes the reader (room in the pipeline) and the writer (a response is ready)
+    net::steady_timer readerWake_;
+    net::steady_timer writerWake_;
 
 public:
     HttpSession(tcp::socket&& socket, Router& router, const EnvConfig& env)
         : socket_(std::move(socket))
         , router_(router)
         , env_(env)
+        , executor_(env.http_pipeline_depth > 1 ? net::any_io_executor(net::make_strand(socket_.get_executor())) : socket_.get_executor())
+        , readerWake_(executor_)
+        , writerWake_(executor_)
     {
     }
 
-    awaitable<void> run() {
-        auto self = shared_from_this();
+    [[nodiscard]] const net::any_io_executor& executor() const noexcept { return executor_; }
+    [[nodiscard]] const std::shared_ptr<trace::ContextSlot>& traceSlot() const noexcept { return traceSlot_; }
+
+    /// Takes its owner: co_spawn may post the start (strands always do), the listener's pointer is gone by then
+    static awaitable<void> run(const std::shared_ptr<HttpSession> self) {
+        const InFlightSession inFlight;
 
         try {
-            for (;;) {
+            if (self->env_.http_pipeline_depth > 1) {
+                co_await self->servePipelined(self);
+            } else {
+                co_await self->serveSequentially();
+            }
+        } catch (const boost::system::system_error& se) {
+            LoggerSingleton::get().warn("Session error: " + se.code().message());
+        } catch (const std::exception& ex) {
+            LoggerSingleton::get().error("Session exception: " + std::string(ex.what()));
+        }
+
+        co_return;
+    }
+
+private:
+    /// One request at a time: the next one is read after the previous response left
+    awaitable<void> serveSequentially() {
+        for (;;) {
+            http::request_parser<http::string_body> parser;
+            parser.body_limit(env_.file_upload_limit_size);
+
+            // Header first: idle keep-alive time is not part of the request
+            co_await http::async_read_header(socket_, buffer_, parser, use_awaitable);
+
+            // Fresh context per request, RequestIdMiddleware fills in its identity
+            const auto ctx = std::make_shared<trace::RequestContext>();
+            trace::attach(ctx);
+            const auto parseStartedAt = std::chrono::steady_clock::now();
+            ctx->timings.start(parseStartedAt);
+
+            co_await http::async_read(socket_, buffer_, parser, use_awaitable);
+
+            RawRequest raw = parser.release();
+            const bool isHead = raw.method() == http::verb::head;
+            Request req(std::move(raw), env_);
+            ctx->timings.add(trace::Phase::Parse, std::chrono::steady_clock::now() - parseStartedAt);
+
+            Response res = co_await router_.dispatch(std::move(req), env_);
+
+            const bool keep = res.keep_alive();
+            co_await write(res, isHead, *ctx);
+
+            if (!keep) {
+                beast::error_code ec;
+                socket_.shutdown(tcp::socket::shutdown_send, ec);
+                break;
+            }
+        }
+    }
+
+    /// HTTP/1.1 pipelining: up to http_pipeline_depth requests are read ahead, safe ones (GET, HEAD, OPTIONS)
+    /// are dispatched concurrently, run() writes the responses in request order. The reader pauses while the
+    /// pipeline is full or holds http_pipeline_max_bytes of bodies, later requests wait in the socket and TCP
+    /// slows the client down
+    awaitable<void> servePipelined(const std::shared_ptr<HttpSession> self) {
+        // Own slot: the reader attaches each request while parsing it, run() the one being written
+        co_spawn(trace::ContextExecutor(executor_, std::make_shared<trace::ContextSlot>()), readAhead(self), detached);
+
+        std::exception_ptr error;
+        try {
+            co_await writeInOrder();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        // The reader may be parked on a request that will never be answered or on a full pipeline
+        closed_ = true;
+        readerWake_.cancel();
+        beast::error_code ec;
+        socket_.cancel(ec);
+        if (error) std::rethrow_exception(error);
+    }
+
+    awaitable<void> readAhead(const std::shared_ptr<HttpSession> self) {
+        try {
+            while (!closed_) {
+                // A single request may exceed the byte budget on its own, it is read once the pipeline is empty
+                while (!closed_ && !pipeline_.empty()
+                       && (pipeline_.size() >= env_.http_pipeline_depth || pipelineBytes_ >= env_.http_pipeline_max_bytes)) {
+                    co_await wait(readerWake_);
+                }
+                if (closed_) break;
+
                 http::request_parser<http::string_body> parser;
                 parser.body_limit(env_.file_upload_limit_size);
+                co_await http::async_read_header(socket_, buffer_, parser, use_awaitable);
+
+                const auto ctx = std::make_shared<trace::RequestContext>();
+                trace::attach(ctx);
+                const auto parseStartedAt = std::chrono::steady_clock::now();
+                ctx->timings.start(parseStartedAt);
 
                 co_await http::async_read(socket_, buffer_, parser, use_awaitable);
 
                 RawRequest raw = parser.release();
+                const auto pending = std::make_shared<Pending>();
+                pending->ctx = ctx;
+                pending->isHead = raw.method() == http::verb::head;
+                pending->bytes = raw.body().size();
+                // Connection: close, HTTP/1.0 without keep-alive: nothing after this request is read
+                const bool keep = raw.keep_alive();
+                const bool safe = isSafe(raw.method());
                 Request req(std::move(raw), env_);
+                ctx->timings.add(trace::Phase::Parse, std::chrono::steady_clock::now() - parseStartedAt);
 
-                Response res = co_await router_.dispatch(std::move(req), env_);
+                // RFC 7230 6.3.2: only safe methods run in parallel. A write starts after everything before it
+                // was answered and nothing after it starts before it is answered (read-your-writes)
+                if (!safe) {
+                    co_await drain();
+                    if (closed_) break;
+                }
 
-                const bool keep = res.keep_alive();
+                pipeline_.push_back(pending);
+                pipelineBytes_ += pending->bytes;
 
-                co_await http::async_write(socket_, res, use_awaitable);
+                // Slot per request: concurrent dispatches never see each other's context
+                auto slot = std::make_shared<trace::ContextSlot>();
+                slot->context = ctx;
+                co_spawn(trace::ContextExecutor(executor_, std::move(slot)), dispatchInto(self, pending, std::move(req)), detached);
 
-                if (!keep) {
-                    beast::error_code ec;
-                    socket_.shutdown(tcp::socket::shutdown_send, ec);
-                    break;
-                }
+                if (!keep) break;
+                if (!safe) co_await drain();
             }
         } catch (const boost::system::system_error& se) {
-            LoggerSingleton::get().warn("Session error: " + se.code().message());
+            // Cancelled by the writer: it already reported why
+            if (!closed_) LoggerSingleton::get().warn("Session error: " + se.code().message());
         } catch (const std::exception& ex) {
             LoggerSingleton::get().error("Session exception: " + std::string(ex.what()));
         }
 
-        co_return;
+        readerDone_ = true;
+        writerWake_.cancel();
+    }
+
+    awaitable<void> dispatchInto(const std::shared_ptr<HttpSession> self, const std::shared_ptr<Pending> pending, Request req) {
+        try {
+            Response res = co_await router_.dispatch(std::move(req), env_);
+            // A shared payload is kept alive by the queued response as well, it counts like an own body
+            const std::size_t bodyBytes = res.sharedPayload() ? res.sharedPayload()->size : res.body().size();
+            pending->bytes += bodyBytes;
+            pipelineBytes_ += bodyBytes;
+            pending->response.emplace(std::move(res));
+        } catch (...) {
+            pending->error = std::current_exception();
+        }
+        writerWake_.cancel();
+    }
+
+    /// Head of the pipeline first: a fast response waits behind a slow earlier one (HTTP/1.1 has no reordering)
+    awaitable<void> writeInOrder() {
+        for (;;) {
+            while (pipeline_.empty() || !pipeline_.front()->done()) {
+                if (pipeline_.empty() && readerDone_) co_return;
+                co_await wait(writerWake_);
+            }
+
+            const std::shared_ptr<Pending> pending = pipeline_.front();
+            if (pending->error) std::rethrow_exception(pending->error);
+
+            trace::attach(pending->ctx);
+            Response& res = *pending->response;
+            const bool keep = res.keep_alive();
+            co_await write(res, pending->isHead, *pending->ctx);
+
+            pipeline_.pop_front();
+            pipelineBytes_ -= pending->bytes;
+            readerWake_.cancel();
+
+            if (!keep) {
+                beast::error_code ec;
+                socket_.shutdown(tcp::socket::shutdown_send, ec);
+                co_return;
+            }
+        }
+    }
+
+    awaitable<void> write(Response& res, const bool isHead, trace::RequestContext& ctx) {
+        const auto writeStartedAt = std::chrono::steady_clock::now();
+        if (res.sharedPayload()) {
+            co_await writeShared(res, isHead);
+        } else {
+            co_await http::async_write(socket_, res, use_awaitable);
+        }
+        // Write is known only after the response left: metrics only, not in Server-Timing
+        const auto writtenAt = std::chrono::steady_clock::now();
+        ctx.timings.add(trace::Phase::Write, writtenAt - writeStartedAt);
+        ctx.timings.publish(writtenAt);
+    }
+
+    /// Gather write: own head + shared headers + shared chunks, the payload itself is never copied
+    awaitable<void> writeShared(const Response& res, const bool isHead) {
+        const std::shared_ptr<const SharedPayload> payload = res.sharedPayload();
+        const std::string head = SharedPayload::serializeHead(res.base(), payload->size);
+        co_await net::async_write(socket_, payload->buffers(head, !isHead), use_awaitable);
+    }
+
+    static bool isSafe(const http::verb method) noexcept {
+        return method == http::verb::get || method == http::verb::head || method == http::verb::options;
+    }
+
+    /// Reader side: waits until every queued response was written (or the writer gave up)
+    awaitable<void> drain() {
+        while (!closed_ && !pipeline_.empty()) {
+            co_await wait(readerWake_);
+        }
+    }
+
+    /// Parks the caller until the event is cancelled
+    static awaitable<void> wait(net::steady_timer& event) {
+        event.expires_at(net::steady_timer::time_point::max());
+        boost::system::error_code ec;
+        // operation_aborted is the wake-up signal
+        co_await event.async_wait(net::redirect_error(use_awaitable, ec));
     }
 
-private:
     awaitable<void> sendError(http::status status, std::string msg) {
         Response res{status, 11};
         res.set(http::field::content_type, "text/plain");
@@ -99,7 +347,8 @@ static awaitable<void> listener(const std::string& host, const uint16_t port, Ro
 
         auto session = std::make_shared<HttpSession>(std::move(sock), router, env);
 
-        co_spawn(exec, session->run(), detached);
+        // Resumptions of the session go through the slot: the request context follows the coroutine
+        co_spawn(trace::ContextExecutor(session->executor(), session->traceSlot()), HttpSession::run(session), detached);
     }
 }
 
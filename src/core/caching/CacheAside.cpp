@@ -0,0 +1,208 @@
+#include "core/caching/CacheAside.h"
+#include "core/errors/Errors.h"
+#include "core/loggers/LoggerSingleton.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+    constexpr std::string_view kEnvelopeVersion = "v1";
+
+    std::int64_t toMillis(const std::chrono::system_clock::time_point tp) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+    }
+
+    double uniformOpen() {
+        // (0, 1]: log(0) must never happen
+        thread_local std::mt19937_64 rng{std::random_device{}()};
+        std::uniform_real_distribution dist(0.0, 1.0);
+        return 1.0 - dist(rng);
+    }
+} // namespace
+
+/// v1|{expiresAtMs}|{deltaMs}|{payload}, expiresAtMs = 0 -> never expires
+std::string CacheAside::encode(const Envelope& envelope) {
+    const std::int64_t expiresAt = envelope.expiresAt == std::chrono::system_clock::time_point::max()
+        ? 0
+        : toMillis(envelope.expiresAt);
+
+    std::string out;
+    out.reserve(envelope.value.size() + 40);
+    out.append(kEnvelopeVersion);
+    out += '|';
+    out += std::to_string(expiresAt);
+    out += '|';
+    out += std::to_string(envelope.delta.count());
+    out += '|';
+    out += envelope.value;
+    return out;
+}
+
+std::optional<CacheAside::Envelope> CacheAside::decode(const std::string& raw) {
+    if (!raw.starts_with(kEnvelopeVersion) || raw.size() <= kEnvelopeVersion.size()
+        || raw[kEnvelopeVersion.size()] != '|') {
+        return std::nullopt;
+    }
+
+    const std::size_t expiresFrom = kEnvelopeVersion.size() + 1;
+    const std::size_t expiresTo = raw.find('|', expiresFrom);
+    if (expiresTo == std::string::npos) return std::nullopt;
+    const std::size_t deltaTo = raw.find('|', expiresTo + 1);
+    if (deltaTo == std::string::npos) return std::nullopt;
+
+    try {
+        const std::int64_t expiresAt = std::stoll(raw.substr(expiresFrom, expiresTo - expiresFrom));
+        const std::int64_t delta = std::stoll(raw.substr(expiresTo + 1, deltaTo - expiresTo - 1));
+
+        Envelope envelope;
+        envelope.expiresAt = expiresAt == 0
+            ? std::chrono::system_clock::time_point::max()
+            : std::chrono::system_clock::time_point{std::chrono::milliseconds(expiresAt)};
+        envelope.delta = std::chrono::milliseconds(delta);
+        envelope.value = raw.substr(deltaTo + 1);
+        return envelope;
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+/// XFetch (Vattani et al.): refresh when now - delta * beta * ln(rand) >= expiry.
+/// Slow loaders (big delta) start refreshing earlier, probability reaches 1 at expiry.
+bool CacheAside::shouldRefreshEarly(
+    const Envelope& envelope,
+    const std::chrono::system_clock::time_point now,
+    const double beta
+) {
+    if (beta <= 0.0 || envelope.expiresAt == std::chrono::system_clock::time_point::max()) return false;
+
+    const double gapMs = -static_cast<double>(envelope.delta.count()) * beta * std::log(uniformOpen());
+    const auto gap = std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        std::chrono::duration<double, std::milli>(gapMs)
+    );
+    return now + gap >= envelope.expiresAt;
+}
+
+net::awaitable<std::string> CacheAside::getOrLoad(std::string key, Loader loader, const Options options) {
+    std::optional<std::string> raw;
+    try {
+        raw = co_await cache_->get(key);
+    } catch (const std::exception& e) {
+        LoggerSingleton::get().warn("CacheAside::getOrLoad: cache unavailable", {
+            {"key", key},
+            {"error", std::string(e.what())}
+        });
+    }
+
+    std::optional<Envelope> stale;
+    if (raw) {
+        if (auto envelope = decode(*raw)) {
+            const auto now = std::chrono::system_clock::now();
+            if (now < envelope->expiresAt) {
+                if (shouldRefreshEarly(*envelope, now, options.beta)) {
+                    refreshInBackground(key, loader, options);
+                }
+                co_return std::move(envelope->value);
+            }
+            // Physically alive but logically expired -> stale-while-revalidate or stale-if-error window
+            const auto staleUntil = envelope->expiresAt + std::chrono::seconds(options.staleWhileRevalidate);
+            if (options.staleWhileRevalidate > 0 && now < staleUntil) {
+                refreshInBackground(key, loader, options);
+                co_return std::move(envelope->value);
+            }
+            stale = std::move(envelope);
+        }
+    }
+
+    // Miss: one loader per key, everybody else awaits it.
+    // Loader is a named local: GCC destroys temporaries inside co_await expressions twice
+    Loader load = [this, key, loader, options]() { return loadAndStore(key, loader, options, true); };
+    std::optional<std::string> unavailable;
+    try {
+        co_return co_await flights_.run(key, std::move(load));
+    } catch (const DbUnavailableError& e) {
+        if (!stale || options.staleIfError <= 0) throw;
+        unavailable = e.what();
+    }
+
+    const auto staleUntil = stale->expiresAt + std::chrono::seconds(options.staleIfError);
+    if (std::chrono::system_clock::now() >= staleUntil) throw DbUnavailableError(*unavailable);
+
+    LoggerSingleton::get().warn("CacheAside::getOrLoad: database unavailable, serving stale", {
+        {"key", key},
+        {"error", *unavailable}
+    });
+    co_return std::move(stale->value);
+}
+
+net::awaitable<std::string> CacheAside::loadAndStore(
+    std::string key,
+    Loader loader,
+    const Options options,
+    const bool recheck
+) {
+    if (recheck) {
+        // A previous flight may have stored the value after our miss but before we became the leader
+        if (auto fresh = co_await getFresh(key)) co_return std::move(*fresh);
+    }
+
+    const auto startedAt = std::chrono::steady_clock::now();
+    std::string value = co_await loader();
+    const auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startedAt
+    );
+
+    Envelope envelope;
+    envelope.expiresAt = options.ttl > 0
+        ? std::chrono::system_clock::now() + std::chrono::seconds(options.ttl)
+        : std::chrono::system_clock::time_point::max();
+    envelope.delta = delta;
+    envelope.value = value;
+
+    // Physical ttl keeps the entry for stale-while-revalidate / stale-if-error windows
+    const int staleWindow = std::max({0, options.staleWhileRevalidate, options.staleIfError});
+    const int physicalTtl = options.ttl > 0 ? options.ttl + staleWindow : 0;
+    try {
+        co_await cache_->set(key, encode(envelope), physicalTtl);
+    } catch (const std::exception& e) {
+        LoggerSingleton::get().warn("CacheAside::loadAndStore: cache unavailable", {
+            {"key", key},
+            {"error", std::string(e.what())}
+        });
+    }
+
+    co_return value;
+}
+
+net::awaitable<std::optional<std::string>> CacheAside::getFresh(const std::string& key) {
+    std::optional<std::string> raw;
+    try {
+        raw = co_await cache_->get(key);
+    } catch (const std::exception&) {
+        // Already logged by the caller's lookup, just load
+        co_return std::nullopt;
+    }
+    if (!raw) co_return std::nullopt;
+
+    auto envelope = decode(*raw);
+    if (!envelope || std::chrono::system_clock::now() >= envelope->expiresAt) co_return std::nullopt;
+    co_return std::move(envelope->value);
+}
+
+net::awaitable<void> CacheAside::refresh(std::string key, Loader loader, const Options options) {
+    try {
+        // Joins an in-flight load if there is one, so refreshes are coalesced as well
+        Loader load = [this, key, loader, options]() { return loadAndStore(key, loader, options, false); };
+        co_await flights_.run(key, std::move(load));
+    } catch (const std::exception& e) {
+        // Current value is still served, next request will try again
+        LoggerSingleton::get().warn("CacheAside::refresh: background refresh failed", {
+            {"key", key},
+            {"error", std::string(e.what())}
+        });
+    }
+}
+
+void CacheAside::refreshInBackground(std::string key, Loader loader, const Options options) {
+    net::co_spawn(executor_, refresh(std::move(key), std::move(loader), options), net::detached);
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "core/caching/SingleFlight.h"
+#include "core/caching/interfaces/CacheInterface.h"
+
+/// Stampede-safe read-through on top of CachingInterface.
+///
+/// Every value is wrapped into an envelope with its logical expiry and the time it took to load (delta).
+///  - misses are coalesced through SingleFlight, one loader per key;
+///  - XFetch: before expiry a request may refresh early with probability growing as
+///    now - delta * beta * ln(rand) approaches expiry, so hot keys are renewed before they die;
+///  - stale-while-revalidate: within staleWhileRevalidate seconds after expiry the old value is served
+///    and the refresh runs in background;
+///  - stale-if-error: when the loader hits an unavailable database the expired value is served instead.
+class CacheAside {
+public:
+    using Loader = SingleFlight::Loader;
+
+    struct Options {
+        /// Logical freshness, seconds
+        int ttl = 30;
+        /// XFetch aggressiveness, 0 disables early refresh
+        double beta = 1.0;
+        /// Seconds a stale value may be served while refreshing, 0 disables
+        int staleWhileRevalidate = 0;
+        /// Seconds a stale value may be served when the loader fails with DbUnavailableError, 0 disables
+        int staleIfError = 0;
+    };
+
+    struct Envelope {
+        std::chrono::system_clock::time_point expiresAt;
+        std::chrono::milliseconds delta{0};
+        std::string value;
+    };
+
+    CacheAside(std::shared_ptr<CachingInterface> cache, net::any_io_executor executor)
+        : cache_(std::move(cache)), executor_(executor), flights_(std::move(executor)) {}
+
+    /// Loader must own everything it references: it may outlive the caller (background refresh)
+    net::awaitable<std::string> getOrLoad(std::string key, Loader loader, Options options);
+
+    [[nodiscard]] SingleFlight& flights() noexcept { return flights_; }
+
+    static std::string encode(const Envelope& envelope);
+    static std::optional<Envelope> decode(const std::string& raw);
+    static bool shouldRefreshEarly(const Envelope& envelope, std::chrono::system_clock::time_point now, double beta);
+
+private:
+    std::shared_ptr<CachingInterface> cache_;
+    net::any_io_executor executor_;
+    SingleFlight flights_;
+
+    /// recheck: look at the cache again before loading (miss path), background refresh skips it
+    net::awaitable<std::string> loadAndStore(std::string key, Loader loader, Options options, bool recheck);
+    net::awaitable<std::optional<std::string>> getFresh(const std::string& key);
+    net::awaitable<void> refresh(std::string key, Loader loader, Options options);
+    void refreshInBackground(std::string key, Loader loader, Options options);
+};
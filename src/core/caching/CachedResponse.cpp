@@ -0,0 +1,69 @@
+#include "core/caching/CachedResponse.h"
+
+#include <charconv>
+#include <string_view>
+
+namespace {
+    constexpr std::string_view kPrefix = "v1|";
+
+    /// Reads an unsigned number terminated by '|', advances pos past the separator
+    template <class T>
+    bool readNumber(const std::string& raw, std::size_t& pos, T& out) {
+        const std::size_t end = raw.find('|', pos);
+        if (end == std::string::npos) return false;
+        const auto [ptr, ec] = std::from_chars(raw.data() + pos, raw.data() + end, out);
+        if (ec != std::errc{} || ptr != raw.data() + end) return false;
+        pos = end + 1;
+        return true;
+    }
+} // namespace
+
+std::string CachedResponse::encode() const {
+    const auto storedAtMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        storedAt.time_since_epoch()
+    ).count();
+
+    std::string out;
+    out.reserve(kPrefix.size() + 64 + contentType.size() + etag.size() + body.size());
+    out.append(kPrefix);
+    out += std::to_string(storedAtMs);
+    out += '|';
+    out += std::to_string(status);
+    out += '|';
+    out += std::to_string(contentType.size());
+    out += '|';
+    out += std::to_string(etag.size());
+    out += '|';
+    out += contentType;
+    out += etag;
+    out += body;
+    return out;
+}
+
+std::optional<CachedResponse> CachedResponse::decode(const std::string& raw) {
+    if (!raw.starts_with(kPrefix)) return std::nullopt;
+
+    std::size_t pos = kPrefix.size();
+    std::int64_t storedAtMs = 0;
+    unsigned status = 0;
+    std::size_t contentTypeLength = 0;
+    std::size_t etagLength = 0;
+    if (!readNumber(raw, pos, storedAtMs)) return std::nullopt;
+    if (!readNumber(raw, pos, status)) return std::nullopt;
+    if (!readNumber(raw, pos, contentTypeLength)) return std::nullopt;
+    if (!readNumber(raw, pos, etagLength)) return std::nullopt;
+    if (raw.size() - pos < contentTypeLength + etagLength) return std::nullopt;
+
+    CachedResponse response;
+    response.status = status;
+    response.storedAt = std::chrono::system_clock::time_point{std::chrono::milliseconds(storedAtMs)};
+    response.contentType = raw.substr(pos, contentTypeLength);
+    response.etag = raw.substr(pos + contentTypeLength, etagLength);
+    response.body = raw.substr(pos + contentTypeLength + etagLength);
+    return response;
+}
+
+std::chrono::seconds CachedResponse::age(const std::chrono::system_clock::time_point now) const {
+    if (now <= storedAt) return std::chrono::seconds(0);
+    return std::chrono::duration_cast<std::chrono::seconds>(now - storedAt);
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <chrono>
+#include <optional>
+#include <string>
+
+/// Serialized HTTP response stored in CachingInterface (serve-stale, response cache)
+struct CachedResponse {
+    unsigned status = 200;
+    std::string contentType;
+    /// Quoted strong validator, may be empty
+    std::string etag;
+    std::string body;
+    std::chrono::system_clock::time_point storedAt;
+
+    /// v1|{storedAtMs}|{status}|{contentTypeLength}|{etagLength}|{contentType}{etag}{body},
+    /// body is kept as is (binary safe)
+    [[nodiscard]] std::string encode() const;
+    static std::optional<CachedResponse> decode(const std::string& raw);
+
+    [[nodiscard]] std::chrono::seconds age(std::chrono::system_clock::time_point now) const;
+};
@@ -0,0 +1,71 @@
+#include "core/caching/InMemoryCache.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+net::awaitable<void> InMemoryCache::set(std::string key, std::string value, const int ttl) {
+    const auto now = Clock::now();
+    const auto expiresAt = ttl > 0 ? now + std::chrono::seconds(ttl) : Clock::time_point::max();
+
+    std::lock_guard lk(m_);
+    if (entries_.size() >= opts_.maxEntries && !entries_.contains(key)) {
+        evict(now);
+    }
+    entries_.insert_or_assign(std::move(key), Entry{std::move(value), expiresAt});
+    co_return;
+}
+
+net::awaitable<std::optional<std::string>> InMemoryCache::get(std::string key) {
+    std::lock_guard lk(m_);
+    const auto it = entries_.find(key);
+    if (it == entries_.end()) co_return std::nullopt;
+
+    if (it->second.expiresAt <= Clock::now()) {
+        entries_.erase(it);
+        co_return std::nullopt;
+    }
+    co_return it->second.value;
+}
+
+net::awaitable<std::int64_t> InMemoryCache::increment(std::string key) {
+    std::lock_guard lk(m_);
+    auto& entry = entries_[std::move(key)];
+
+    std::int64_t current = 0;
+    if (!entry.value.empty() && entry.expiresAt > Clock::now()) {
+        try {
+            current = std::stoll(entry.value);
+        } catch (...) {
+            current = 0;
+        }
+    }
+    ++current;
+    entry.value = std::to_string(current);
+    entry.expiresAt = Clock::time_point::max();
+    co_return current;
+}
+
+std::size_t InMemoryCache::size() const {
+    std::lock_guard lk(m_);
+    return entries_.size();
+}
+
+void InMemoryCache::evict(const Clock::time_point now) {
+    // 1) Expired first
+    std::erase_if(entries_, [now](const auto& kv) { return kv.second.expiresAt <= now; });
+    if (entries_.size() < opts_.maxEntries) return;
+
+    // 2) Still full -> drop the expiring entries closest to expiry, keep counters. Per-user generations
+    //    outlive the entries written under them, so an entry goes before the generation that guards it
+    std::vector<decltype(entries_)::iterator> expiring;
+    expiring.reserve(entries_.size());
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->second.expiresAt != Clock::time_point::max()) expiring.push_back(it);
+    }
+    const std::size_t excess = entries_.size() - opts_.maxEntries + 1;
+    const std::size_t count = std::min(expiring.size(), excess);
+    std::ranges::nth_element(expiring, expiring.begin() + static_cast<std::ptrdiff_t>(count),
+        [](const auto& a, const auto& b) { return a->second.expiresAt < b->second.expiresAt; });
+    for (std::size_t i = 0; i < count; ++i) entries_.erase(expiring[i]);
+}
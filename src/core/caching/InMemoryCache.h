@@ -0,0 +1,40 @@
+#pragma once
+#include "core/caching/interfaces/CacheInterface.h"
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+/// Process-local cache, used until Redis connector lands.
+/// Entries with ttl == 0 (the table generation counter) are never evicted: losing a counter would resurrect stale keys.
+class InMemoryCache final : public CachingInterface {
+public:
+    struct Options {
+        std::size_t maxEntries = 100'000;
+    };
+
+    explicit InMemoryCache(Options options) : opts_(options) {}
+    InMemoryCache() : InMemoryCache(Options{}) {}
+
+    net::awaitable<void> set(std::string key, std::string value, int ttl) override;
+    net::awaitable<std::optional<std::string>> get(std::string key) override;
+    net::awaitable<std::int64_t> increment(std::string key) override;
+
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string value;
+        /// time_point::max() -> no expiry
+        Clock::time_point expiresAt;
+    };
+
+    Options opts_;
+    mutable std::mutex m_;
+    std::unordered_map<std::string, Entry> entries_;
+
+    /// Called under lock when map is full
+    void evict(Clock::time_point now);
+};
@@ -0,0 +1,18 @@
+#include "core/caching/RequestKey.h"
+
+#include <map>
+
+std::string RequestKey::build(const Request& request) {
+    std::string target = request.target();
+    if (const auto pos = target.find('?'); pos != std::string::npos) target.resize(pos);
+
+    std::string key = target + "?";
+    const auto query = request.query();
+    // Parameter order must not split the entry. Decoded names and values may hold '=' or '&':
+    // length prefixes keep ?a=1%26b%3D2 and ?a=1&b=2 apart
+    for (const std::map<std::string, std::string> sorted(query.begin(), query.end()); const auto& [k, v] : sorted) {
+        key += std::to_string(k.size()) + ":" + k + "=" + std::to_string(v.size()) + ":" + v + "&";
+    }
+    key += ":u" + (request.user_id ? std::to_string(*request.user_id) : std::string("-"));
+    return key;
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <string>
+
+#include "core/request/Request.h"
+
+/// Normalized identity of a read: path + sorted length-prefixed query + principal, equal requests -> equal keys
+class RequestKey {
+public:
+    static std::string build(const Request& request);
+};
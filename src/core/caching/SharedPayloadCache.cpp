@@ -0,0 +1,38 @@
+#include "core/caching/SharedPayloadCache.h"
+
+std::optional<SharedPayloadCache::Entry> SharedPayloadCache::get(const std::string& key) {
+    std::lock_guard lk(m_);
+    const auto it = slots_.find(key);
+    if (it == slots_.end()) return std::nullopt;
+
+    if (it->second.expiresAt <= Clock::now()) {
+        slots_.erase(it);
+        return std::nullopt;
+    }
+    return it->second.entry;
+}
+
+void SharedPayloadCache::put(std::string key, Entry entry, const std::chrono::seconds ttl) {
+    const auto now = Clock::now();
+
+    std::lock_guard lk(m_);
+    if (slots_.size() >= opts_.maxEntries && !slots_.contains(key)) {
+        evict(now);
+    }
+    slots_.insert_or_assign(std::move(key), Slot{std::move(entry), now + ttl});
+}
+
+std::size_t SharedPayloadCache::size() const {
+    std::lock_guard lk(m_);
+    return slots_.size();
+}
+
+void SharedPayloadCache::evict(const Clock::time_point now) {
+    // 1) Expired first (old generations die here)
+    std::erase_if(slots_, [now](const auto& kv) { return kv.second.expiresAt <= now; });
+
+    // 2) Still full -> drop arbitrary entries, they are re-filled from CachingInterface
+    for (auto it = slots_.begin(); it != slots_.end() && slots_.size() >= opts_.maxEntries;) {
+        it = slots_.erase(it);
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "core/http/SharedPayload.h"
+
+/// Process-local store of rendered payloads in front of CachingInterface:
+/// a hit costs a refcount increment instead of decoding and copying the body.
+class SharedPayloadCache {
+public:
+    struct Options {
+        std::size_t maxEntries = 1024;
+    };
+
+    struct Entry {
+        unsigned status = 200;
+        std::string etag;
+        std::shared_ptr<const SharedPayload> payload;
+    };
+
+    explicit SharedPayloadCache(Options options) : opts_(options) {}
+    SharedPayloadCache() : SharedPayloadCache(Options{}) {}
+
+    std::optional<Entry> get(const std::string& key);
+    void put(std::string key, Entry entry, std::chrono::seconds ttl);
+
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Slot {
+        Entry entry;
+        Clock::time_point expiresAt;
+    };
+
+    Options opts_;
+    mutable std::mutex m_;
+    std::unordered_map<std::string, Slot> slots_;
+
+    /// Called under lock when map is full
+    void evict(Clock::time_point now);
+};
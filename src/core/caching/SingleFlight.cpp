@@ -0,0 +1,38 @@
+#include "core/caching/SingleFlight.h"
+
+net::awaitable<std::string> SingleFlight::run(std::string key, Loader loader) {
+    co_await net::dispatch(strand_, net::use_awaitable);
+
+    // 1) Somebody is already loading -> join
+    if (const auto it = calls_.find(key); it != calls_.end()) {
+        co_return co_await wait(it->second);
+    }
+
+    // 2) We are the leader
+    auto call = std::make_shared<Call>(strand_);
+    calls_.emplace(key, call);
+
+    try {
+        call->result = co_await loader();
+    } catch (...) {
+        call->error = std::current_exception();
+    }
+
+    co_await net::dispatch(strand_, net::use_awaitable);
+    call->finished = true;
+    calls_.erase(key);
+    call->done.cancel();
+
+    if (call->error) std::rethrow_exception(call->error);
+    co_return *call->result;
+}
+
+net::awaitable<std::string> SingleFlight::wait(std::shared_ptr<Call> call) {
+    while (!call->finished) {
+        boost::system::error_code ec;
+        // operation_aborted is the wake-up signal
+        co_await call->done.async_wait(net::redirect_error(net::use_awaitable, ec));
+    }
+    if (call->error) std::rethrow_exception(call->error);
+    co_return *call->result;
+}
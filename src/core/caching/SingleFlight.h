@@ -0,0 +1,44 @@
+#pragma once
+#include <boost/asio.hpp>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace net = boost::asio;
+
+/// Request coalescing: concurrent callers for the same key await one in-flight loader.
+/// As PgPool, state is serialized through strand_, no mutex needed.
+class SingleFlight {
+public:
+    using Loader = std::function<net::awaitable<std::string>()>;
+
+    explicit SingleFlight(net::any_io_executor executor)
+        : strand_(net::make_strand(std::move(executor))) {}
+
+    /// First caller runs loader, others wait for its result (or its exception)
+    net::awaitable<std::string> run(std::string key, Loader loader);
+
+    /// Keys currently being loaded, read outside of strand -> approximate (stats only)
+    [[nodiscard]] std::size_t inflight() const noexcept { return calls_.size(); }
+
+private:
+    struct Call {
+        explicit Call(const net::strand<net::any_io_executor>& strand) : done(strand) {
+            done.expires_at(net::steady_timer::time_point::max());
+        }
+
+        /// Used as an event: cancel() wakes all waiters
+        net::steady_timer done;
+        std::optional<std::string> result;
+        std::exception_ptr error;
+        bool finished = false;
+    };
+
+    net::strand<net::any_io_executor> strand_;
+    std::unordered_map<std::string, std::shared_ptr<Call>> calls_;
+
+    static net::awaitable<std::string> wait(std::shared_ptr<Call> call);
+};
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <optional>
 #include <boost/asio/awaitable.hpp>
@@ -7,6 +8,9 @@ namespace net = boost::asio;
 
 struct CachingInterface {
   virtual ~CachingInterface() = default;
+  /// ttl in seconds, 0 -> never expires
   virtual net::awaitable<void> set(std::string key, std::string value, int ttl)=0;
   virtual net::awaitable<std::optional<std::string>> get(std::string key)=0;
+  /// Atomic counter (INCR semantics): missing key starts from 0, returns new value, never expires
+  virtual net::awaitable<std::int64_t> increment(std::string key)=0;
 };
@@ -0,0 +1,365 @@
+#include "core/capture/CaptureLog.h"
+#include "core/loggers/LoggerSingleton.h"
+
+#include <algorithm>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <sodium.h>
+#include <stdexcept>
+
+namespace capture {
+    namespace {
+        void putVarint(std::string& out, std::uint64_t value) {
+            while (value >= 0x80) {
+                out += static_cast<char>((value & 0x7f) | 0x80);
+                value >>= 7;
+            }
+            out += static_cast<char>(value);
+        }
+
+        void putString(std::string& out, const std::string_view value) {
+            putVarint(out, value.size());
+            out.append(value);
+        }
+
+        bool iequals(const std::string_view a, const std::string_view b) {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const char x, const char y) {
+                return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+            });
+        }
+
+        bool icontains(const std::string_view hay, const std::string_view needle) {
+            return std::search(hay.begin(), hay.end(), needle.begin(), needle.end(), [](const char x, const char y) {
+                return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+            }) != hay.end();
+        }
+
+        /// name="value" or name=value inside a header value
+        std::string_view headerParam(const std::string_view header, const std::string_view name) {
+            std::size_t pos = 0;
+            while ((pos = header.find(name, pos)) != std::string_view::npos) {
+                const bool atStart = pos == 0 || header[pos - 1] == ' ' || header[pos - 1] == ';';
+                const std::size_t eq = pos + name.size();
+                if (!atStart || eq >= header.size() || header[eq] != '=') {
+                    pos = eq;
+                    continue;
+                }
+                std::size_t from = eq + 1;
+                if (from < header.size() && header[from] == '"') {
+                    const std::size_t to = header.find('"', from + 1);
+                    return header.substr(from + 1, to == std::string_view::npos ? std::string_view::npos : to - from - 1);
+                }
+                const std::size_t to = header.find(';', from);
+                return header.substr(from, to == std::string_view::npos ? std::string_view::npos : to - from);
+            }
+            return {};
+        }
+
+        int hexDigit(const char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        /// Query component as the app reads it: %XX and '+' decoded, malformed escapes kept verbatim
+        std::string percentDecode(const std::string_view value) {
+            std::string out;
+            out.reserve(value.size());
+            for (std::size_t i = 0; i < value.size(); ++i) {
+                if (value[i] == '+') {
+                    out += ' ';
+                } else if (value[i] == '%' && i + 2 < value.size() && hexDigit(value[i + 1]) >= 0 && hexDigit(value[i + 2]) >= 0) {
+                    out += static_cast<char>(hexDigit(value[i + 1]) * 16 + hexDigit(value[i + 2]));
+                    i += 2;
+                } else {
+                    out += value[i];
+                }
+            }
+            return out;
+        }
+
+        void redactJson(nlohmann::json& node, const Redactor& redactor) {
+            if (node.is_object()) {
+                for (auto it = node.begin(); it != node.end(); ++it) {
+                    if (Redactor::sensitiveField(it.key()) && it.value().is_string()) {
+                        it.value() = redactor.pseudonym(it.value().get<std::string>())
+                            + (icontains(it.key(), "email") ? "@example.com" : "");
+                    } else {
+                        redactJson(it.value(), redactor);
+                    }
+                }
+            } else if (node.is_array()) {
+                for (auto& item : node) redactJson(item, redactor);
+            }
+        }
+    }
+
+    void encode(const Record& record, std::string& out) {
+        putVarint(out, record.arrivalUs);
+        putVarint(out, record.durationUs);
+        putVarint(out, record.status);
+        putVarint(out, static_cast<std::uint64_t>(record.method));
+        putString(out, record.target);
+        putVarint(out, record.headers.size());
+        for (const auto& [name, value] : record.headers) {
+            putString(out, name);
+            putString(out, value);
+        }
+        putString(out, record.body);
+    }
+
+    Reader::Reader(const std::string& path) : file_(std::fopen(path.c_str(), "rb")) {
+        if (!file_) throw std::runtime_error("capture: cannot open " + path);
+        char magic[kMagic.size()];
+        if (std::fread(magic, 1, sizeof(magic), file_) != sizeof(magic) || std::string_view(magic, sizeof(magic)) != kMagic) {
+            std::fclose(file_);
+            file_ = nullptr;
+            throw std::runtime_error("capture: " + path + " is not a capture file");
+        }
+    }
+
+    Reader::~Reader() {
+        if (file_) std::fclose(file_);
+    }
+
+    std::uint64_t Reader::varint() {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            const int c = std::fgetc(file_);
+            if (c == EOF) throw std::runtime_error("capture: truncated record");
+            value |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+            if (!(c & 0x80)) return value;
+        }
+        throw std::runtime_error("capture: malformed varint");
+    }
+
+    std::string Reader::string() {
+        const std::uint64_t size = varint();
+        std::string out(size, '\0');
+        if (size && std::fread(out.data(), 1, size, file_) != size) throw std::runtime_error("capture: truncated record");
+        return out;
+    }
+
+    std::optional<Record> Reader::next() {
+        const int c = std::fgetc(file_);
+        if (c == EOF) return std::nullopt;
+        std::ungetc(c, file_);
+
+        Record record;
+        record.arrivalUs = varint();
+        record.durationUs = varint();
+        record.status = static_cast<unsigned>(varint());
+        record.method = static_cast<boost::beast::http::verb>(varint());
+        record.target = string();
+        const std::uint64_t headers = varint();
+        record.headers.reserve(headers);
+        for (std::uint64_t i = 0; i < headers; ++i) {
+            std::string name = string();
+            record.headers.emplace_back(std::move(name), string());
+        }
+        record.body = string();
+        return record;
+    }
+
+    std::optional<std::string> rewriteMultipart(const std::string_view contentType, const std::string_view body, const PartFn& fn) {
+        const std::string_view boundary = headerParam(contentType, "boundary");
+        if (boundary.empty()) return std::nullopt;
+        const std::string delimiter = "--" + std::string(boundary);
+
+        std::size_t pos = body.find(delimiter);
+        if (pos == std::string_view::npos) return std::nullopt;
+
+        std::string out(body.substr(0, pos));
+        for (;;) {
+            const std::size_t afterDelimiter = pos + delimiter.size();
+            // Closing delimiter: keep the epilogue as is
+            if (body.substr(afterDelimiter, 2) == "--") {
+                out.append(body.substr(pos));
+                return out;
+            }
+            const std::size_t headersEnd = body.find("\r\n\r\n", afterDelimiter);
+            const std::size_t nextDelimiter = body.find("\r\n" + delimiter, afterDelimiter);
+            if (headersEnd == std::string_view::npos || nextDelimiter == std::string_view::npos || headersEnd > nextDelimiter) {
+                return std::nullopt;
+            }
+
+            const std::string_view headers = body.substr(afterDelimiter, headersEnd - afterDelimiter);
+            std::string_view disposition;
+            std::size_t lineStart = 0;
+            while (lineStart < headers.size()) {
+                std::size_t lineEnd = headers.find("\r\n", lineStart);
+                if (lineEnd == std::string_view::npos) lineEnd = headers.size();
+                const std::string_view line = headers.substr(lineStart, lineEnd - lineStart);
+                if (line.size() > 20 && iequals(line.substr(0, 20), "content-disposition:")) disposition = line.substr(20);
+                lineStart = lineEnd + 2;
+            }
+
+            std::string content(body.substr(headersEnd + 4, nextDelimiter - headersEnd - 4));
+            fn(headerParam(disposition, "name"), headerParam(disposition, "filename"), content);
+
+            out.append(body.substr(pos, headersEnd + 4 - pos));
+            out.append(content);
+            out.append("\r\n");
+            pos = nextDelimiter + 2;
+        }
+    }
+
+    Redactor::Redactor() {
+        randombytes_buf(key_.data(), key_.size());
+    }
+
+    std::string Redactor::pseudonym(const std::string_view value) const {
+        std::array<unsigned char, 8> digest{};
+        crypto_generichash(
+            digest.data(), digest.size(),
+            reinterpret_cast<const unsigned char*>(value.data()), value.size(),
+            key_.data(), key_.size()
+        );
+        static constexpr char kHex[] = "0123456789abcdef";
+        std::string out = "redacted-";
+        for (const unsigned char byte : digest) {
+            out += kHex[byte >> 4];
+            out += kHex[byte & 0x0f];
+        }
+        return out;
+    }
+
+    bool Redactor::sensitiveHeader(const std::string_view name) {
+        return iequals(name, "authorization") || iequals(name, "proxy-authorization")
+            || iequals(name, "cookie") || iequals(name, "x-api-key");
+    }
+
+    bool Redactor::hopByHopHeader(const std::string_view name) {
+        return iequals(name, "connection") || iequals(name, "keep-alive") || iequals(name, "content-length")
+            || iequals(name, "transfer-encoding") || iequals(name, "te") || iequals(name, "upgrade");
+    }
+
+    bool Redactor::sensitiveField(const std::string_view name) {
+        return icontains(name, "password") || icontains(name, "token") || icontains(name, "secret")
+            || icontains(name, "email") || icontains(name, "username");
+    }
+
+    std::vector<std::pair<std::string, std::string>> Redactor::headers(
+        const std::vector<std::pair<std::string, std::string>>& headers
+    ) const {
+        std::vector<std::pair<std::string, std::string>> out;
+        out.reserve(headers.size());
+        for (const auto& [name, value] : headers) {
+            if (hopByHopHeader(name)) continue;
+            out.emplace_back(name, sensitiveHeader(name) ? std::string(kRedacted) : value);
+        }
+        return out;
+    }
+
+    std::string Redactor::body(const std::string_view contentType, const std::string& body) const {
+        if (body.empty()) return {};
+
+        if (icontains(contentType, "application/json")) {
+            auto document = nlohmann::json::parse(body, nullptr, false);
+            if (!document.is_discarded()) {
+                redactJson(document, *this);
+                return document.dump();
+            }
+        } else if (icontains(contentType, "multipart/form-data")) {
+            auto rewritten = rewriteMultipart(contentType, body, [this](
+                const std::string_view name,
+                const std::string_view filename,
+                std::string& content
+            ) {
+                if (!filename.empty()) {
+                    // Uploads keep their size, replay substitutes a real file
+                    std::ranges::fill(content, '\0');
+                } else if (sensitiveField(name)) {
+                    content = pseudonym(content) + (icontains(name, "email") ? "@example.com" : "");
+                }
+            });
+            if (rewritten) return std::move(*rewritten);
+        }
+        return std::string(body.size(), '\0');
+    }
+
+    std::string Redactor::target(const std::string_view target) const {
+        const std::size_t question = target.find('?');
+        if (question == std::string_view::npos) return std::string(target);
+
+        std::string out(target.substr(0, question + 1));
+        const std::string_view query = target.substr(question + 1);
+        for (std::size_t from = 0; from <= query.size();) {
+            const std::size_t amp = std::min(query.find('&', from), query.size());
+            const std::string_view param = query.substr(from, amp - from);
+            if (from > 0) out += '&';
+            from = amp + 1;
+
+            const std::size_t eq = param.find('=');
+            const std::string name = percentDecode(param.substr(0, eq));
+            if (eq == std::string_view::npos || !sensitiveField(name)) {
+                out += param;
+                continue;
+            }
+
+            out += param.substr(0, eq + 1);
+            const std::string value = percentDecode(param.substr(eq + 1));
+            const std::string_view suffix = icontains(name, "email") ? "@example.com" : "";
+            // __in lists item by item: the same pseudonyms as the single-value filter and the bodies
+            const bool list = name.ends_with("__in");
+            for (std::size_t item = 0; item <= value.size();) {
+                const std::size_t comma = list ? std::min(value.find(',', item), value.size()) : value.size();
+                if (item > 0) out += ',';
+                out += pseudonym(std::string_view(value).substr(item, comma - item));
+                out += suffix;
+                item = comma + 1;
+            }
+        }
+        return out;
+    }
+
+    CaptureWriter::CaptureWriter(Options options)
+        : options_(std::move(options))
+        , startedAt_(std::chrono::steady_clock::now())
+        , file_(std::fopen(options_.path.c_str(), "wb")) {
+        if (!file_) throw std::runtime_error("capture: cannot open " + options_.path);
+        // Large stdio buffer: appends are memcpy under the mutex, the write syscall is rare
+        std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+        std::fwrite(kMagic.data(), 1, kMagic.size(), file_);
+        written_ = kMagic.size();
+    }
+
+    CaptureWriter::~CaptureWriter() {
+        if (file_) std::fclose(file_);
+    }
+
+    bool CaptureWriter::sample() const noexcept {
+        if (full_.load(std::memory_order_relaxed) || options_.sampleRatio <= 0.0) return false;
+        if (options_.sampleRatio >= 1.0) return true;
+        thread_local std::mt19937_64 rng{std::random_device{}()};
+        return std::uniform_real_distribution(0.0, 1.0)(rng) < options_.sampleRatio;
+    }
+
+    std::uint64_t CaptureWriter::elapsedUs() const noexcept {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startedAt_).count()
+        );
+    }
+
+    void CaptureWriter::append(const Record& record) {
+        std::string encoded;
+        encoded.reserve(record.target.size() + record.body.size() + 256);
+        encode(record, encoded);
+
+        const std::lock_guard lock(mutex_);
+        if (full_.load(std::memory_order_relaxed)) return;
+        if (options_.maxBytes && written_ + encoded.size() > options_.maxBytes) {
+            full_.store(true, std::memory_order_relaxed);
+            std::fflush(file_);
+            LoggerSingleton::get().warn("CaptureWriter::append: size limit reached, capture stopped", {
+                {"path", options_.path},
+                {"records", records_.load(std::memory_order_relaxed)}
+            });
+            return;
+        }
+        std::fwrite(encoded.data(), 1, encoded.size(), file_);
+        written_ += encoded.size();
+        records_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
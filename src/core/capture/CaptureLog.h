@@ -0,0 +1,126 @@
+#pragma once
+#include <boost/beast/http/verb.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Sampled production traffic for offline replay (benchmarks/replay).
+///
+/// File: kMagic, then records back to back. Every integer is a LEB128 varint, every string is
+/// varint length + bytes:
+///   arrivalUs durationUs status method target headerCount (name value)* body
+/// Records are appended when the response is ready, so the file is not sorted by arrival.
+namespace capture {
+    inline constexpr std::string_view kMagic = "ACAP1\n";
+    /// Value of headers that were captured but must not be stored (Authorization, Cookie)
+    inline constexpr std::string_view kRedacted = "<redacted>";
+
+    struct Record {
+        /// Since the capture started
+        std::uint64_t arrivalUs = 0;
+        /// As served when captured
+        std::uint64_t durationUs = 0;
+        unsigned status = 0;
+        boost::beast::http::verb method = boost::beast::http::verb::get;
+        std::string target;
+        std::vector<std::pair<std::string, std::string>> headers;
+        std::string body;
+    };
+
+    void encode(const Record& record, std::string& out);
+
+    /// Throws std::runtime_error on a foreign file or a truncated record
+    class Reader {
+    public:
+        explicit Reader(const std::string& path);
+        ~Reader();
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        /// nullopt at the end of the file
+        std::optional<Record> next();
+
+    private:
+        std::FILE* file_ = nullptr;
+
+        std::uint64_t varint();
+        std::string string();
+    };
+
+    /// multipart/form-data walker: fn may rewrite each part's content in place.
+    /// nullopt when the content type has no boundary or the body does not follow it
+    using PartFn = std::function<void(std::string_view name, std::string_view filename, std::string& content)>;
+    std::optional<std::string> rewriteMultipart(std::string_view contentType, std::string_view body, const PartFn& fn);
+
+    /// Keyed BLAKE2b pseudonyms: the same value maps to the same pseudonym within one capture
+    /// (register and login of a user still match on replay), the key is never written anywhere.
+    class Redactor {
+    public:
+        Redactor();
+
+        /// Sensitive headers become kRedacted, hop-by-hop ones are dropped
+        [[nodiscard]] std::vector<std::pair<std::string, std::string>> headers(
+            const std::vector<std::pair<std::string, std::string>>& headers
+        ) const;
+        /// JSON: sensitive keys pseudonymized at any depth. multipart: sensitive fields pseudonymized,
+        /// file contents replaced by filler of the same size. Anything else: same size filler
+        [[nodiscard]] std::string body(std::string_view contentType, const std::string& body) const;
+        /// Query parameters with sensitive names (email, username__in, ...) pseudonymized like body fields,
+        /// item by item for comma-separated __in lists; the path and other parameters are kept as sent
+        [[nodiscard]] std::string target(std::string_view target) const;
+
+        [[nodiscard]] std::string pseudonym(std::string_view value) const;
+
+        static bool sensitiveHeader(std::string_view name);
+        static bool hopByHopHeader(std::string_view name);
+        static bool sensitiveField(std::string_view name);
+
+    private:
+        std::array<unsigned char, 32> key_{};
+    };
+
+    /// Appends sampled records to one file, shared by every I/O thread
+    class CaptureWriter {
+    public:
+        struct Options {
+            std::string path;
+            /// Share of requests captured, 0..1
+            double sampleRatio = 1.0;
+            /// Capture stops at this file size, 0 -> unbounded
+            std::uint64_t maxBytes = 256ull * 1024 * 1024;
+        };
+
+        /// Throws std::runtime_error when the file cannot be opened
+        explicit CaptureWriter(Options options);
+        ~CaptureWriter();
+        CaptureWriter(const CaptureWriter&) = delete;
+        CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+        /// Lock-free sampling decision, false once the size limit was hit
+        [[nodiscard]] bool sample() const noexcept;
+        [[nodiscard]] std::uint64_t elapsedUs() const noexcept;
+        [[nodiscard]] const Redactor& redactor() const noexcept { return redactor_; }
+
+        void append(const Record& record);
+
+        [[nodiscard]] std::uint64_t records() const noexcept { return records_.load(std::memory_order_relaxed); }
+
+    private:
+        Options options_;
+        Redactor redactor_;
+        std::chrono::steady_clock::time_point startedAt_;
+        std::FILE* file_ = nullptr;
+        std::mutex mutex_;
+        std::uint64_t written_ = 0;
+        std::atomic<bool> full_{false};
+        std::atomic<std::uint64_t> records_{0};
+    };
+}
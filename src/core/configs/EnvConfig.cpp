@@ -1,5 +1,7 @@
 #include "core/configs/EnvConfig.h"
+#include <algorithm>
 #include <stdexcept>
+#include <string_view>
 
 static std::string getEnvOrDefault(const char* key, const std::string& default_ = "") 
 {
@@ -21,14 +23,44 @@ static uint16_t getEnvOrDefaultUint16(const char* key, const uint16_t default_)
     return default_;
 };
 
-static uint64_t getEnvOrDefaultUint64(const char* key, const uint32_t default_)
+static uint64_t getEnvOrDefaultUint64(const char* key, const uint64_t default_)
 {
     if (const char* value = std::getenv(key)){
+        // stoull accepts "-1" as 2^64 - 1 and stops at the first non-digit
+        std::size_t used = 0;
+        uint64_t parsed = 0;
         try {
-            return static_cast<uint64_t>(std::stoi(value));
+            parsed = std::stoull(value, &used);
         } catch (...) {
+            used = 0;
+        }
+        if (used == 0 || value[used] != '\0' || std::string_view(value).find('-') != std::string_view::npos) {
             throw std::runtime_error(std::string("Invalid integer for env variable: ") + key);
         }
+        return parsed;
+    }
+    return default_;
+};
+
+/// Cache ttls are int seconds and get added up (ttl + stale windows, generation ttl): capped at a year
+static int getEnvOrDefaultTtl(const char* key, const int default_)
+{
+    constexpr uint64_t kMaxTtlSeconds = 365ull * 24 * 3600;
+    const uint64_t value = getEnvOrDefaultUint64(key, static_cast<uint64_t>(default_));
+    if (value > kMaxTtlSeconds) {
+        throw std::runtime_error(std::string("Out of range (max 31536000 seconds) env variable: ") + key);
+    }
+    return static_cast<int>(value);
+};
+
+static double getEnvOrDefaultDouble(const char* key, const double default_)
+{
+    if (const char* value = std::getenv(key)){
+        try {
+            return std::stod(value);
+        } catch (...) {
+            throw std::runtime_error(std::string("Invalid number for env variable: ") + key);
+        }
     }
     return default_;
 };
@@ -38,14 +70,54 @@ EnvConfig EnvConfig::load()
     EnvConfig config;
     config.host                   = getEnvOrDefault("APP_HOST", "0.0.0.0");
     config.port                   = getEnvOrDefaultUint16("APP_PORT", 8080);
+    config.http_pipeline_depth    = std::max<std::uint64_t>(1, getEnvOrDefaultUint64("HTTP_PIPELINE_DEPTH", 1));
+    config.http_pipeline_max_bytes = getEnvOrDefaultUint64("HTTP_PIPELINE_MAX_BYTES", 4 * 1024 * 1024);
+    config.db_driver              = getEnvOrDefault("DATABASE_DRIVER", "postgres");
     config.pg_dsn                 = getEnvOrDefault("DATABASE_DSN");
+    config.pg_query_timeout_ms    = getEnvOrDefaultUint64("PG_QUERY_TIMEOUT_MS", 5000);
+    config.pg_slow_query_ms       = getEnvOrDefaultUint64("PG_SLOW_QUERY_MS", 200);
+    config.pg_explain_sample      = getEnvOrDefaultUint64("PG_EXPLAIN_SAMPLE", 0);
+    config.fake_db_latency_us     = getEnvOrDefaultUint64("FAKE_DB_LATENCY_US", 0);
+    config.fake_db_latency_dist   = getEnvOrDefault("FAKE_DB_LATENCY_DIST", "fixed");
+    config.fake_db_error_rate     = getEnvOrDefaultDouble("FAKE_DB_ERROR_RATE", 0.0);
+    config.fake_db_error          = getEnvOrDefault("FAKE_DB_ERROR", "unavailable");
+    config.fake_db_rows           = getEnvOrDefaultUint64("FAKE_DB_ROWS", 20);
+    config.fake_db_password       = getEnvOrDefault("FAKE_DB_PASSWORD", "Passw0rd!");
     config.redis_host             = getEnvOrDefault("REDIS_HOST", "127.0.0.1");
     config.redis_port             = getEnvOrDefaultUint16("REDIS_PORT", 6379);
     config.redis_password         = getEnvOrDefault("REDIS_PASSWORD", "");
+    config.cache_ttl              = getEnvOrDefaultTtl("CACHE_TTL", 30);
+    config.cache_stale_while_revalidate = getEnvOrDefaultTtl("CACHE_STALE_WHILE_REVALIDATE", 0);
+    config.cache_stale_if_error   = getEnvOrDefaultTtl("CACHE_STALE_IF_ERROR", 60);
+    config.response_cache_ttl     = getEnvOrDefaultTtl("RESPONSE_CACHE_TTL", 30);
     config.secret_key             = getEnvOrDefault("SECRET_KEY", "");
     config.multipart_adapter      = getEnvOrDefault("MULTIPART_ADAPTER", "POCO");
     config.file_upload_limit_size = getEnvOrDefaultUint64("FILE_UPLOAD_LIMIT_SIZE", 0);
     config.media_path              = getEnvOrDefault("MEDIA_PATH", "media");
+    config.log_driver             = getEnvOrDefault("LOG_DRIVER", "async");
+    config.log_level              = getEnvOrDefault("LOG_LEVEL", "info");
+    config.log_sink               = getEnvOrDefault("LOG_SINK", "stderr");
+    config.log_file               = getEnvOrDefault("LOG_FILE", "app.log");
+    config.log_file_max_bytes     = getEnvOrDefaultUint64("LOG_FILE_MAX_BYTES", 64 * 1024 * 1024);
+    config.log_file_max_files     = getEnvOrDefaultUint64("LOG_FILE_MAX_FILES", 5);
+    config.log_overflow           = getEnvOrDefault("LOG_OVERFLOW", "drop");
+    config.log_ring_capacity      = getEnvOrDefaultUint64("LOG_RING_CAPACITY", 8192);
+    config.log_rate_limit         = getEnvOrDefaultUint16("LOG_RATE_LIMIT", 0);
+    config.log_rate_burst         = getEnvOrDefaultUint16("LOG_RATE_BURST", 50);
+    config.log_rate_limit_errors  = getEnvOrDefault("LOG_RATE_LIMIT_ERRORS", "false") == "true";
+    config.log_info_sample        = getEnvOrDefaultUint16("LOG_INFO_SAMPLE", 1);
+    config.trace_exporter         = getEnvOrDefault("TRACE_EXPORTER", "none");
+    config.trace_dir              = getEnvOrDefault("TRACE_DIR", "traces");
+    config.trace_sample_ratio     = getEnvOrDefaultDouble("TRACE_SAMPLE_RATIO", 1.0);
+    config.request_timing         = getEnvOrDefault("REQUEST_TIMING", "metrics");
+    config.loop_lag_interval_ms   = getEnvOrDefaultUint16("LOOP_LAG_INTERVAL_MS", 100);
+    config.loop_stall_threshold_ms = getEnvOrDefaultUint16("LOOP_STALL_THRESHOLD_MS", 200);
+    config.loop_stall_stacks      = getEnvOrDefault("LOOP_STALL_STACKS", "true") == "true";
+    config.metrics_token          = getEnvOrDefault("METRICS_TOKEN", "");
+    config.profiler_enabled       = getEnvOrDefault("PROFILER_ENABLED", "false") == "true";
+    config.capture_path           = getEnvOrDefault("CAPTURE_PATH", "");
+    config.capture_sample         = getEnvOrDefaultDouble("CAPTURE_SAMPLE", 1.0);
+    config.capture_max_mb         = getEnvOrDefaultUint64("CAPTURE_MAX_MB", 256);
 
     return config;
 }
@@ -5,15 +5,88 @@
 struct EnvConfig {
     std::string host = "0.0.0.0";
     uint16_t port = 8080;
+    /// Requests read ahead on a connection while earlier ones are served (responses keep their order), 1 disables
+    std::size_t http_pipeline_depth = 1;
+    /// Request and response bodies a connection holds for its pipeline before it stops reading ahead
+    uint64_t http_pipeline_max_bytes = 4ull * 1024 * 1024;
+    /// postgres | fake (in-memory FakePgPool, benchmarks without a database)
+    std::string db_driver = "postgres";
     std::string pg_dsn;
     std::size_t pg_pool_size = 10;
+    /// PgPool::query without an explicit timeout
+    uint64_t pg_query_timeout_ms = 5000;
+    /// Statements at or over this are logged as slow queries, 0 disables
+    uint64_t pg_slow_query_ms = 200;
+    /// EXPLAIN (ANALYZE, BUFFERS) 1 of N slow SELECTs on a dedicated connection, 0 disables
+    uint64_t pg_explain_sample = 0;
+    /// FakePgPool: mean statement latency, fixed | uniform | exponential | lognormal
+    uint64_t fake_db_latency_us = 0;
+    std::string fake_db_latency_dist = "fixed";
+    /// FakePgPool: share of failing statements, unavailable (503 path) | unique (409/422 path)
+    double fake_db_error_rate = 0.0;
+    std::string fake_db_error = "unavailable";
+    /// FakePgPool: rows of a list without limit; every fake user has fake_db_password
+    std::size_t fake_db_rows = 20;
+    std::string fake_db_password = "Passw0rd!";
     std::string redis_host;
     uint16_t redis_port = 6379;
     std::string redis_password;
+    /// Seconds, 0 disables repository caching
+    int cache_ttl = 30;
+    /// Seconds an expired entry may be served while it is refreshed in background, 0 disables
+    int cache_stale_while_revalidate = 0;
+    /// Seconds an expired entry may be served while the database is unavailable, 0 disables
+    int cache_stale_if_error = 60;
+    /// Seconds, rendered GET responses with ETag, 0 disables
+    int response_cache_ttl = 30;
     std::string secret_key;
     uint64_t file_upload_limit_size;
     std::string multipart_adapter;
     std::string media_path;
+    /// console (synchronous) | async (per-thread rings, background writer)
+    std::string log_driver = "async";
+    /// debug | info | warn | error, runtime threshold
+    std::string log_level = "info";
+    /// stderr | file, async driver only
+    std::string log_sink = "stderr";
+    std::string log_file = "app.log";
+    /// Rotation threshold, 0 disables rotation
+    uint64_t log_file_max_bytes = 64ull * 1024 * 1024;
+    std::size_t log_file_max_files = 5;
+    /// drop | block | sample, what a thread does when its ring is full
+    std::string log_overflow = "drop";
+    /// Records per thread ring
+    std::size_t log_ring_capacity = 8192;
+    /// Lines per second per call site after the burst, 0 disables rate limiting
+    uint32_t log_rate_limit = 0;
+    uint32_t log_rate_burst = 50;
+    /// ERROR lines are rate limited as well, off: they always pass
+    bool log_rate_limit_errors = false;
+    /// Keep 1 of N info/debug lines per call site, 1 keeps all
+    uint32_t log_info_sample = 1;
+    /// none | chrome | otlp, span files written to trace_dir
+    std::string trace_exporter = "none";
+    std::string trace_dir = "traces";
+    /// Share of new traces recorded, incoming traceparent keeps the caller's decision
+    double trace_sample_ratio = 1.0;
+    /// off | metrics | header, per-phase and on-CPU request timings (header adds Server-Timing)
+    std::string request_timing = "metrics";
+    /// Event-loop lag probe period
+    uint32_t loop_lag_interval_ms = 100;
+    /// Probe overdue by this much -> stall warning, 0 disables the watchdog
+    uint32_t loop_stall_threshold_ms = 200;
+    /// Log the I/O thread stack on a stall
+    bool loop_stall_stacks = true;
+    /// Bearer token required by GET /metrics, empty leaves it open (bind APP_HOST or firewall the port then)
+    std::string metrics_token;
+    /// GET /debug/pprof/profile (authenticated), off in production unless needed
+    bool profiler_enabled = false;
+    /// Sampled, redacted request capture for benchmarks/replay, empty disables
+    std::string capture_path;
+    /// Share of requests captured, 0..1
+    double capture_sample = 1.0;
+    /// Capture stops at this file size, 0 -> unbounded
+    uint64_t capture_max_mb = 256;
 
     static EnvConfig load();
 };
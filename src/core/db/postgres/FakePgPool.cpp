@@ -0,0 +1,326 @@
+#include "core/db/postgres/interfaces/FakePgPool.h"
+
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <stdexcept>
+
+#include "core/errors/Errors.h"
+#include "core/tracing/RequestTimings.h"
+#include "core/tracing/Span.h"
+
+namespace {
+    constexpr std::string_view kTimestamp = "2025-01-01 00:00:00+00";
+    const std::vector<std::string> kUserColumns{ "id", "username", "picture", "email", "created_at", "updated_at" };
+
+    std::mt19937_64& rng() {
+        thread_local std::mt19937_64 engine{std::random_device{}()};
+        return engine;
+    }
+
+    /// "$3" right after keyword -> index 2
+    std::optional<std::size_t> placeholderAfter(const std::string_view sql, const std::string_view keyword) {
+        const std::size_t at = sql.find(keyword);
+        if (at == std::string_view::npos) return std::nullopt;
+        std::size_t pos = at + keyword.size();
+        std::size_t number = 0;
+        bool digits = false;
+        while (pos < sql.size() && std::isdigit(static_cast<unsigned char>(sql[pos]))) {
+            number = number * 10 + static_cast<std::size_t>(sql[pos++] - '0');
+            digits = true;
+        }
+        if (!digits || number == 0) return std::nullopt;
+        return number - 1;
+    }
+
+    const std::string* paramAt(
+        const std::vector<std::optional<std::string>>& params,
+        const std::optional<std::size_t> index
+    ) {
+        if (!index || *index >= params.size() || !params[*index]) return nullptr;
+        return &*params[*index];
+    }
+
+    std::optional<std::int64_t> toNumber(const std::string* value) {
+        if (!value) return std::nullopt;
+        try {
+            return std::stoll(*value);
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    }
+
+    /// WHERE a = $1 AND b = $2 -> {a, params[0]}, {b, params[1]}
+    std::vector<std::pair<std::string, std::string>> equalityFilters(
+        const std::string_view sql,
+        const std::vector<std::optional<std::string>>& params
+    ) {
+        std::vector<std::pair<std::string, std::string>> filters;
+        const std::size_t where = sql.find(" WHERE ");
+        if (where == std::string_view::npos) return filters;
+        constexpr std::string_view kEquals = " = $";
+        std::size_t pos = where;
+        while ((pos = sql.find(kEquals, pos)) != std::string_view::npos) {
+            const std::size_t nameStart = sql.rfind(' ', pos - 1) + 1;
+            const std::string_view name = sql.substr(nameStart, pos - nameStart);
+            if (const std::string* value = paramAt(params, placeholderAfter(sql.substr(pos), kEquals))) {
+                filters.emplace_back(std::string(name), *value);
+            }
+            pos += kEquals.size();
+        }
+        return filters;
+    }
+
+    /// id = ANY($1::bigint[]) with "{1,2,3}"
+    std::vector<std::int64_t> anyIds(const std::string_view sql, const std::vector<std::optional<std::string>>& params) {
+        std::vector<std::int64_t> ids;
+        const std::string* array = paramAt(params, placeholderAfter(sql, "id = ANY($"));
+        if (!array) return ids;
+        std::size_t pos = 0;
+        while (pos < array->size()) {
+            const std::size_t end = std::min(array->find(',', pos), array->size());
+            std::string item = array->substr(pos, end - pos);
+            std::erase_if(item, [](const char c) { return c == '{' || c == '}' || c == ' '; });
+            if (const auto id = toNumber(&item)) ids.push_back(*id);
+            pos = end + 1;
+        }
+        return ids;
+    }
+
+    std::vector<std::string> splitColumns(const std::string_view list) {
+        std::vector<std::string> columns;
+        std::size_t pos = 0;
+        while (pos <= list.size()) {
+            const std::size_t end = std::min(list.find(',', pos), list.size());
+            columns.emplace_back(list.substr(pos, end - pos));
+            pos = end + 1;
+        }
+        return columns;
+    }
+
+    const std::vector<std::optional<std::string>> kNoParams;
+
+    class FakePgConnection final : public PgConnectionInterface {
+    public:
+        explicit FakePgConnection(FakePgPool& pool) : pool_(pool) {}
+
+        net::awaitable<PgResult> execParams(
+            std::string sql,
+            const std::vector<std::optional<std::string>>& params,
+            const std::chrono::steady_clock::duration timeout
+        ) override {
+            co_return co_await pool_.respond(sql, params, timeout);
+        }
+
+        net::awaitable<PgResult> execPrepared(
+            std::string_view,
+            const std::string_view sqlIfPrepareNeeded,
+            const std::vector<std::optional<std::string>>& params,
+            const std::chrono::steady_clock::duration timeout
+        ) override {
+            const std::string sql(sqlIfPrepareNeeded);
+            co_return co_await pool_.respond(sql, params, timeout);
+        }
+
+        net::awaitable<void> begin(const std::chrono::steady_clock::duration timeout) override {
+            const std::string sql = "BEGIN";
+            (void)co_await pool_.respond(sql, kNoParams, timeout);
+        }
+
+        net::awaitable<void> commit(const std::chrono::steady_clock::duration timeout) override {
+            const std::string sql = "COMMIT";
+            (void)co_await pool_.respond(sql, kNoParams, timeout);
+        }
+
+        net::awaitable<void> rollback(const std::chrono::steady_clock::duration timeout) override {
+            const std::string sql = "ROLLBACK";
+            (void)co_await pool_.respond(sql, kNoParams, timeout);
+        }
+
+        [[nodiscard]] bool healthy() const noexcept override { return true; }
+
+    private:
+        FakePgPool& pool_;
+    };
+} // namespace
+
+FakePgPool::FakePgPool(Options options) : options_(std::move(options)) {}
+
+FakePgPool::Latency FakePgPool::parseLatency(const std::string_view name) {
+    return LatencyDistribution::parse(name);
+}
+
+FakePgPool::Failure FakePgPool::parseFailure(const std::string_view name) {
+    if (name == "unique") return Failure::UniqueViolation;
+    return Failure::Unavailable;
+}
+
+void FakePgPool::when(std::string sqlFragment, PgResult result) {
+    rules_.emplace_back(std::move(sqlFragment), [result = std::move(result)](
+        const std::string&,
+        const std::vector<std::optional<std::string>>&
+    ) {
+        return result;
+    });
+}
+
+void FakePgPool::when(std::string sqlFragment, Responder responder) {
+    rules_.emplace_back(std::move(sqlFragment), std::move(responder));
+}
+
+net::awaitable<PgPoolInterface::Lease> FakePgPool::acquire() {
+    inflight_.fetch_add(1, std::memory_order_relaxed);
+    auto released = std::make_shared<std::atomic<bool>>(false);
+    co_return Lease{
+        .connection = std::make_shared<FakePgConnection>(*this),
+        .release = [this, released]() {
+            if (!released->exchange(true)) inflight_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    };
+}
+
+void FakePgPool::shutdown() {}
+
+net::awaitable<PgResult> FakePgPool::query(
+    const std::string& sql,
+    const std::vector<std::optional<std::string>>& params,
+    const std::chrono::steady_clock::duration timeout
+) {
+    // Same span and phase as PgPool::query: traces and Server-Timing keep their shape
+    trace::Span span("pg.query", trace::SpanKind::Client);
+    span.setAttribute("db.statement", sql);
+    trace::PhaseTimer queryTimer(trace::Phase::DbQuery);
+    // A query holds a connection of the real pool for its whole duration
+    struct InFlight {
+        std::atomic<std::size_t>& count;
+        explicit InFlight(std::atomic<std::size_t>& c) : count(c) { count.fetch_add(1, std::memory_order_relaxed); }
+        ~InFlight() { count.fetch_sub(1, std::memory_order_relaxed); }
+    } inFlight(inflight_);
+    co_return co_await respond(sql, params, timeout);
+}
+
+net::awaitable<PgResult> FakePgPool::query(
+    const std::string& sql,
+    const std::vector<std::optional<std::string>>& params
+) {
+    co_return co_await query(sql, params, options_.defaultTimeout);
+}
+
+PgPoolInterface::Stats FakePgPool::stats() const noexcept {
+    Stats stats;
+    stats.size = options_.size;
+    stats.open = options_.size;
+    stats.leased = std::min(inflight_.load(std::memory_order_relaxed), options_.size);
+    stats.idle = stats.open - stats.leased;
+    return stats;
+}
+
+std::chrono::steady_clock::duration FakePgPool::sampleLatency() const {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        LatencyDistribution::sample(options_.latency, options_.meanLatency)
+    );
+}
+
+bool FakePgPool::sampleFailure() const {
+    if (options_.errorRate <= 0.0) return false;
+    return std::bernoulli_distribution(std::min(options_.errorRate, 1.0))(rng());
+}
+
+net::awaitable<PgResult> FakePgPool::respond(
+    const std::string& sql,
+    const std::vector<std::optional<std::string>>& params,
+    const std::chrono::steady_clock::duration timeout
+) {
+    statements_.fetch_add(1, std::memory_order_relaxed);
+
+    const auto latency = sampleLatency();
+    const bool timedOut = timeout > std::chrono::steady_clock::duration::zero() && latency > timeout;
+    if (latency > std::chrono::steady_clock::duration::zero()) {
+        net::steady_timer timer(co_await net::this_coro::executor);
+        timer.expires_after(timedOut ? timeout : latency);
+        co_await timer.async_wait(net::use_awaitable);
+    }
+    if (timedOut) throw DbUnavailableError("fake: statement timeout");
+
+    if (sampleFailure()) {
+        if (options_.failure == Failure::UniqueViolation) {
+            throw DbError(DbErrorCode::UniqueViolation, "fake: duplicate key value violates unique constraint");
+        }
+        throw DbUnavailableError("fake: injected failure");
+    }
+
+    for (const auto& [fragment, responder] : rules_) {
+        if (sql.find(fragment) != std::string::npos) co_return responder(sql, params);
+    }
+    co_return synthesize(sql, params);
+}
+
+PgResult FakePgPool::synthesize(const std::string& sql, const std::vector<std::optional<std::string>>& params) const {
+    PgResult result;
+    const auto filters = equalityFilters(sql, params);
+
+    // Same rows the SELECT below would synthesize: a `col = $n` filter matches one, no filter matches none
+    if (sql.starts_with("SELECT EXISTS(")) {
+        result.columns_names = {"exists"};
+        result.rows.push_back(PgRow{{PgValue{filters.empty() ? "f" : "t"}}});
+        return result;
+    }
+
+    const auto filtered = [&filters](const std::string_view name) -> const std::string* {
+        const auto it = std::ranges::find_if(filters, [name](const auto& f) { return f.first == name; });
+        return it == filters.end() ? nullptr : &it->second;
+    };
+    const auto value = [this, &filtered](const std::string& column, const std::int64_t id) -> PgValue {
+        if (const std::string* v = filtered(column)) return PgValue{*v};
+        if (column == "id") return PgValue{std::to_string(id)};
+        if (column == "username") return PgValue{"user" + std::to_string(id)};
+        if (column == "email") return PgValue{"user" + std::to_string(id) + "@example.com"};
+        if (column == "picture") return PgValue{"", true};
+        if (column == "created_at" || column == "updated_at") return PgValue{std::string(kTimestamp)};
+        if (column == "password") return PgValue{options_.passwordHash};
+        return PgValue{"1"};
+    };
+
+    if (sql.starts_with("SELECT ")) {
+        const std::string_view view = sql;
+        const std::size_t from = view.find(" FROM ");
+        const std::string_view list = view.substr(7, from == std::string_view::npos ? std::string_view::npos : from - 7);
+        result.columns_names = list == "*" ? kUserColumns : splitColumns(list);
+
+        std::vector<std::int64_t> ids = anyIds(view, params);
+        if (const auto id = toNumber(filtered("id"))) ids = {*id};
+        if (ids.empty()) {
+            std::size_t count = options_.rows;
+            if (const auto limit = toNumber(paramAt(params, placeholderAfter(view, " LIMIT $")))) {
+                count = static_cast<std::size_t>(std::max<std::int64_t>(0, *limit));
+            }
+            // Unique columns match at most one row
+            if (filtered("email") || filtered("username")) count = std::min<std::size_t>(count, 1);
+            const std::int64_t offset = toNumber(paramAt(params, placeholderAfter(view, " OFFSET $"))).value_or(0);
+            for (std::size_t i = 0; i < count; ++i) ids.push_back(offset + static_cast<std::int64_t>(i) + 1);
+        }
+
+        result.rows.reserve(ids.size());
+        for (const std::int64_t id : ids) {
+            PgRow row;
+            row.columns.reserve(result.columns_names.size());
+            for (const auto& column : result.columns_names) row.columns.push_back(value(column, id));
+            result.rows.push_back(std::move(row));
+        }
+        return result;
+    }
+
+    if (const std::size_t returning = sql.find(" RETURNING "); returning != std::string::npos) {
+        const std::string column = sql.substr(returning + 11);
+        // Only a fresh row takes an id from the sequence
+        std::int64_t id;
+        if (const auto filteredId = toNumber(filtered("id"))) {
+            id = *filteredId;
+        } else {
+            id = nextId_.fetch_add(1, std::memory_order_relaxed);
+        }
+        result.columns_names = {column};
+        result.rows.push_back(PgRow{{value(column, id)}});
+    }
+    return result;
+}
@@ -1,9 +1,15 @@
 #include "core/db/postgres/interfaces/PgConnection.h"
+#include "core/db/postgres/interfaces/SlowQueryLog.h"
 #include "core/errors/Errors.h"
 
 #include <boost/asio/steady_timer.hpp>
 #include <boost/system/error_code.hpp>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <stdexcept>
+#include <system_error>
+#include <thread>
 #include <unordered_set>
 
 namespace {
@@ -30,11 +36,72 @@ namespace {
             || msg_contains(err, "invalid prepared statement")
             || msg_contains(err, "invalid_sql_statement_name");
     }
+
+    /// PQcancel connects and waits for the server on a new socket: on a stalled network that is
+    /// as stuck as the query itself, so requests go to one background thread instead of the I/O thread.
+    /// The queue is bounded, cancels beyond it are dropped: the connection is closed anyway.
+    class CancelQueue {
+    public:
+        static CancelQueue& instance() {
+            // Leaked on purpose: the worker may be stuck in PQcancel at exit, nothing to join
+            static auto* queue = new CancelQueue();
+            return *queue;
+        }
+
+        void push(PGcancel* cancel) noexcept {
+            {
+                std::lock_guard lk(mutex_);
+                if (pending_.size() < kMaxPending && startWorker()) {
+                    pending_.push_back(cancel);
+                    cancel = nullptr;
+                }
+            }
+            if (cancel) {
+                PQfreeCancel(cancel);
+                return;
+            }
+            cv_.notify_one();
+        }
+
+    private:
+        static constexpr std::size_t kMaxPending = 64;
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<PGcancel*> pending_;
+        bool started_ = false;
+
+        /// Under mutex_, false when the thread cannot be created
+        bool startWorker() noexcept {
+            if (started_) return true;
+            try {
+                std::thread([this] { run(); }).detach();
+                started_ = true;
+            } catch (const std::system_error&) {}
+            return started_;
+        }
+
+        void run() {
+            for (;;) {
+                PGcancel* cancel;
+                {
+                    std::unique_lock lk(mutex_);
+                    cv_.wait(lk, [this] { return !pending_.empty(); });
+                    cancel = pending_.front();
+                    pending_.pop_front();
+                }
+                char errbuf[256] = {0};
+                (void)PQcancel(cancel, errbuf, sizeof(errbuf)); // best-effort
+                PQfreeCancel(cancel);
+            }
+        }
+    };
 } // namespace
 
-PgConnection::PgConnection(net::any_io_executor executor, std::string dsn) 
+PgConnection::PgConnection(net::any_io_executor executor, std::string dsn, std::shared_ptr<SlowQueryLog> slowLog)
     : executor_(std::move(executor)), 
-      dsn_(std::move(dsn)) {}
+      dsn_(std::move(dsn)),
+      slowLog_(std::move(slowLog)) {}
 
 PgConnection::~PgConnection() { close(); }
 
@@ -176,7 +243,7 @@ net::awaitable<PgResult> PgConnection::execParams(
         );
     };
 
-    co_return co_await runQueryWithTimeout(send, timeout);
+    co_return co_await runQueryWithTimeout(send, timeout, sql, params);
 }
 
 net::awaitable<PgResult> PgConnection::execPrepared(
@@ -205,7 +272,7 @@ net::awaitable<PgResult> PgConnection::execPrepared(
         };
 
         try {
-            (void)co_await runQueryWithTimeout(send_prepare, timeout);
+            (void)co_await runQueryWithTimeout(send_prepare, timeout, {}, {});
             prepared_.insert(name);
             co_return;
         } catch (const std::exception& e) {
@@ -261,7 +328,7 @@ net::awaitable<PgResult> PgConnection::execPrepared(
     PgResult result;
 
     try {
-        result = co_await runQueryWithTimeout(send_exec, timeout);
+        result = co_await runQueryWithTimeout(send_exec, timeout, sql_if_needed, params);
     } catch (const std::exception& e) {
         if (is_invalid_prepared_stmt_error(e.what())) {
             retry_needed = true;
@@ -273,7 +340,7 @@ net::awaitable<PgResult> PgConnection::execPrepared(
     if (retry_needed) {
         prepared_.erase(name);
         co_await do_prepare(); 
-        co_return co_await runQueryWithTimeout(send_exec, timeout);
+        co_return co_await runQueryWithTimeout(send_exec, timeout, sql_if_needed, params);
     }
 
     co_return result;
@@ -301,11 +368,7 @@ void PgConnection::close() {
 
 void PgConnection::cancel() const noexcept {
     if (!conn_) return;
-    char errbuf[256] = {0};
-    if (auto* c = PQgetCancel(conn_)) {
-        (void)PQcancel(c, errbuf, sizeof(errbuf)); // best-effort
-        PQfreeCancel(c);
-    }
+    if (auto* c = PQgetCancel(conn_)) CancelQueue::instance().push(c);
 }
 
 net::awaitable<void> PgConnection::wait_readable(const std::chrono::steady_clock::time_point deadline) {
@@ -376,9 +439,12 @@ net::awaitable<void> PgConnection::wait_writable(const std::chrono::steady_clock
 
 net::awaitable<PgResult> PgConnection::runQueryWithTimeout(
     const std::function<int()> sendFn,
-    const std::chrono::steady_clock::duration timeout
+    const std::chrono::steady_clock::duration timeout,
+    const std::string_view sql,
+    const std::vector<std::optional<std::string>>& params
 ) {
-    auto deadline = std::chrono::steady_clock::now() + timeout;
+    const auto startedAt = std::chrono::steady_clock::now();
+    auto deadline = startedAt + timeout;
 
     try {
         // Send
@@ -447,12 +513,35 @@ net::awaitable<PgResult> PgConnection::runQueryWithTimeout(
 
         if (!have_result) {
             // Shouldn't normally happen, but return empty set
-            co_return PgResult{};
+            out = {};
         }
+        report(sql, params, startedAt, out.rows.size(), nullptr);
         co_return out;
+    } catch (const DbError& e) {
+        // The server has already ended the statement, nothing to cancel
+        report(sql, params, startedAt, 0, e.what());
+        close();
+        throw;
+    } catch (const std::exception& e) {
+        // Timeouts are the slowest queries of all, they are reported as well
+        report(sql, params, startedAt, 0, e.what());
+        cancel();
+        close();
+        throw;
     } catch (...) {
         cancel();
         close();
         throw;
     }
 }
+
+void PgConnection::report(
+    const std::string_view sql,
+    const std::vector<std::optional<std::string>>& params,
+    const std::chrono::steady_clock::time_point startedAt,
+    const std::size_t rows,
+    const char* error
+) const {
+    if (!slowLog_ || sql.empty()) return;
+    slowLog_->observe(sql, params, std::chrono::steady_clock::now() - startedAt, leaseWait_, rows, error);
+}
@@ -6,18 +6,61 @@
 #include <stdexcept>
 
 #include "core/errors/Errors.h"
+#include "core/tracing/RequestTimings.h"
+#include "core/tracing/Span.h"
 
 namespace net = boost::asio;
 
-PgPool::PgPool(net::any_io_executor executor, std::string dsn, const std::size_t size)
+PgPool::PgPool(
+    net::any_io_executor executor,
+    std::string dsn,
+    const std::size_t size,
+    const std::size_t saturationWaiters
+)
     : executor_(std::move(executor))
     , strand_(net::make_strand(executor_))
     , dsn_(std::move(dsn))
     , size_(size)
-    , channel_(strand_, /*capacity*/ static_cast<unsigned>(size ? size : 1)) {}
+    , channel_(strand_, /*capacity*/ static_cast<unsigned>(size ? size : 1))
+    , saturationWaiters_(saturationWaiters ? saturationWaiters : 2 * (size ? size : 1)) {}
+
+bool PgPool::degraded() const noexcept {
+    const std::int64_t openUntil = breakerOpenUntil_.load(std::memory_order_relaxed);
+    // Past open_until the next caller becomes the half-open probe, so we are not degraded anymore
+    if (openUntil != 0 && std::chrono::steady_clock::now().time_since_epoch().count() < openUntil) return true;
+    return waiting_.load(std::memory_order_relaxed) >= saturationWaiters_;
+}
+
+void PgPool::publishBreakerState() {
+    breakerOpenUntil_.store(
+        breaker_.state == BreakerState::Open ? breaker_.open_until.time_since_epoch().count() : 0,
+        std::memory_order_relaxed
+    );
+}
+
+void PgPool::publishPoolState() {
+    openCount_.store(created_at_, std::memory_order_relaxed);
+    idleCount_.store(idle_.size(), std::memory_order_relaxed);
+}
+
+PgPool::Stats PgPool::stats() const noexcept {
+    Stats stats;
+    stats.size = size_;
+    stats.open = openCount_.load(std::memory_order_relaxed);
+    stats.idle = idleCount_.load(std::memory_order_relaxed);
+    stats.leased = stats.open > stats.idle ? stats.open - stats.idle : 0;
+    stats.waiting = waiting_.load(std::memory_order_relaxed);
+    const std::int64_t openUntil = breakerOpenUntil_.load(std::memory_order_relaxed);
+    stats.breakerOpen = openUntil != 0 && std::chrono::steady_clock::now().time_since_epoch().count() < openUntil;
+    return stats;
+}
 
 net::awaitable<PgPool::Lease> PgPool::acquire() {
+    trace::Span span("pg.acquire");
+    const trace::PhaseTimer timer(trace::Phase::DbAcquire);
+    const auto startedAt = std::chrono::steady_clock::now();
     const std::shared_ptr<PgConnection> conn = co_await make_or_wait();
+    conn->setLeaseWait(std::chrono::steady_clock::now() - startedAt);
     // RAII release closure
     Lease lease{
         conn,
@@ -40,6 +83,7 @@ void PgPool::shutdown() {
         }
         idle_.clear();
         created_at_ = 0;
+        publishPoolState();
     });
 }
 
@@ -48,26 +92,46 @@ net::awaitable<PgResult> PgPool::query(
     const std::vector<std::optional<std::string>>& params,
     const std::chrono::steady_clock::duration timeout
 ) {
+    // Opened before the first co_await: the trace context is read from the calling coroutine
+    trace::Span span("pg.query", trace::SpanKind::Client);
+    span.setAttribute("db.statement", sql);
+    trace::PhaseTimer queryTimer(trace::Phase::DbQuery);
     auto [connection, release] = co_await acquire();
+    queryTimer.restart();
     try {
         auto res = co_await connection->execParams(sql, params, timeout);
         breaker_.on_success();
+        publishBreakerState();
         release();
         co_return res;
-    } catch (const DbError&) {
+    } catch (const DbError& e) {
         // if connection is broken, drop it (release() will health-check)
         // Breaker shouldn't react on SQL errors
+        span.setError(e.what());
         release();
         throw;
+    } catch (const std::exception& e) {
+        // Infra errors, breaker should run failure protocol
+        span.setError(e.what());
+        breaker_.on_failure(std::chrono::steady_clock::now());
+        publishBreakerState();
+        release();
+        throw DbUnavailableError(e.what());
     } catch (...)
     {
-        // Infra errors, breaker should run failure protocol
         breaker_.on_failure(std::chrono::steady_clock::now());
+        publishBreakerState();
         release();
         throw;
     }
 }
 
+net::awaitable<PgResult> PgPool::query(
+    const std::string& sql,
+    const std::vector<std::optional<std::string>>& params
+) {
+    co_return co_await query(sql, params, defaultTimeout_);
+}
 
 net::awaitable<std::shared_ptr<PgConnection>> PgPool::make_or_wait() {
     co_await net::dispatch(strand_, net::use_awaitable);
@@ -78,35 +142,41 @@ net::awaitable<std::shared_ptr<PgConnection>> PgPool::make_or_wait() {
 
     auto now = std::chrono::steady_clock::now();
     if (!breaker_.allow(now)) {
-        throw std::runtime_error("Database temporarily unavailable (circuit open)");
+        throw DbUnavailableError("Database temporarily unavailable (circuit open)");
     }
 
     // 1) Reuse idle if any
     if (!idle_.empty()) {
         std::shared_ptr<PgConnection> c = idle_.back();
         idle_.pop_back();
+        publishPoolState();
         co_return c;
     }
 
     // 2) Create new if capacity allows
     if (created_at_ < size_) {
-        std::shared_ptr<PgConnection> c = std::make_shared<PgConnection>(strand_, dsn_);
+        std::shared_ptr<PgConnection> c = std::make_shared<PgConnection>(strand_, dsn_, slowLog_);
 
         try
         {
             co_await c->connect();   // if it is failed -> infra error
             ++created_at_;
+            publishPoolState();
             breaker_.on_success();
+            publishBreakerState();
             co_return c;
-        } catch (...) {
+        } catch (const std::exception& e) {
             breaker_.on_failure(std::chrono::steady_clock::now());
+            publishBreakerState();
             // created at shouldn't be touched then
-            throw;
+            throw DbUnavailableError(e.what());
         }
     }
 
     // 3) Wait on channel for a returned connection
+    waiting_.fetch_add(1, std::memory_order_relaxed);
     auto [ec, got] = co_await channel_.async_receive(net::as_tuple(net::use_awaitable));
+    waiting_.fetch_sub(1, std::memory_order_relaxed);
     if (ec) throw boost::system::system_error(ec);
     co_return got;
 }
@@ -117,16 +187,19 @@ void PgPool::release(std::shared_ptr<PgConnection> connection) {
         if (stopping_) {
             if (created_at_) --created_at_;
             c.reset();
+            publishPoolState();
             return; // drop
         }
         if (!c->healthy()) {
             if (created_at_) --created_at_;
             c.reset();
+            publishPoolState();
             return; // drop
         }
         if (channel_.try_send(boost::system::error_code{}, c)) {
             return; // gave back to awaited one
         }
         idle_.push_back(std::move(c)); // park
+        publishPoolState();
     });
 }
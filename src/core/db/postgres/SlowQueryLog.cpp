@@ -0,0 +1,229 @@
+#include "core/db/postgres/interfaces/SlowQueryLog.h"
+#include "core/db/postgres/interfaces/PgConnection.h"
+#include "core/loggers/Log.h"
+#include "core/loggers/LoggerSingleton.h"
+#include "core/metrics/MetricsRegistry.h"
+
+#include <cctype>
+
+namespace {
+    constexpr std::size_t kMaxSqlLength = 2048;
+
+    struct QueryMetrics {
+        metrics::Histogram duration;
+        metrics::Counter slow;
+        metrics::Counter explained;
+    };
+
+    const QueryMetrics& queryMetrics() {
+        auto& registry = metrics::MetricsRegistry::instance();
+        static const QueryMetrics m{
+            registry.histogram("db_query_duration_seconds", "Statement round-trip, send to last result"),
+            registry.counter("db_slow_queries_total", "Statements over the slow query threshold"),
+            registry.counter("db_slow_queries_explained_total", "Slow statements re-run under EXPLAIN ANALYZE")
+        };
+        return m;
+    }
+
+    bool isWordChar(const char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+    }
+
+    std::int64_t toMillis(const std::chrono::steady_clock::duration d) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+    }
+
+    std::string_view trimLeft(std::string_view sql) {
+        while (!sql.empty() && (std::isspace(static_cast<unsigned char>(sql.front())) || sql.front() == '(')) {
+            sql.remove_prefix(1);
+        }
+        return sql;
+    }
+
+    bool startsWithWord(const std::string_view sql, const std::string_view word) {
+        if (sql.size() < word.size()) return false;
+        for (std::size_t i = 0; i < word.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(sql[i])) != word[i]) return false;
+        }
+        return sql.size() == word.size() || !isWordChar(sql[word.size()]);
+    }
+}
+
+SlowQueryLog::SlowQueryLog(net::any_io_executor executor, std::string dsn, const Options options)
+    : strand_(net::make_strand(std::move(executor)))
+    , dsn_(std::move(dsn))
+    , options_(options) {}
+
+std::string SlowQueryLog::normalize(const std::string_view sql) {
+    std::string out;
+    out.reserve(std::min(sql.size(), kMaxSqlLength));
+
+    for (std::size_t i = 0; i < sql.size() && out.size() < kMaxSqlLength;) {
+        const char c = sql[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            while (i < sql.size() && std::isspace(static_cast<unsigned char>(sql[i]))) ++i;
+            if (!out.empty() && i < sql.size()) out += ' ';
+            continue;
+        }
+        if (c == '\'') {
+            // 'it''s' is one literal
+            ++i;
+            while (i < sql.size()) {
+                if (sql[i] == '\'' && i + 1 < sql.size() && sql[i + 1] == '\'') { i += 2; continue; }
+                if (sql[i] == '\'') { ++i; break; }
+                ++i;
+            }
+            out += '?';
+            continue;
+        }
+        const bool previousIsWord = !out.empty() && isWordChar(out.back());
+        if (std::isdigit(static_cast<unsigned char>(c)) && !previousIsWord) {
+            while (i < sql.size() && (std::isdigit(static_cast<unsigned char>(sql[i])) || sql[i] == '.')) ++i;
+            out += '?';
+            continue;
+        }
+        out += c;
+        ++i;
+    }
+    return out;
+}
+
+std::vector<std::string> SlowQueryLog::paramShapes(const Params& params) {
+    std::vector<std::string> shapes;
+    shapes.reserve(params.size());
+    for (const auto& param : params) {
+        if (!param) {
+            shapes.emplace_back("null");
+            continue;
+        }
+        const std::string& value = *param;
+        if (value == "t" || value == "f" || value == "true" || value == "false") {
+            shapes.emplace_back("bool");
+            continue;
+        }
+
+        std::size_t digits = 0;
+        std::size_t dots = 0;
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            if (std::isdigit(static_cast<unsigned char>(value[i]))) ++digits;
+            else if (value[i] == '.') ++dots;
+            else if (!(i == 0 && value[i] == '-')) { digits = 0; break; }
+        }
+        if (digits > 0 && dots == 0) shapes.emplace_back("int");
+        else if (digits > 0 && dots == 1) shapes.emplace_back("numeric");
+        else shapes.push_back("text(" + std::to_string(value.size()) + ")");
+    }
+    return shapes;
+}
+
+bool SlowQueryLog::explainable(const std::string_view sql) {
+    const std::string_view head = trimLeft(sql);
+    if (startsWithWord(head, "select")) return true;
+    if (!startsWithWord(head, "with")) return false;
+    // Data-modifying CTEs would be rejected by READ ONLY anyway, do not even try
+    std::string lowered = normalize(sql);
+    for (char& ch : lowered) ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    for (const std::string_view verb : {"insert ", "update ", "delete "}) {
+        if (lowered.find(verb) != std::string::npos) return false;
+    }
+    return true;
+}
+
+void SlowQueryLog::observe(
+    const std::string_view sql,
+    const Params& params,
+    const std::chrono::steady_clock::duration elapsed,
+    const std::chrono::steady_clock::duration poolWait,
+    const std::size_t rows,
+    const char* error
+) {
+    queryMetrics().duration.observe(elapsed);
+    if (options_.threshold.count() <= 0 || elapsed < options_.threshold) return;
+    queryMetrics().slow.inc();
+
+    Record record;
+    record.sql = normalize(sql);
+    record.params = paramShapes(params);
+    record.elapsedMs = toMillis(elapsed);
+    record.poolWaitMs = toMillis(poolWait);
+    record.rows = rows;
+    if (error) record.error = error;
+
+    const std::uint64_t n = slowCount_.fetch_add(1, std::memory_order_relaxed) + 1;
+    const bool sampled = options_.explainEvery > 0 && n % options_.explainEvery == 0
+        && !record.error && explainable(sql);
+    // Only one EXPLAIN at a time: a burst of slow queries must not become a burst of ANALYZE runs
+    if (!sampled || explaining_.exchange(true, std::memory_order_acq_rel)) {
+        write(record, nullptr);
+        return;
+    }
+    net::co_spawn(
+        strand_,
+        explainAndWrite(std::move(record), std::string(sql), params),
+        net::detached
+    );
+}
+
+void SlowQueryLog::write(const Record& record, const std::vector<std::string>* plan) {
+    if (plan) {
+        LOG_WARN("SlowQueryLog: slow query",
+            {"sql", record.sql},
+            {"params", record.params},
+            {"elapsed_ms", record.elapsedMs},
+            {"pool_wait_ms", record.poolWaitMs},
+            {"rows", record.rows},
+            {"plan", *plan}
+        );
+        return;
+    }
+    LOG_WARN("SlowQueryLog: slow query",
+        {"sql", record.sql},
+        {"params", record.params},
+        {"elapsed_ms", record.elapsedMs},
+        {"pool_wait_ms", record.poolWaitMs},
+        {"rows", record.rows},
+        {"error", record.error}
+    );
+}
+
+net::awaitable<void> SlowQueryLog::explainAndWrite(Record record, std::string sql, Params params) {
+    const auto self = shared_from_this();
+    std::vector<std::string> plan;
+    try {
+        plan = co_await explain(sql, params);
+        queryMetrics().explained.inc();
+    } catch (const std::exception& e) {
+        // The dedicated connection is in an unknown state, next EXPLAIN reconnects
+        explainConnection_.reset();
+        plan = {std::string("EXPLAIN failed: ") + e.what()};
+    }
+    write(record, &plan);
+    explaining_.store(false, std::memory_order_release);
+}
+
+net::awaitable<std::vector<std::string>> SlowQueryLog::explain(const std::string& sql, const Params& params) {
+    if (!explainConnection_) {
+        explainConnection_ = std::make_shared<PgConnection>(strand_, dsn_);
+    }
+    const std::shared_ptr<PgConnection> connection = explainConnection_;
+    co_await connection->connect();
+
+    // ANALYZE executes the statement: READ ONLY + ROLLBACK keep it side-effect free
+    (void)co_await connection->execParams("BEGIN READ ONLY", {}, options_.explainTimeout);
+    std::optional<PgResult> result;
+    std::optional<std::string> error;
+    try {
+        result = co_await connection->execParams("EXPLAIN (ANALYZE, BUFFERS) " + sql, params, options_.explainTimeout);
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+    (void)co_await connection->execParams("ROLLBACK", {}, options_.explainTimeout);
+    if (error) throw std::runtime_error(*error);
+
+    std::vector<std::string> plan;
+    plan.reserve(result->rows.size());
+    for (const auto& row : result->rows) {
+        if (!row.columns.empty()) plan.push_back(row.columns[0].data);
+    }
+    co_return plan;
+}
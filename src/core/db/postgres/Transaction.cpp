@@ -1,6 +1,6 @@
 #include "core/db/postgres/interfaces/Transaction.h"
 
-net::awaitable<Transaction> Transaction::begin(PgPool& pool, const std::chrono::steady_clock::duration timeout) {
+net::awaitable<Transaction> Transaction::begin(PgPoolInterface& pool, const std::chrono::steady_clock::duration timeout) {
     auto lease = co_await pool.acquire();
     co_await lease.connection->begin(timeout);
     Transaction tx{
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "core/db/postgres/interfaces/PgPoolInterface.h"
+#include "core/helpers/LatencyDistribution.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/// In-memory stand-in for PgPool (DATABASE_DRIVER=fake): handlers, middlewares and the whole app
+/// can be measured without Postgres, with the database cost set explicitly instead of removed by accident.
+///
+/// Every statement sleeps for a sampled latency (a timer, the loop keeps serving), may fail with an injected
+/// error and then answers:
+///  - from the first rule registered with when() whose fragment occurs in the SQL;
+///  - otherwise from synthesize(): SQLBuilder shapes over the users table, columns taken from the SELECT list,
+///    LIMIT/OFFSET and `col = $n` filters honoured, RETURNING gets a fresh id. SELECT EXISTS(...) is true only
+///    with a `col = $n` filter (the row it names is synthesized), register a when() rule for "not found" cases.
+/// Rules are not synchronized: register them before the first query.
+class FakePgPool final : public PgPoolInterface {
+public:
+    /// fixed: always mean; uniform: [0, 2 * mean]; exponential; lognormal: sigma 1, long tail
+    using Latency = LatencyDistribution::Kind;
+    /// unavailable -> DbUnavailableError (503 path); unique -> DbError UniqueViolation (SQL error path)
+    enum class Failure { Unavailable, UniqueViolation };
+
+    struct Options {
+        Latency latency = Latency::Fixed;
+        std::chrono::microseconds meanLatency{0};
+        /// Share of statements failing, 0..1
+        double errorRate = 0.0;
+        Failure failure = Failure::Unavailable;
+        /// Rows of a SELECT without LIMIT
+        std::size_t rows = 20;
+        /// Returned in the password column: a hash of a known password makes login succeed
+        std::string passwordHash;
+        /// Reported by stats(), the fake never makes anybody wait
+        std::size_t size = 10;
+        std::chrono::steady_clock::duration defaultTimeout{std::chrono::seconds(5)};
+    };
+
+    using Responder = std::function<PgResult(const std::string& sql, const std::vector<std::optional<std::string>>& params)>;
+
+    /// Latency timers run on the awaiting coroutine's executor
+    explicit FakePgPool(Options options);
+
+    /// Canned result for every statement containing sqlFragment
+    void when(std::string sqlFragment, PgResult result);
+    void when(std::string sqlFragment, Responder responder);
+
+    net::awaitable<Lease> acquire() override;
+    void shutdown() override;
+
+    net::awaitable<PgResult> query(
+        const std::string& sql,
+        const std::vector<std::optional<std::string>>& params,
+        std::chrono::steady_clock::duration timeout
+    ) override;
+    net::awaitable<PgResult> query(
+        const std::string& sql,
+        const std::vector<std::optional<std::string>>& params
+    ) override;
+
+    [[nodiscard]] bool degraded() const noexcept override { return false; }
+    [[nodiscard]] std::size_t waiting() const noexcept override { return 0; }
+    /// Leased = leases and queries in flight
+    [[nodiscard]] Stats stats() const noexcept override;
+
+    /// Statements answered so far, failures included
+    [[nodiscard]] std::uint64_t statements() const noexcept { return statements_.load(std::memory_order_relaxed); }
+
+    /// Latency, error injection and the answer of one statement. Used by the leased connections as well
+    net::awaitable<PgResult> respond(
+        const std::string& sql,
+        const std::vector<std::optional<std::string>>& params,
+        std::chrono::steady_clock::duration timeout
+    );
+
+    /// Fallback answer for SQLBuilder statements, no latency and no errors
+    [[nodiscard]] PgResult synthesize(const std::string& sql, const std::vector<std::optional<std::string>>& params) const;
+
+    static Latency parseLatency(std::string_view name);
+    static Failure parseFailure(std::string_view name);
+
+private:
+    Options options_;
+    std::vector<std::pair<std::string, Responder>> rules_;
+    std::atomic<std::size_t> inflight_{0};
+    std::atomic<std::uint64_t> statements_{0};
+    mutable std::atomic<std::int64_t> nextId_{1'000'000};
+
+    [[nodiscard]] std::chrono::steady_clock::duration sampleLatency() const;
+    [[nodiscard]] bool sampleFailure() const;
+};
@@ -1,18 +1,23 @@
 #pragma once
 
-#include "core/db/postgres/interfaces/PgTypes.h"
+#include "core/db/postgres/interfaces/PgConnectionInterface.h"
 #include <boost/asio.hpp>
 #include <libpq-fe.h>
 #include <string>
 #include <optional>
 #include <chrono>
+#include <functional>
+#include <memory>
 #include <unordered_set>
 
 namespace net = boost::asio;
 
-class PgConnection {
+class SlowQueryLog;
+
+class PgConnection final : public PgConnectionInterface {
 public:
-    PgConnection(net::any_io_executor executor, std::string dsn);
+    /// slowLog: every statement is reported with its duration, nullptr -> not measured
+    PgConnection(net::any_io_executor executor, std::string dsn, std::shared_ptr<SlowQueryLog> slowLog = nullptr);
     ~PgConnection();
 
     net::awaitable<void> connect();
@@ -22,21 +27,27 @@ public:
         std::string sql,
         const std::vector<std::optional<std::string>>& params,
         std::chrono::steady_clock::duration timeout
-    );
+    ) override;
 
     net::awaitable<PgResult> execPrepared(
         std::string_view stmtName,
         std::string_view sqlIfPrepareNeeded,
         const std::vector<std::optional<std::string>>& params,
         std::chrono::steady_clock::duration timeout
-    );
+    ) override;
 
     /// Transactions
-    net::awaitable<void> begin(std::chrono::steady_clock::duration timeout);
-    net::awaitable<void> commit(std::chrono::steady_clock::duration timeout);
-    net::awaitable<void> rollback(std::chrono::steady_clock::duration timeout);
+    net::awaitable<void> begin(std::chrono::steady_clock::duration timeout) override;
+    net::awaitable<void> commit(std::chrono::steady_clock::duration timeout) override;
+    net::awaitable<void> rollback(std::chrono::steady_clock::duration timeout) override;
 
-    [[nodiscard]] bool healthy() const noexcept;
+    [[nodiscard]] bool healthy() const noexcept override;
+
+    /// Time the current lease waited in PgPool::acquire, attached to slow query records
+    void setLeaseWait(const std::chrono::steady_clock::duration wait) noexcept { leaseWait_ = wait; }
+
+    /// Copies a libpq result into PgResult, public for the db benchmarks
+    static PgResult buildResult(const PGresult* r);
 
 private:
     net::any_io_executor executor_;
@@ -44,17 +55,28 @@ private:
     PGconn* conn_{nullptr};
     std::optional<net::posix::stream_descriptor> stream_descriptor_;
     std::unordered_set<std::string> prepared_; // per-connection cache
+    std::shared_ptr<SlowQueryLog> slowLog_;
+    std::chrono::steady_clock::duration leaseWait_{};
 
     net::awaitable<void> wait_readable(std::chrono::steady_clock::time_point deadline);
     net::awaitable<void> wait_writable(std::chrono::steady_clock::time_point deadline);
     net::awaitable<void> ensure_connected();
     void close();
 
+    /// sql/params describe the statement for SlowQueryLog, empty sql -> not reported (PREPARE)
     net::awaitable<PgResult> runQueryWithTimeout(
         std::function<int()> sendFn,
-        std::chrono::steady_clock::duration timeout
+        std::chrono::steady_clock::duration timeout,
+        std::string_view sql,
+        const std::vector<std::optional<std::string>>& params
     );
+    void report(
+        std::string_view sql,
+        const std::vector<std::optional<std::string>>& params,
+        std::chrono::steady_clock::time_point startedAt,
+        std::size_t rows,
+        const char* error
+    ) const;
 
-    static PgResult buildResult(const PGresult* r);
-    void cancel() const noexcept; // best-effort PQcancel
+    void cancel() const noexcept; // best-effort PQcancel, queued to a single background thread
 };
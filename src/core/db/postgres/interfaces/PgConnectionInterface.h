@@ -0,0 +1,36 @@
+#pragma once
+
+#include "core/db/postgres/interfaces/PgTypes.h"
+#include <boost/asio.hpp>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace net = boost::asio;
+
+/// What a lease hands out: statements and transaction control on one session
+class PgConnectionInterface {
+public:
+    virtual ~PgConnectionInterface() = default;
+
+    virtual net::awaitable<PgResult> execParams(
+        std::string sql,
+        const std::vector<std::optional<std::string>>& params,
+        std::chrono::steady_clock::duration timeout
+    ) = 0;
+
+    virtual net::awaitable<PgResult> execPrepared(
+        std::string_view stmtName,
+        std::string_view sqlIfPrepareNeeded,
+        const std::vector<std::optional<std::string>>& params,
+        std::chrono::steady_clock::duration timeout
+    ) = 0;
+
+    virtual net::awaitable<void> begin(std::chrono::steady_clock::duration timeout) = 0;
+    virtual net::awaitable<void> commit(std::chrono::steady_clock::duration timeout) = 0;
+    virtual net::awaitable<void> rollback(std::chrono::steady_clock::duration timeout) = 0;
+
+    [[nodiscard]] virtual bool healthy() const noexcept = 0;
+};
@@ -1,14 +1,18 @@
 #pragma once
 
 #include "core/db/postgres/interfaces/PgConnection.h"
+#include "core/db/postgres/interfaces/PgPoolInterface.h"
+#include "core/db/postgres/interfaces/SlowQueryLog.h"
 #include <boost/asio.hpp>
 #include <boost/asio/experimental/channel.hpp>
+#include <atomic>
 #include <memory>
 #include <vector>
 
-class PgPool {
+class PgPool final : public PgPoolInterface {
 public:
-    PgPool(net::any_io_executor executor, std::string dsn, std::size_t size);
+    /// saturationWaiters: queue length considered saturated, 0 -> 2 * size
+    PgPool(net::any_io_executor executor, std::string dsn, std::size_t size, std::size_t saturationWaiters = 0);
 
     // Circuit braker for DB 503
     enum class BreakerState { Closed, Open, HalfOpen };
@@ -69,20 +73,33 @@ public:
         }
     };
 
-    struct Lease {
-        std::shared_ptr<PgConnection> connection;
-        std::function<void()> release; // RAII return to pool
-    };
-
-    net::awaitable<Lease> acquire();
+    net::awaitable<Lease> acquire() override;
     /// Gracefully kill
-    void shutdown();
+    void shutdown() override;
 
     net::awaitable<PgResult> query(
         const std::string& sql,
         const std::vector<std::optional<std::string>>& params,
         std::chrono::steady_clock::duration timeout
-    );
+    ) override;
+    /// With defaultTimeout()
+    net::awaitable<PgResult> query(
+        const std::string& sql,
+        const std::vector<std::optional<std::string>>& params
+    ) override;
+
+    /// Set before the first acquire: connections pick them up when they are opened
+    void setDefaultTimeout(const std::chrono::steady_clock::duration timeout) noexcept { defaultTimeout_ = timeout; }
+    [[nodiscard]] std::chrono::steady_clock::duration defaultTimeout() const noexcept { return defaultTimeout_; }
+    void setSlowQueryLog(std::shared_ptr<SlowQueryLog> slowLog) noexcept { slowLog_ = std::move(slowLog); }
+
+    /// Breaker is open or the waiter queue is saturated: reads should prefer stale data to waiting.
+    /// Lock-free, may be called from any thread
+    [[nodiscard]] bool degraded() const noexcept override;
+    [[nodiscard]] std::size_t waiting() const noexcept override { return waiting_.load(std::memory_order_relaxed); }
+
+    /// Lock-free snapshot of the atomic mirrors, fields may be from slightly different moments
+    [[nodiscard]] Stats stats() const noexcept override;
 
 private:
     net::any_io_executor executor_;
@@ -91,6 +108,8 @@ private:
     const std::size_t size_;
     std::vector<std::shared_ptr<PgConnection>> idle_;
     std::size_t created_at_{0};
+    std::chrono::steady_clock::duration defaultTimeout_{std::chrono::seconds(5)};
+    std::shared_ptr<SlowQueryLog> slowLog_;
 
     /// Queue of awaiting objects
     net::experimental::channel<void(boost::system::error_code, std::shared_ptr<PgConnection>)> channel_;
@@ -99,4 +118,14 @@ private:
     void release(std::shared_ptr<PgConnection> connection);
 
     CircuitBreaker breaker_;
+
+    /// Atomic mirrors of strand-owned state, read by degraded()
+    std::atomic<std::int64_t> breakerOpenUntil_{0};
+    std::atomic<std::size_t> waiting_{0};
+    std::atomic<std::size_t> openCount_{0};
+    std::atomic<std::size_t> idleCount_{0};
+    const std::size_t saturationWaiters_;
+    void publishBreakerState();
+    /// On strand, after idle_ or created_at_ change
+    void publishPoolState();
 };
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "core/db/postgres/interfaces/PgConnectionInterface.h"
+#include <functional>
+#include <memory>
+
+/// Everything repositories, middlewares and metrics need from a pool.
+/// PgPool talks to Postgres, FakePgPool answers from memory (DATABASE_DRIVER=fake).
+class PgPoolInterface {
+public:
+    struct Lease {
+        std::shared_ptr<PgConnectionInterface> connection;
+        std::function<void()> release; // RAII return to pool
+    };
+
+    struct Stats {
+        std::size_t size = 0;
+        std::size_t open = 0;
+        std::size_t idle = 0;
+        std::size_t leased = 0;
+        std::size_t waiting = 0;
+        bool breakerOpen = false;
+    };
+
+    virtual ~PgPoolInterface() = default;
+
+    virtual net::awaitable<Lease> acquire() = 0;
+    /// Gracefully kill
+    virtual void shutdown() = 0;
+
+    virtual net::awaitable<PgResult> query(
+        const std::string& sql,
+        const std::vector<std::optional<std::string>>& params,
+        std::chrono::steady_clock::duration timeout
+    ) = 0;
+    /// With the pool's default timeout
+    virtual net::awaitable<PgResult> query(
+        const std::string& sql,
+        const std::vector<std::optional<std::string>>& params
+    ) = 0;
+
+    /// Reads should prefer stale data to waiting. Lock-free, may be called from any thread
+    [[nodiscard]] virtual bool degraded() const noexcept = 0;
+    [[nodiscard]] virtual std::size_t waiting() const noexcept = 0;
+    /// Lock-free snapshot, fields may be from slightly different moments
+    [[nodiscard]] virtual Stats stats() const noexcept = 0;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace net = boost::asio;
+
+class PgConnection;
+
+/// Latency of every query and a log record for the slow ones.
+///
+/// PgConnection reports each statement it runs. Queries at or over the threshold are logged with
+/// normalized SQL (literals replaced by ?), parameter shapes (never values), rows returned and the pool wait
+/// of the lease. Every explainEvery-th slow SELECT is re-run as EXPLAIN (ANALYZE, BUFFERS) inside a
+/// READ ONLY transaction on a dedicated connection (one at a time, never from the pool), the plan
+/// goes into the same record. Parameter values are kept in memory only for that EXPLAIN.
+class SlowQueryLog : public std::enable_shared_from_this<SlowQueryLog> {
+public:
+    using Params = std::vector<std::optional<std::string>>;
+
+    struct Options {
+        /// 0 disables slow query records, durations are still measured
+        std::chrono::milliseconds threshold{200};
+        /// EXPLAIN 1 of N slow SELECTs, 0 disables
+        std::uint64_t explainEvery = 0;
+        std::chrono::steady_clock::duration explainTimeout{std::chrono::seconds(30)};
+    };
+
+    SlowQueryLog(net::any_io_executor executor, std::string dsn, Options options);
+
+    void observe(
+        std::string_view sql,
+        const Params& params,
+        std::chrono::steady_clock::duration elapsed,
+        std::chrono::steady_clock::duration poolWait,
+        std::size_t rows,
+        const char* error
+    );
+
+    /// Whitespace collapsed, string and numeric literals replaced by ?, $n placeholders kept
+    static std::string normalize(std::string_view sql);
+    /// null | int | numeric | bool | text(len)
+    static std::vector<std::string> paramShapes(const Params& params);
+    /// SELECT / WITH ... SELECT: safe to run again under EXPLAIN ANALYZE in a read-only transaction
+    static bool explainable(std::string_view sql);
+
+    [[nodiscard]] const Options& options() const noexcept { return options_; }
+
+private:
+    struct Record {
+        std::string sql;
+        std::vector<std::string> params;
+        std::int64_t elapsedMs = 0;
+        std::int64_t poolWaitMs = 0;
+        std::size_t rows = 0;
+        std::optional<std::string> error;
+    };
+
+    net::strand<net::any_io_executor> strand_;
+    std::string dsn_;
+    Options options_;
+    std::atomic<std::uint64_t> slowCount_{0};
+    std::atomic<bool> explaining_{false};
+    /// Owned by strand_
+    std::shared_ptr<PgConnection> explainConnection_;
+
+    static void write(const Record& record, const std::vector<std::string>* plan);
+    net::awaitable<void> explainAndWrite(Record record, std::string sql, Params params);
+    net::awaitable<std::vector<std::string>> explain(const std::string& sql, const Params& params);
+};
@@ -27,6 +27,13 @@ private:
     DbErrorCode code_;
 };
 
+/// Infrastructure failure: circuit open, connection lost, timeout. Never an SQL error (see DbError).
+class DbUnavailableError final : public std::runtime_error {
+public:
+    explicit DbUnavailableError(const std::string& message)
+        : std::runtime_error(message) {}
+};
+
 class MultipartError final : public std::runtime_error {
 public:
     explicit MultipartError(const std::string& message)
@@ -8,12 +8,13 @@
 #include <chrono>
 #include <fstream>
 #include <random>
-#include <regex>
 #include <system_error>
 #include <boost/asio/co_spawn.hpp>
 
 #include "core/file_system/magic_mime/MagicMimeDetector.h"
+#include "core/loggers/Log.h"
 #include "core/loggers/LoggerSingleton.h"
+#include "core/tracing/Span.h"
 
 #include "errors/FileSystemErrors.h"
 
@@ -49,14 +50,16 @@ StoredFileInfo FileSystemService::store(
     std::string_view entityId,
     IncomingFile file) const
 {
+    trace::Span span("fs.store");
+    span.setAttribute("bytes", static_cast<std::int64_t>(file.bytes.size()));
     if (file.bytes.empty())
     {
         throw FileIOError("FileSystemService: file is empty");
     };
-    LoggerSingleton::get().info("FileSystemService::store: called", {
-        {"entityName", std::string(entityName)},
-        {"entityId", std::string(entityId)},
-    });
+    LOG_INFO("FileSystemService::store: called",
+        {"entityName", entityName},
+        {"entityId", entityId}
+    );
     const std::string normEntity = normalizeEntityName(entityName);
     const std::string normId = normalizeEntityId(entityId);
 
@@ -101,9 +104,8 @@ StoredFileInfo FileSystemService::store(
 
 void FileSystemService::remove(const std::filesystem::path& relativePath) const
 {
-    LoggerSingleton::get().info("FileSystemService::remove: called", {
-        {"relativePath", relativePath.string()},
-    });
+    trace::Span span("fs.remove");
+    LOG_INFO("FileSystemService::remove: called", {"relativePath", relativePath.string()});
     if (relativePath.empty()) return;
 
     const std::filesystem::path fullPath = opts_.rootPath / relativePath;
@@ -119,9 +121,7 @@ void FileSystemService::remove(const std::filesystem::path& relativePath) const
 
 bool FileSystemService::exists(const std::filesystem::path& relativePath) const
 {
-    LoggerSingleton::get().info("FileSystemService::exists: called", {
-        {"relativePath", relativePath.string()},
-    });
+    LOG_DEBUG("FileSystemService::exists: called", {"relativePath", relativePath.string()});
     if (relativePath.empty()) return false;
     const std::filesystem::path fullPath = opts_.rootPath / relativePath;
     ensureWithinRoot(opts_.rootPath, fullPath);
@@ -133,9 +133,7 @@ bool FileSystemService::exists(const std::filesystem::path& relativePath) const
 
 std::string FileSystemService::toLower(std::string input)
 {
-    LoggerSingleton::get().info("FileSystemService::toLower: called", {
-        {"input", input},
-    });
+    LOG_DEBUG("FileSystemService::toLower: called", {"input", input});
     std::ranges::transform(input, input.begin(),
                            [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
     return input;
@@ -143,11 +141,10 @@ std::string FileSystemService::toLower(std::string input)
 
 bool FileSystemService::isValidEntityName(const std::string_view input)
 {
-    LoggerSingleton::get().info("FileSystemService::isValidEntityName: called", {
-        {"input", std::string(input)},
+    LOG_DEBUG("FileSystemService::isValidEntityName: called", {"input", input});
+    return !input.empty() && std::ranges::all_of(input, [](const char c) {
+        return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_';
     });
-    static const std::regex re("^[a-z0-9_]+$");
-    return std::regex_match(std::string(input), re);
 }
 
 bool FileSystemService::isValidEntityId(std::string_view input) const
@@ -158,15 +155,14 @@ bool FileSystemService::isValidEntityId(std::string_view input) const
         return std::all_of(input.begin(), input.end(), [](unsigned char c){ return std::isdigit(c); });
     }
 
-    // allow [a-z0-9_-]+
-    static const std::regex re("^[a-z0-9_-]+$");
-    return std::regex_match(std::string(input), re);
+    // allow [a-z0-9_-]+, checked by hand: std::regex recurses per character of a client supplied id
+    return std::ranges::all_of(input, [](const char c) {
+        return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+    });
 }
 
 std::string FileSystemService::normalizeEntityName(std::string_view input) {
-    LoggerSingleton::get().info("FileSystemService::normalizeEntityName: called", {
-        {"input", std::string(input)},
-    });
+    LOG_DEBUG("FileSystemService::normalizeEntityName: called", {"input", input});
     std::string v(input);
     v = toLower(std::move(v));
     if (!isValidEntityName(v)) {
@@ -176,9 +172,7 @@ std::string FileSystemService::normalizeEntityName(std::string_view input) {
 }
 
 std::string FileSystemService::normalizeEntityId(std::string_view input) const {
-    LoggerSingleton::get().info("FileSystemService::normalizeEntityId: called", {
-        {"input", std::string(input)},
-    });
+    LOG_DEBUG("FileSystemService::normalizeEntityId: called", {"input", input});
     std::string v(input);
     v = toLower(std::move(v));
     if (!isValidEntityId(v)) {
@@ -206,10 +200,10 @@ std::string FileSystemService::buildRelativePath(const std::string_view entityNa
 std::filesystem::path FileSystemService::buildRelativeDir(const std::string_view entityName,
                                                      const std::string_view entityId)
 {
-    LoggerSingleton::get().info("FileSystemService::buildRelativeDir: called", {
-        {"entityName", std::string(entityName)},
-        {"entityId", std::string(entityId)},
-    });
+    LOG_DEBUG("FileSystemService::buildRelativeDir: called",
+        {"entityName", entityName},
+        {"entityId", entityId}
+    );
     // entity/id/file
     return std::filesystem::path(entityName) / std::filesystem::path(entityId) / "file";
 }
@@ -217,9 +211,7 @@ std::filesystem::path FileSystemService::buildRelativeDir(const std::string_view
 std::string FileSystemService::pickAllowedExtension(const Options& opts,
                                                 const std::string_view originalFileName)
 {
-    LoggerSingleton::get().info("FileSystemService::pickAllowedExtension: called", {
-        {"originalFileName", std::string(originalFileName)},
-    });
+    LOG_DEBUG("FileSystemService::pickAllowedExtension: called", {"originalFileName", originalFileName});
     if (originalFileName.empty()) return {};
 
     const std::filesystem::path p{std::string(originalFileName)};
@@ -259,10 +251,10 @@ std::string FileSystemService::randomHex(const std::size_t bytesLen) {
 void FileSystemService::ensureWithinRoot(const std::filesystem::path& root,
                                     const std::filesystem::path& fullPath)
 {
-    LoggerSingleton::get().info("FileSystemService::ensureWithinRoot: called", {
+    LOG_DEBUG("FileSystemService::ensureWithinRoot: called",
         {"root", root.string()},
-        {"fullPath", fullPath.string()},
-    });
+        {"fullPath", fullPath.string()}
+    );
     // Weakly canonical to tolerate non-existent final file.
     std::error_code ec1, ec2;
     const auto canonRoot = std::filesystem::weakly_canonical(root, ec1);
@@ -284,7 +276,7 @@ void FileSystemService::ensureWithinRoot(const std::filesystem::path& root,
 }
 
 void FileSystemService::validateFile(const Options& opts, const IncomingFile& file) {
-    LoggerSingleton::get().info("FileSystemService::validateFile: called");
+    LOG_DEBUG("FileSystemService::validateFile: called");
     if (file.bytes.empty()) {
         throw FileValidationError("File is empty");
     }
@@ -328,11 +320,12 @@ void FileSystemService::writeFileAtomic(const std::filesystem::path& finalPath,
                                    const std::vector<std::uint8_t>& bytes,
                                    std::uintmax_t& bytesWritten)
 {
-    LoggerSingleton::get().info("FileSystemService::writeFileAtomic: called", {
-       {"finalPath", finalPath.string()},
-       {"bytes", std::to_string(bytes.size())},
-       {"bytesWritten", std::to_string(bytesWritten)},
-   });
+    trace::Span span("fs.write");
+    LOG_DEBUG("FileSystemService::writeFileAtomic: called",
+        {"finalPath", finalPath.string()},
+        {"bytes", bytes.size()},
+        {"bytesWritten", bytesWritten}
+    );
     const auto dir = finalPath.parent_path();
 
     // temp name in same directory (so rename is atomic on same filesystem)
@@ -1,17 +1,28 @@
 #include "BaseFilter.h"
 #include <vector>
+#include <cctype>
+#include <charconv>
 #include <sstream>
+#include <string_view>
 
 std::vector<std::int64_t> BaseFilter::parseIds(const std::string& input){
     std::vector<std::int64_t> out;
-    std::istringstream ss(input);
-    std::string token;
-    while (std::getline(ss, token, ',')) {
-        if (!token.empty()) {
-            try {
-                out.push_back(std::stoull(token));
-            } catch (...) { continue; }
-        }
+    std::string_view rest(input);
+    while (!rest.empty()) {
+        const std::size_t comma = rest.find(',');
+        std::string_view token = rest.substr(0, comma);
+        rest = comma == std::string_view::npos ? std::string_view{} : rest.substr(comma + 1);
+
+        // Same tokens std::stoull accepted, without an exception per malformed one: leading spaces, a sign
+        // (negative wraps around), digits up to the first non-digit
+        while (!token.empty() && std::isspace(static_cast<unsigned char>(token.front()))) token.remove_prefix(1);
+        const bool negative = !token.empty() && token.front() == '-';
+        if (!token.empty() && (token.front() == '+' || token.front() == '-')) token.remove_prefix(1);
+
+        std::uint64_t value = 0;
+        const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+        if (ec != std::errc{}) continue;
+        out.push_back(static_cast<std::int64_t>(negative ? 0 - value : value));
     }
     return out;
 }
@@ -0,0 +1,48 @@
+#pragma once
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string_view>
+
+/// Injected delays shared by FakePgPool and the fault proxy: the same name gives the same shape in both
+struct LatencyDistribution {
+    /// fixed: always mean; uniform: [0, 2 * mean]; exponential; lognormal: sigma 1, long tail
+    enum class Kind { Fixed, Uniform, Exponential, LogNormal };
+
+    /// Unknown names are fixed
+    static Kind parse(const std::string_view name) {
+        if (name == "uniform") return Kind::Uniform;
+        if (name == "exponential") return Kind::Exponential;
+        if (name == "lognormal") return Kind::LogNormal;
+        return Kind::Fixed;
+    }
+
+    /// Thread-local engine, callable from any thread
+    static std::chrono::duration<double, std::micro> sample(const Kind kind, const std::chrono::microseconds mean) {
+        const double us = static_cast<double>(mean.count());
+        if (us <= 0) return std::chrono::duration<double, std::micro>(0);
+
+        switch (kind) {
+            case Kind::Fixed:
+                return std::chrono::duration<double, std::micro>(us);
+            case Kind::Uniform:
+                return std::chrono::duration<double, std::micro>(std::uniform_real_distribution(0.0, 2.0 * us)(rng()));
+            case Kind::Exponential:
+                return std::chrono::duration<double, std::micro>(std::exponential_distribution(1.0 / us)(rng()));
+            case Kind::LogNormal: {
+                // sigma 1: p99 is about 5x the median, mu keeps the requested mean
+                constexpr double sigma = 1.0;
+                return std::chrono::duration<double, std::micro>(
+                    std::lognormal_distribution(std::log(us) - sigma * sigma / 2.0, sigma)(rng())
+                );
+            }
+        }
+        return std::chrono::duration<double, std::micro>(us);
+    }
+
+private:
+    static std::mt19937_64& rng() {
+        thread_local std::mt19937_64 engine{std::random_device{}()};
+        return engine;
+    }
+};
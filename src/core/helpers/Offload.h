@@ -4,9 +4,12 @@
 #include <optional>
 #include <exception>
 #include <atomic>
+#include <chrono>
 #include <memory>
 
 #include "core/http/interfaces/HttpInterface.h"
+#include "core/metrics/MetricsRegistry.h"
+#include "core/tracing/Span.h"
 
 /// NEED TO STRICTLY REVIEWED
 /// Written with GPT guide, but need to be tested on production env
@@ -18,6 +21,39 @@ inline std::exception_ptr make_operation_aborted_ep()
     );
 }
 
+/// Blocking pool has no introspection: depth and timings are tracked around every offloaded task
+struct OffloadMetrics {
+    metrics::Gauge queued;
+    metrics::Gauge active;
+    metrics::Histogram wait;
+    metrics::Histogram run;
+
+    static const OffloadMetrics& get() {
+        auto& registry = metrics::MetricsRegistry::instance();
+        static const OffloadMetrics m{
+            registry.gauge("blocking_pool_queued", "Tasks posted to the blocking pool, not started yet"),
+            registry.gauge("blocking_pool_active", "Tasks running on the blocking pool"),
+            registry.histogram("blocking_pool_wait_seconds", "Time a task waited for a blocking pool thread"),
+            registry.histogram("blocking_pool_run_seconds", "Time a task ran on the blocking pool")
+        };
+        return m;
+    }
+
+    /// Called on the blocking thread when the task starts, returns its start time
+    static std::chrono::steady_clock::time_point started(const std::chrono::steady_clock::time_point queuedAt) {
+        const auto now = std::chrono::steady_clock::now();
+        get().queued.dec();
+        get().active.inc();
+        get().wait.observe(now - queuedAt);
+        return now;
+    }
+
+    static void finished(const std::chrono::steady_clock::time_point startedAt) {
+        get().active.dec();
+        get().run.observe(std::chrono::steady_clock::now() - startedAt);
+    }
+};
+
 template <class Handler, class R>
 struct OffloadState {
     explicit OffloadState(net::any_io_executor ex)
@@ -41,13 +77,18 @@ auto async_offload(Executor blockingEx, Fn fn)
 {
     using R = std::invoke_result_t<Fn>;
 
+    // Blocking threads have no slot of their own: the context is captured here and re-installed there,
+    // "offload" covers queueing + run, "offload.run" the run alone
+    trace::Span span("offload");
+    const trace::Captured traced = trace::Captured::here();
+
     auto ioEx  = co_await net::this_coro::executor;
     auto token = net::as_tuple(net::use_awaitable);
 
     if constexpr (std::is_void_v<R>)
     {
         auto [ep] = co_await net::async_initiate<decltype(token), void(std::exception_ptr)>(
-            [ioEx, blockingEx, func = std::move(fn)](auto handler) mutable {
+            [ioEx, blockingEx, traced, func = std::move(fn)](auto handler) mutable {
 
                 using H  = std::decay_t<decltype(handler)>;
                 using St = OffloadState<H, int>; // int-fiction, result is not using with void
@@ -78,8 +119,13 @@ auto async_offload(Executor blockingEx, Fn fn)
                     });
                 }
 
-                net::post(blockingEx, [ioEx, st, func = std::move(func)]() mutable {
+                OffloadMetrics::get().queued.inc();
+                net::post(blockingEx, [ioEx, st, traced, func = std::move(func), queuedAt = std::chrono::steady_clock::now()]() mutable {
+                    const auto startedAt = OffloadMetrics::started(queuedAt);
+                    if (traced.context) traced.context->timings.add(trace::Phase::OffloadQueue, startedAt - queuedAt);
                     try {
+                        const trace::ThreadScope scope(traced);
+                        trace::Span run("offload.run");
                         if (!st->cancelled.load(std::memory_order_relaxed)) {
                             func();
                         } else {
@@ -88,6 +134,8 @@ auto async_offload(Executor blockingEx, Fn fn)
                     } catch (...) {
                         st->ep = std::current_exception();
                     }
+                    OffloadMetrics::finished(startedAt);
+                    if (traced.context) traced.context->timings.add(trace::Phase::OffloadRun, std::chrono::steady_clock::now() - startedAt);
 
                     net::post(ioEx, [st]() mutable {
                         if (st->completed.exchange(true, std::memory_order_acq_rel))
@@ -112,7 +160,7 @@ auto async_offload(Executor blockingEx, Fn fn)
     {
         auto [ep, resultOpt] =
             co_await net::async_initiate<decltype(token), void(std::exception_ptr, std::optional<R>)>(
-                [ioEx, blockingEx, func = std::move(fn)](auto handler) mutable {
+                [ioEx, blockingEx, traced, func = std::move(fn)](auto handler) mutable {
 
                     using H  = std::decay_t<decltype(handler)>;
                     using St = OffloadState<H, R>;
@@ -143,8 +191,13 @@ auto async_offload(Executor blockingEx, Fn fn)
                         });
                     }
 
-                    net::post(blockingEx, [ioEx, st, func = std::move(func)]() mutable {
+                    OffloadMetrics::get().queued.inc();
+                    net::post(blockingEx, [ioEx, st, traced, func = std::move(func), queuedAt = std::chrono::steady_clock::now()]() mutable {
+                        const auto startedAt = OffloadMetrics::started(queuedAt);
+                        if (traced.context) traced.context->timings.add(trace::Phase::OffloadQueue, startedAt - queuedAt);
                         try {
+                            const trace::ThreadScope scope(traced);
+                            trace::Span run("offload.run");
                             if (!st->cancelled.load(std::memory_order_relaxed)) {
                                 st->result.emplace(func());
                             } else {
@@ -153,6 +206,8 @@ auto async_offload(Executor blockingEx, Fn fn)
                         } catch (...) {
                             st->ep = std::current_exception();
                         }
+                        OffloadMetrics::finished(startedAt);
+                        if (traced.context) traced.context->timings.add(trace::Phase::OffloadRun, std::chrono::steady_clock::now() - startedAt);
 
                         net::post(ioEx, [st]() mutable {
                             if (st->completed.exchange(true, std::memory_order_acq_rel))
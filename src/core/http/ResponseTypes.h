@@ -1,7 +1,10 @@
 #pragma once
 #include <boost/beast/http.hpp>
 #include <nlohmann/json.hpp>
+#include <exception>
+#include <type_traits>
 #include <variant>
+#include "core/errors/Errors.h"
 #include "core/response/Response.h"
 
 namespace http = boost::beast::http;
@@ -27,3 +30,25 @@ struct JsonResult {
 };
 
 using Outcome = std::variant<Response, JsonResult>;
+
+/// Status code the outcome is rendered with
+inline unsigned statusOf(const Outcome& outcome) {
+    return std::visit([]<typename T>(const T& value) -> unsigned {
+        if constexpr (std::is_same_v<T, Response>) {
+            return value.result_int();
+        } else {
+            return static_cast<unsigned>(value.status);
+        }
+    }, outcome);
+}
+
+/// Status code Router::handle renders for an exception escaping the middleware chain
+inline unsigned statusOf(const std::exception_ptr& error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const DbUnavailableError&) {
+        return static_cast<unsigned>(http::status::service_unavailable);
+    } catch (...) {
+        return static_cast<unsigned>(http::status::internal_server_error);
+    }
+}
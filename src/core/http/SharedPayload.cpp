@@ -0,0 +1,60 @@
+#include "core/http/SharedPayload.h"
+
+namespace {
+    constexpr std::string_view kCrlf = "\r\n";
+}
+
+std::shared_ptr<const SharedPayload> SharedPayload::make(
+    std::string body,
+    const std::vector<std::pair<http::field, std::string>>& headers
+) {
+    auto payload = std::make_shared<SharedPayload>();
+    for (const auto& [field, value] : headers) {
+        const auto name = http::to_string(field);
+        payload->headers.append(name.data(), name.size());
+        payload->headers += ": ";
+        payload->headers += value;
+        payload->headers += kCrlf;
+    }
+    payload->size = body.size();
+    payload->chunks.push_back(std::make_shared<const std::string>(std::move(body)));
+    return payload;
+}
+
+std::string SharedPayload::serializeHead(const http::response_header<>& header, const std::size_t contentLength) {
+    std::string head;
+    head.reserve(256);
+    head += header.version() == 10 ? "HTTP/1.0 " : "HTTP/1.1 ";
+    head += std::to_string(header.result_int());
+    head += ' ';
+    const auto reason = header.reason();
+    head.append(reason.data(), reason.size());
+    head += kCrlf;
+
+    for (const auto& field : header) {
+        if (field.name() == http::field::content_length) continue;
+        const auto name = field.name_string();
+        const auto value = field.value();
+        head.append(name.data(), name.size());
+        head += ": ";
+        head.append(value.data(), value.size());
+        head += kCrlf;
+    }
+
+    head += "Content-Length: ";
+    head += std::to_string(contentLength);
+    head += kCrlf;
+    return head;
+}
+
+std::vector<net::const_buffer> SharedPayload::buffers(const std::string& head, const bool withBody) const {
+    std::vector<net::const_buffer> out;
+    out.reserve(3 + (withBody ? chunks.size() : 0));
+    out.emplace_back(head.data(), head.size());
+    out.emplace_back(headers.data(), headers.size());
+    out.emplace_back(kCrlf.data(), kCrlf.size());
+    if (withBody) {
+        for (const auto& chunk : chunks) out.emplace_back(chunk->data(), chunk->size());
+    }
+    return out;
+}
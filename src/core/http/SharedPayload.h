@@ -0,0 +1,33 @@
+#pragma once
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/http.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace http = boost::beast::http;
+namespace net = boost::asio;
+
+/// Immutable response body (and its static headers) shared between responses.
+///
+/// Cache hits and static documents hand out the same payload: a response holds a shared_ptr,
+/// HttpSession writes header block and chunks with one gather write, nothing is copied.
+struct SharedPayload {
+    /// Pre-serialized "Name: value\r\n" lines, written after per-response fields
+    std::string headers;
+    std::vector<std::shared_ptr<const std::string>> chunks;
+    std::size_t size = 0;
+
+    /// Takes ownership of body, headers are serialized once here
+    static std::shared_ptr<const SharedPayload> make(
+        std::string body,
+        const std::vector<std::pair<http::field, std::string>>& headers
+    );
+
+    /// Status line + own fields of the response (Content-Length is ours) + Content-Length
+    static std::string serializeHead(const http::response_header<>& header, std::size_t contentLength);
+
+    /// Gather buffers: head, shared headers, CRLF and, unless omitted (HEAD), the chunks
+    [[nodiscard]] std::vector<net::const_buffer> buffers(const std::string& head, bool withBody) const;
+};
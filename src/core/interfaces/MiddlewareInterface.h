@@ -2,6 +2,7 @@
 #include "core/http/ResponseTypes.h"
 #include "core/request/Request.h"
 #include "core/http/interfaces/HttpInterface.h"
+#include "core/tracing/RequestTimings.h"
 #include <functional>
 
 struct MiddlewareInterface {
@@ -12,4 +13,6 @@ struct MiddlewareInterface {
     virtual net::awaitable<Response> after(const Request& request, Response&& response) {
         co_return std::move(response);
     }
+    /// Server-Timing / metrics phase its own time (without next()) is accounted to
+    [[nodiscard]] virtual trace::Phase phase() const noexcept { return trace::Phase::Middleware; }
 };
@@ -0,0 +1,28 @@
+#pragma once
+#include "core/loggers/LoggerSingleton.h"
+
+/// Leveled logging with typed fields:
+///
+///     LOG_INFO("UsersService::remove: called", {"id", id});
+///
+/// Nothing after the message is evaluated unless the level is enabled at runtime
+/// and the call site is admitted (see RateLimitedLogger),
+/// levels below APP_LOG_MIN_LEVEL (0 DEBUG, 1 INFO, 2 WARN, 3 ERROR) are compiled out.
+#ifndef APP_LOG_MIN_LEVEL
+#define APP_LOG_MIN_LEVEL 0
+#endif
+
+#define APP_LOG(level, msg, ...)                                                                         \
+    do {                                                                                                 \
+        if constexpr (static_cast<int>(level) >= APP_LOG_MIN_LEVEL) {                                    \
+            if (auto& appLogger_ = LoggerSingleton::get();                                               \
+                appLogger_.enabled(level) && appLogger_.admit(level, std::source_location::current())) { \
+                appLogger_.write(level, msg, std::initializer_list<LogField>{__VA_ARGS__});              \
+            }                                                                                            \
+        }                                                                                                \
+    } while (false)
+
+#define LOG_DEBUG(msg, ...) APP_LOG(LogLevel::DEBUG, msg __VA_OPT__(,) __VA_ARGS__)
+#define LOG_INFO(msg, ...)  APP_LOG(LogLevel::INFO, msg __VA_OPT__(,) __VA_ARGS__)
+#define LOG_WARN(msg, ...)  APP_LOG(LogLevel::WARN, msg __VA_OPT__(,) __VA_ARGS__)
+#define LOG_ERROR(msg, ...) APP_LOG(LogLevel::ERR, msg __VA_OPT__(,) __VA_ARGS__)
@@ -0,0 +1,55 @@
+#pragma once
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Typed key/value of a log record, no allocation and no std::any.
+/// Strings and lists are views: a field must not outlive the statement that logs it,
+/// asynchronous strategies copy what they keep.
+struct LogField {
+    enum class Kind : std::uint8_t { Null, Int, Uint, Double, Bool, String, IntList, StringList };
+
+    std::string_view key;
+    Kind kind = Kind::Null;
+    union {
+        std::int64_t i;
+        std::uint64_t u;
+        double d;
+        bool b;
+    };
+    std::string_view s;
+    std::span<const std::int64_t> ints;
+    std::span<const std::string> strings;
+
+    LogField(const std::string_view key, std::nullopt_t) : key(key), i(0) {}
+
+    template <std::signed_integral T>
+    LogField(const std::string_view key, const T value) : key(key), kind(Kind::Int), i(value) {}
+
+    template <std::unsigned_integral T>
+        requires (!std::same_as<T, bool>)
+    LogField(const std::string_view key, const T value) : key(key), kind(Kind::Uint), u(value) {}
+
+    LogField(const std::string_view key, const double value) : key(key), kind(Kind::Double), d(value) {}
+    LogField(const std::string_view key, const bool value) : key(key), kind(Kind::Bool), b(value) {}
+
+    LogField(const std::string_view key, const std::string_view value) : key(key), kind(Kind::String), i(0), s(value) {}
+    /// nullptr (a missing getenv() result, say) is a null field, never a view over it
+    LogField(const std::string_view key, const char* value)
+        : LogField(value ? LogField(key, std::string_view(value)) : LogField(key, std::nullopt)) {}
+    LogField(const std::string_view key, const std::string& value) : LogField(key, std::string_view(value)) {}
+
+    LogField(const std::string_view key, const std::vector<std::int64_t>& value)
+        : key(key), kind(Kind::IntList), i(0), ints(value) {}
+    LogField(const std::string_view key, const std::vector<std::string>& value)
+        : key(key), kind(Kind::StringList), i(0), strings(value) {}
+
+    /// Empty optional -> null, otherwise the contained value
+    template <class T>
+    LogField(const std::string_view key, const std::optional<T>& value)
+        : LogField(value ? LogField(key, *value) : LogField(key, std::nullopt)) {}
+};
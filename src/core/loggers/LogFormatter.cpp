@@ -0,0 +1,190 @@
+#include "core/loggers/LogFormatter.h"
+
+#include <charconv>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+const char* LogFormatter::levelToString(const LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG: return "DEBUG";
+        case LogLevel::INFO:  return "INFO";
+        case LogLevel::WARN:  return "WARN";
+        case LogLevel::ERR:   return "ERROR";
+    }
+    return "?";
+}
+
+void LogFormatter::append(
+    std::string& out,
+    const LogLevel level,
+    const std::chrono::system_clock::time_point timestamp,
+    const std::string_view msg,
+    const std::optional<std::map<std::string, std::any>>& params
+) {
+    appendHead(out, level, timestamp, msg);
+
+    if (params && !params->empty()) {
+        out += " | Params: ";
+        bool first = true;
+        for (const auto& [k, v] : *params) {
+            if (!first) out += ", ";
+            first = false;
+            out += k;
+            out += '=';
+            appendValue(out, v);
+        }
+    }
+    out += '\n';
+}
+
+void LogFormatter::append(
+    std::string& out,
+    const LogLevel level,
+    const std::chrono::system_clock::time_point timestamp,
+    const std::string_view msg,
+    const std::span<const LogField> fields
+) {
+    appendHead(out, level, timestamp, msg);
+
+    if (!fields.empty()) {
+        out += " | Params: ";
+        bool first = true;
+        for (const LogField& field : fields) {
+            if (!first) out += ", ";
+            first = false;
+            appendField(out, field);
+        }
+    }
+    out += '\n';
+}
+
+void LogFormatter::appendHead(
+    std::string& out,
+    const LogLevel level,
+    const std::chrono::system_clock::time_point timestamp,
+    const std::string_view msg
+) {
+    out += '[';
+    appendTimestamp(out, timestamp);
+    out += "] ";
+    out += levelToString(level);
+    out += ": ";
+    out += msg;
+}
+
+void LogFormatter::appendField(std::string& out, const LogField& field) {
+    out += field.key;
+    out += '=';
+    appendFieldValue(out, field);
+}
+
+void LogFormatter::appendFieldValue(std::string& out, const LogField& field) {
+    char buf[32];
+    switch (field.kind) {
+        case LogField::Kind::Null:
+            out += "null";
+            break;
+        case LogField::Kind::Int: {
+            const auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), field.i);
+            out.append(buf, end);
+            break;
+        }
+        case LogField::Kind::Uint: {
+            const auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), field.u);
+            out.append(buf, end);
+            break;
+        }
+        case LogField::Kind::Double: {
+            const auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), field.d);
+            out.append(buf, end);
+            break;
+        }
+        case LogField::Kind::Bool:
+            out += field.b ? "true" : "false";
+            break;
+        case LogField::Kind::String:
+            out += field.s;
+            break;
+        case LogField::Kind::IntList: {
+            bool first = true;
+            for (const std::int64_t v : field.ints) {
+                if (!first) out += ',';
+                first = false;
+                const auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), v);
+                out.append(buf, end);
+            }
+            break;
+        }
+        case LogField::Kind::StringList: {
+            bool first = true;
+            for (const std::string& v : field.strings) {
+                if (!first) out += ',';
+                first = false;
+                out += v;
+            }
+            break;
+        }
+    }
+}
+
+void LogFormatter::appendTimestamp(std::string& out, const std::chrono::system_clock::time_point timestamp) {
+    // localtime_r is the expensive part, one call per second per thread
+    thread_local std::time_t cachedSecond = -1;
+    thread_local char cached[32] = {};
+
+    const std::time_t t = std::chrono::system_clock::to_time_t(timestamp);
+    if (t != cachedSecond) {
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &t);
+#else
+        localtime_r(&t, &tm);
+#endif
+        std::strftime(cached, sizeof(cached), "%F %T", &tm);
+        cachedSecond = t;
+    }
+    out += cached;
+}
+
+namespace {
+    template <class T>
+    void appendJoined(std::string& out, const std::vector<T>& values) {
+        bool first = true;
+        for (const auto& v : values) {
+            if (!first) out += ',';
+            first = false;
+            if constexpr (std::is_same_v<T, std::string>) {
+                out += v;
+            } else {
+                out += std::to_string(v);
+            }
+        }
+    }
+}
+
+void LogFormatter::appendValue(std::string& out, const std::any& v) {
+    if (v.type() == typeid(std::string)) {
+        out += std::any_cast<const std::string&>(v);
+    } else if (v.type() == typeid(const char*)) {
+        out += std::any_cast<const char*>(v);
+    } else if (v.type() == typeid(int)) {
+        out += std::to_string(std::any_cast<int>(v));
+    } else if (v.type() == typeid(int64_t)) {
+        out += std::to_string(std::any_cast<int64_t>(v));
+    } else if (v.type() == typeid(std::size_t)) {
+        out += std::to_string(std::any_cast<std::size_t>(v));
+    } else if (v.type() == typeid(double)) {
+        out += std::to_string(std::any_cast<double>(v));
+    } else if (v.type() == typeid(bool)) {
+        out += std::any_cast<bool>(v) ? "true" : "false";
+    } else if (v.type() == typeid(std::vector<std::string>)) {
+        appendJoined(out, std::any_cast<const std::vector<std::string>&>(v));
+    } else if (v.type() == typeid(std::vector<int64_t>)) {
+        appendJoined(out, std::any_cast<const std::vector<int64_t>&>(v));
+    } else if (v.type() == typeid(std::vector<int>)) {
+        appendJoined(out, std::any_cast<const std::vector<int>&>(v));
+    } else {
+        out += "<unsupported>";
+    }
+}
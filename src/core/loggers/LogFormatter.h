@@ -0,0 +1,40 @@
+#pragma once
+#include "core/loggers/interfaces/LoggerInterface.h"
+
+#include <chrono>
+#include <span>
+#include <string>
+#include <string_view>
+
+/// Shared line format of all logger strategies:
+/// [YYYY-mm-dd HH:MM:SS] LEVEL: message | Params: k=v, k=v\n
+class LogFormatter {
+public:
+    static void append(
+        std::string& out,
+        LogLevel level,
+        std::chrono::system_clock::time_point timestamp,
+        std::string_view msg,
+        const std::optional<std::map<std::string, std::any>>& params
+    );
+
+    static void append(
+        std::string& out,
+        LogLevel level,
+        std::chrono::system_clock::time_point timestamp,
+        std::string_view msg,
+        std::span<const LogField> fields
+    );
+
+    /// key=value
+    static void appendField(std::string& out, const LogField& field);
+    /// value only, lists comma separated
+    static void appendFieldValue(std::string& out, const LogField& field);
+
+    static const char* levelToString(LogLevel level);
+
+private:
+    static void appendHead(std::string& out, LogLevel level, std::chrono::system_clock::time_point timestamp, std::string_view msg);
+    static void appendValue(std::string& out, const std::any& value);
+    static void appendTimestamp(std::string& out, std::chrono::system_clock::time_point timestamp);
+};
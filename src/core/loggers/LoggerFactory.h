@@ -1,16 +1,44 @@
 #pragma once
 #include "interfaces/LoggerInterface.h"
+#include "core/configs/EnvConfig.h"
+#include "core/loggers/RateLimitedLogger.h"
+#include "core/loggers/strategies/AsyncLoggerStrategy.h"
 #include "core/loggers/strategies/ConsoleLoggerStrategy.h"
+#include <algorithm>
 #include <memory>
+#include <stdexcept>
 #include <string>
 
 class LoggerFactory {
 public:
-    static std::shared_ptr<LoggerInterface> create(const std::string& type) {
+    /// Strategy for type, wrapped into RateLimitedLogger when LOG_RATE_LIMIT or LOG_INFO_SAMPLE ask for it
+    static std::shared_ptr<LoggerInterface> create(const std::string& type, const EnvConfig& env = {}) {
+        auto logger = createStrategy(type, env);
+        if (env.log_rate_limit == 0 && env.log_info_sample <= 1) return logger;
+
+        RateLimitedLogger::Options options;
+        options.ratePerSecond = env.log_rate_limit;
+        options.burst = std::max<double>(env.log_rate_burst, 1.0);
+        options.limitErrors = env.log_rate_limit_errors;
+        options.infoSampleEvery = std::max<std::uint32_t>(env.log_info_sample, 1);
+        return std::make_shared<RateLimitedLogger>(std::move(logger), options);
+    }
+
+private:
+    static std::shared_ptr<LoggerInterface> createStrategy(const std::string& type, const EnvConfig& env) {
         if (type == "console") {
             return std::make_shared<ConsoleLoggerStrategy>();
         }
-        // later maybe extended with "file", "syslog", "noop", etc.
+        if (type == "async") {
+            AsyncLoggerStrategy::Options options;
+            options.ringCapacity = env.log_ring_capacity;
+            options.overflow = AsyncLoggerStrategy::parseOverflow(env.log_overflow);
+            options.filePath = env.log_sink == "file" ? env.log_file : "";
+            options.maxFileBytes = env.log_file_max_bytes;
+            options.maxFiles = env.log_file_max_files;
+            return std::make_shared<AsyncLoggerStrategy>(std::move(options));
+        }
+        // later maybe extended with "syslog", "noop", etc.
         throw std::runtime_error("Unknown logger type: " + type);
     }
 };
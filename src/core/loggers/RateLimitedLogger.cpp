@@ -0,0 +1,60 @@
+#include "core/loggers/RateLimitedLogger.h"
+
+#include <algorithm>
+
+bool RateLimitedLogger::admit(const LogLevel level, const std::source_location& site) {
+    const SiteKey key{site.file_name(), site.line()};
+    Shard& shard = shards_[SiteKeyHash{}(key) % kShards];
+
+    std::uint64_t reportSuppressed = 0;
+    {
+        std::lock_guard lk(shard.m);
+        const auto now = std::chrono::steady_clock::now();
+        auto [it, inserted] = shard.sites.try_emplace(key);
+        Site& state = it->second;
+        if (inserted) {
+            state.tokens = options_.burst;
+            state.refilledAt = now;
+        }
+
+        // Sampled lines are intentional, they are counted but never summarized
+        if (level < LogLevel::WARN && options_.infoSampleEvery > 1 && state.calls++ % options_.infoSampleEvery != 0) {
+            ++shard.sampled;
+            return false;
+        }
+
+        if (options_.ratePerSecond > 0.0 && (level < LogLevel::ERR || options_.limitErrors)) {
+            const std::chrono::duration<double> elapsed = now - state.refilledAt;
+            state.tokens = std::min(options_.burst, state.tokens + elapsed.count() * options_.ratePerSecond);
+            state.refilledAt = now;
+
+            if (state.tokens < 1.0) {
+                ++state.suppressed;
+                ++shard.suppressed;
+                return false;
+            }
+            state.tokens -= 1.0;
+        }
+
+        reportSuppressed = std::exchange(state.suppressed, 0);
+    }
+
+    if (reportSuppressed > 0) {
+        inner_->write(level, "RateLimitedLogger: similar messages suppressed", {
+            {"file", site.file_name()},
+            {"line", site.line()},
+            {"suppressed", reportSuppressed}
+        });
+    }
+    return true;
+}
+
+RateLimitedLogger::Stats RateLimitedLogger::stats() const {
+    Stats total;
+    for (Shard& shard : shards_) {
+        std::lock_guard lk(shard.m);
+        total.suppressed += shard.suppressed;
+        total.sampled += shard.sampled;
+    }
+    return total;
+}
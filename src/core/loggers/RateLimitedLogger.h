@@ -0,0 +1,84 @@
+#pragma once
+#include "core/loggers/interfaces/LoggerInterface.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+/// Decorator keyed by call site (file:line of the LOG_* macro or of the info()/warn()/... call):
+///  - INFO/DEBUG: deterministic 1-in-N sampling per site;
+///  - WARN and below (ERROR too when limitErrors is set): token bucket per site, burst then ratePerSecond lines;
+///  - when a suppressed site is admitted again, a "similar messages suppressed" line with the count goes first.
+/// Admission happens before the message is formatted, a suppressed line costs one map lookup.
+class RateLimitedLogger final : public LoggerInterface {
+public:
+    struct Options {
+        /// Lines per second per site after the burst, 0 disables rate limiting
+        double ratePerSecond = 0.0;
+        double burst = 50.0;
+        /// ERROR lines pass the token bucket unless set
+        bool limitErrors = false;
+        /// Keep 1 of N INFO/DEBUG lines per site, 1 disables sampling
+        std::uint32_t infoSampleEvery = 1;
+    };
+
+    struct Stats {
+        std::uint64_t suppressed = 0;
+        std::uint64_t sampled = 0;
+    };
+
+    RateLimitedLogger(std::shared_ptr<LoggerInterface> inner, Options options)
+        : inner_(std::move(inner)), options_(options) {}
+
+    void log(LogLevel level, const std::string& msg, const std::optional<std::map<std::string, std::any>>& params) override {
+        inner_->log(level, msg, params);
+    }
+
+    void logFields(LogLevel level, std::string_view msg, std::span<const LogField> fields) override {
+        inner_->logFields(level, msg, fields);
+    }
+
+    bool admit(LogLevel level, const std::source_location& site) override;
+
+    [[nodiscard]] Stats stats() const;
+
+private:
+    /// By file name contents: the same header inlined into several translation units may carry
+    /// a different file_name() pointer in each of them
+    struct SiteKey {
+        std::string_view file;
+        std::uint_least32_t line;
+        bool operator==(const SiteKey&) const = default;
+    };
+
+    struct SiteKeyHash {
+        std::size_t operator()(const SiteKey& key) const noexcept {
+            return std::hash<std::string_view>{}(key.file) ^ (static_cast<std::size_t>(key.line) * 0x9E3779B97F4A7C15ull);
+        }
+    };
+
+    struct Site {
+        double tokens = 0.0;
+        std::chrono::steady_clock::time_point refilledAt;
+        std::uint64_t calls = 0;
+        std::uint64_t suppressed = 0;
+    };
+
+    /// Sites are spread over shards so unrelated call sites do not contend
+    struct Shard {
+        std::mutex m;
+        std::unordered_map<SiteKey, Site, SiteKeyHash> sites;
+        std::uint64_t suppressed = 0;
+        std::uint64_t sampled = 0;
+    };
+
+    static constexpr std::size_t kShards = 16;
+
+    std::shared_ptr<LoggerInterface> inner_;
+    const Options options_;
+    mutable std::array<Shard, kShards> shards_;
+};
@@ -1,8 +1,17 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <optional>
 #include <map>
 #include <any>
+#include <atomic>
+#include <initializer_list>
+#include <source_location>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "core/loggers/LogField.h"
 
 enum class LogLevel { DEBUG, INFO, WARN, ERR };
 
@@ -12,8 +21,66 @@ public:
 
     virtual void log(LogLevel level, const std::string& msg, const std::optional<std::map<std::string, std::any>>& params) = 0;
 
-    void info (const std::string& msg, const std::map<std::string, std::any>& params = {})
+    /// Typed fields (LOG_* macros). Strategies that only implement log() get them converted.
+    virtual void logFields(const LogLevel level, const std::string_view msg, const std::span<const LogField> fields)
+    {
+        if (fields.empty())
+        {
+            log(level, std::string(msg), std::nullopt);
+            return;
+        }
+        std::map<std::string, std::any> params;
+        for (const LogField& f : fields)
+        {
+            std::any value;
+            switch (f.kind) {
+                case LogField::Kind::Null:       value = std::string("null"); break;
+                case LogField::Kind::Int:        value = f.i; break;
+                case LogField::Kind::Uint:       value = static_cast<std::size_t>(f.u); break;
+                case LogField::Kind::Double:     value = f.d; break;
+                case LogField::Kind::Bool:       value = f.b; break;
+                case LogField::Kind::String:     value = std::string(f.s); break;
+                case LogField::Kind::IntList:    value = std::vector<int64_t>(f.ints.begin(), f.ints.end()); break;
+                case LogField::Kind::StringList: value = std::vector<std::string>(f.strings.begin(), f.strings.end()); break;
+            }
+            params.emplace(std::string(f.key), std::move(value));
+        }
+        log(level, std::string(msg), params);
+    }
+
+    void write(const LogLevel level, const std::string_view msg, const std::initializer_list<LogField> fields)
+    {
+        logFields(level, msg, std::span(fields.begin(), fields.size()));
+    }
+
+    /// Per call site admission (sampling, rate limiting), checked after enabled() and before
+    /// the message is built by LOG_* macros. Plain strategies admit everything.
+    virtual bool admit(LogLevel /*level*/, const std::source_location& /*site*/) { return true; }
+
+    /// Runtime threshold, LOG_* macros check it before evaluating any argument
+    [[nodiscard]] bool enabled(const LogLevel level) const noexcept
+    {
+        return level >= level_.load(std::memory_order_relaxed);
+    }
+    void setLevel(const LogLevel level) noexcept { level_.store(level, std::memory_order_relaxed); }
+    [[nodiscard]] LogLevel level() const noexcept { return level_.load(std::memory_order_relaxed); }
+
+    static LogLevel parseLevel(const std::string& value)
     {
+        if (value == "debug") return LogLevel::DEBUG;
+        if (value == "info") return LogLevel::INFO;
+        if (value == "warn") return LogLevel::WARN;
+        if (value == "error") return LogLevel::ERR;
+        throw std::runtime_error("Unknown log level: " + value);
+    }
+
+    void info (
+        const std::string& msg,
+        const std::map<std::string, std::any>& params = {},
+        const std::source_location& site = std::source_location::current()
+    )
+    {
+        if (!enabled(LogLevel::INFO) || !admit(LogLevel::INFO, site)) return;
         if (params.empty())
         {
             log(LogLevel::INFO, msg, std::nullopt);
@@ -21,8 +88,13 @@ public:
         }
         log(LogLevel::INFO, msg, params);
     }
-    void debug(const std::string& msg, const std::map<std::string, std::any>& params = {})
+    void debug(
+        const std::string& msg,
+        const std::map<std::string, std::any>& params = {},
+        const std::source_location& site = std::source_location::current()
+    )
     {
+        if (!enabled(LogLevel::DEBUG) || !admit(LogLevel::DEBUG, site)) return;
         if (params.empty())
         {
             log(LogLevel::DEBUG, msg, std::nullopt);
@@ -30,8 +102,13 @@ public:
         }
         log(LogLevel::DEBUG, msg, params);
     }
-    void warn (const std::string& msg, const std::map<std::string, std::any>& params = {})
+    void warn (
+        const std::string& msg,
+        const std::map<std::string, std::any>& params = {},
+        const std::source_location& site = std::source_location::current()
+    )
     {
+        if (!enabled(LogLevel::WARN) || !admit(LogLevel::WARN, site)) return;
         if (params.empty())
         {
             log(LogLevel::WARN, msg, std::nullopt);
@@ -39,8 +116,13 @@ public:
         }
         log(LogLevel::WARN, msg, params);
     }
-    void error(const std::string& msg, const std::map<std::string, std::any>& params = {})
+    void error(
+        const std::string& msg,
+        const std::map<std::string, std::any>& params = {},
+        const std::source_location& site = std::source_location::current()
+    )
     {
+        if (!enabled(LogLevel::ERR) || !admit(LogLevel::ERR, site)) return;
         if (params.empty())
         {
             log(LogLevel::ERR, msg, std::nullopt);
@@ -48,4 +130,7 @@ public:
         }
         log(LogLevel::ERR, msg, params);
     }
+
+private:
+    std::atomic<LogLevel> level_{LogLevel::DEBUG};
 };
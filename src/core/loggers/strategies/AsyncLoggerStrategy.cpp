@@ -0,0 +1,421 @@
+#include "core/loggers/strategies/AsyncLoggerStrategy.h"
+#include "core/loggers/LogFormatter.h"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <climits>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    std::atomic<std::uint64_t> nextLoggerId{1};
+
+    /// Formatted records are packed into chunks of about this size, one iovec each
+    constexpr std::size_t kChunkBytes = 64 * 1024;
+
+#ifdef _WIN32
+    constexpr int kMaxIov = 64;
+#else
+    constexpr int kMaxIov = IOV_MAX;
+#endif
+
+    constexpr auto kLossReportInterval = std::chrono::seconds(1);
+}
+
+/// Rings created by the current thread, one per logger instance.
+/// Its destructor runs on thread exit and hands the rings over to the writer for the last drain.
+class AsyncLoggerStrategy::ThreadRings {
+public:
+    ~ThreadRings() {
+        for (const auto& [id, ring] : rings_) ring->closed.store(true, std::memory_order_release);
+    }
+
+    Ring* find(const std::uint64_t id) const {
+        for (const auto& [ringId, ring] : rings_) {
+            if (ringId == id) return ring.get();
+        }
+        return nullptr;
+    }
+
+    void add(const std::uint64_t id, std::shared_ptr<Ring> ring) {
+        rings_.emplace_back(id, std::move(ring));
+    }
+
+private:
+    std::vector<std::pair<std::uint64_t, std::shared_ptr<Ring>>> rings_;
+};
+
+AsyncLoggerStrategy::Ring::Ring(const std::size_t capacity)
+    : slots(std::bit_ceil(std::max<std::size_t>(capacity, 2))), mask(slots.size() - 1) {}
+
+AsyncLoggerStrategy::AsyncLoggerStrategy(Options options)
+    : id_(nextLoggerId.fetch_add(1, std::memory_order_relaxed)), options_(std::move(options)) {
+    if (!options_.filePath.empty()) openFile();
+    writer_ = std::thread([this] { run(); });
+}
+
+AsyncLoggerStrategy::~AsyncLoggerStrategy() {
+    stopping_.store(true, std::memory_order_release);
+    if (writer_.joinable()) writer_.join();
+#ifndef _WIN32
+    if (fd_ >= 0) ::close(fd_);
+#endif
+}
+
+AsyncLoggerStrategy::Overflow AsyncLoggerStrategy::parseOverflow(const std::string& value) {
+    if (value == "drop") return Overflow::Drop;
+    if (value == "block") return Overflow::Block;
+    if (value == "sample") return Overflow::Sample;
+    throw std::runtime_error("Unknown log overflow policy: " + value);
+}
+
+AsyncLoggerStrategy::Stats AsyncLoggerStrategy::stats() const noexcept {
+    return Stats{
+        written_.load(std::memory_order_relaxed),
+        dropped_.load(std::memory_order_relaxed),
+        sampled_.load(std::memory_order_relaxed)
+    };
+}
+
+template <class Fill>
+bool AsyncLoggerStrategy::push(Ring& ring, Fill& fill) {
+    const std::size_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) >= ring.slots.size()) return false;
+
+    // Slot strings keep their capacity between laps, assign() reuses it
+    Record& slot = ring.slots[head & ring.mask];
+    fill(slot);
+    slot.timestamp = std::chrono::system_clock::now();
+
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    ring.head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template <class Fill>
+void AsyncLoggerStrategy::enqueue(const LogLevel level, Fill&& fill) {
+    Ring& ring = localRing();
+
+    if (options_.overflow == Overflow::Sample && level < LogLevel::WARN) {
+        const std::size_t used = ring.head.load(std::memory_order_relaxed) - ring.tail.load(std::memory_order_acquire);
+        if (used * 4 >= ring.slots.size() * 3 && ring.sampleCounter++ % options_.sampleEvery != 0) {
+            sampled_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    if (push(ring, fill)) return;
+
+    if (options_.overflow == Overflow::Block) {
+        // Writer may be gone during shutdown, then fall through to drop
+        while (!stopping_.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            if (push(ring, fill)) return;
+        }
+    }
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AsyncLoggerStrategy::log(
+    const LogLevel level,
+    const std::string& msg,
+    const std::optional<std::map<std::string, std::any>>& params
+) {
+    enqueue(level, [&](Record& slot) {
+        slot.level = level;
+        slot.msg.assign(msg);
+        slot.params = params;
+        slot.fieldCount = 0;
+    });
+}
+
+void AsyncLoggerStrategy::logFields(const LogLevel level, const std::string_view msg, const std::span<const LogField> fields) {
+    enqueue(level, [&](Record& slot) {
+        slot.level = level;
+        slot.msg.assign(msg);
+        slot.params.reset();
+        storeFields(slot, fields);
+    });
+}
+
+void AsyncLoggerStrategy::storeFields(Record& record, const std::span<const LogField> fields) {
+    record.text.clear();
+    record.fieldCount = static_cast<std::uint8_t>(std::min(fields.size(), kMaxFields));
+    record.spill.resize(record.fieldCount > kInlineFields ? record.fieldCount - kInlineFields : 0);
+
+    for (std::size_t n = 0; n < record.fieldCount; ++n) {
+        const LogField& field = fields[n];
+        StoredField& stored = record.field(n);
+
+        stored.kind = field.kind;
+        stored.keyOffset = static_cast<std::uint32_t>(record.text.size());
+        stored.keyLength = static_cast<std::uint32_t>(field.key.size());
+        record.text += field.key;
+
+        switch (field.kind) {
+            case LogField::Kind::Null:   break;
+            case LogField::Kind::Int:    stored.i = field.i; break;
+            case LogField::Kind::Uint:   stored.u = field.u; break;
+            case LogField::Kind::Double: stored.d = field.d; break;
+            case LogField::Kind::Bool:   stored.b = field.b; break;
+            case LogField::Kind::String:
+            case LogField::Kind::IntList:
+            case LogField::Kind::StringList: {
+                // Views die with the caller's statement: copy, lists rendered right away
+                stored.kind = LogField::Kind::String;
+                stored.textOffset = static_cast<std::uint32_t>(record.text.size());
+                LogFormatter::appendFieldValue(record.text, field);
+                stored.textLength = static_cast<std::uint32_t>(record.text.size() - stored.textOffset);
+                break;
+            }
+        }
+    }
+}
+
+void AsyncLoggerStrategy::formatRecord(std::string& out, const Record& record) {
+    if (record.fieldCount == 0) {
+        LogFormatter::append(out, record.level, record.timestamp, record.msg, record.params);
+        return;
+    }
+
+    const std::string_view text = record.text;
+    scratch_.clear();
+    for (std::size_t n = 0; n < record.fieldCount; ++n) {
+        const StoredField& stored = record.field(n);
+        LogField& field = scratch_.emplace_back(text.substr(stored.keyOffset, stored.keyLength), std::nullopt);
+        field.kind = stored.kind;
+        switch (stored.kind) {
+            case LogField::Kind::Int:    field.i = stored.i; break;
+            case LogField::Kind::Uint:   field.u = stored.u; break;
+            case LogField::Kind::Double: field.d = stored.d; break;
+            case LogField::Kind::Bool:   field.b = stored.b; break;
+            case LogField::Kind::String: field.s = text.substr(stored.textOffset, stored.textLength); break;
+            default: break;
+        }
+    }
+    LogFormatter::append(out, record.level, record.timestamp, record.msg, std::span<const LogField>(scratch_));
+}
+
+AsyncLoggerStrategy::Ring& AsyncLoggerStrategy::localRing() {
+    thread_local ThreadRings threadRings;
+
+    if (Ring* ring = threadRings.find(id_)) return *ring;
+
+    auto ring = std::make_shared<Ring>(options_.ringCapacity);
+    threadRings.add(id_, ring);
+    {
+        std::lock_guard lk(ringsMutex_);
+        rings_.push_back(ring);
+    }
+    ringsVersion_.fetch_add(1, std::memory_order_release);
+    return *ring;
+}
+
+void AsyncLoggerStrategy::run() {
+    std::vector<std::shared_ptr<Ring>> rings;
+    std::uint64_t version = 0;
+    std::vector<std::string> chunks;
+    Stats reported;
+    auto lastReport = std::chrono::steady_clock::now();
+    auto idle = std::chrono::microseconds(50);
+
+    for (;;) {
+        const bool stopping = stopping_.load(std::memory_order_acquire);
+
+        if (const auto current = ringsVersion_.load(std::memory_order_acquire); current != version) {
+            std::lock_guard lk(ringsMutex_);
+            rings = rings_;
+            version = current;
+        }
+
+        const std::size_t written = drain(rings, chunks);
+
+        if (const auto now = std::chrono::steady_clock::now(); now - lastReport >= kLossReportInterval || stopping) {
+            reportLosses(chunks, reported);
+            lastReport = now;
+        }
+        write(chunks);
+        settle(written);
+
+        // Rings of exited threads are dropped once empty. rings_ stays the source of truth: only the rings
+        // removed here are erased from it, a ring registered since the snapshot is picked up on the next pass
+        if (const auto removed = std::partition(rings.begin(), rings.end(), [](const auto& ring) {
+            return !ring->closed.load(std::memory_order_acquire)
+                || ring->tail.load(std::memory_order_relaxed) != ring->head.load(std::memory_order_acquire);
+        }); removed != rings.end()) {
+            {
+                std::lock_guard lk(ringsMutex_);
+                std::erase_if(rings_, [&](const auto& ring) {
+                    return std::find(removed, rings.end(), ring) != rings.end();
+                });
+            }
+            rings.erase(removed, rings.end());
+        }
+
+        if (stopping) {
+            // Producers might have pushed after the last pass
+            const std::size_t late = drain(rings, chunks);
+            if (late == 0) break;
+            write(chunks);
+            settle(late);
+            continue;
+        }
+
+        if (written > 0) {
+            idle = std::chrono::microseconds(50);
+            continue;
+        }
+        std::this_thread::sleep_for(idle);
+        idle = std::min<std::chrono::microseconds>(idle * 2, options_.maxIdle);
+    }
+}
+
+std::size_t AsyncLoggerStrategy::drain(std::vector<std::shared_ptr<Ring>>& rings, std::vector<std::string>& chunks) {
+    std::size_t count = 0;
+    for (const auto& ring : rings) {
+        std::size_t tail = ring->tail.load(std::memory_order_relaxed);
+        const std::size_t head = ring->head.load(std::memory_order_acquire);
+
+        for (; tail != head; ++tail) {
+            if (chunks.empty() || chunks.back().size() >= kChunkBytes) {
+                chunks.emplace_back().reserve(kChunkBytes + 512);
+            }
+            formatRecord(chunks.back(), ring->slots[tail & ring->mask]);
+            ++count;
+        }
+        // Formatted copy is ours, slots may be reused right away
+        ring->tail.store(tail, std::memory_order_release);
+    }
+    return count;
+}
+
+void AsyncLoggerStrategy::reportLosses(std::vector<std::string>& chunks, Stats& reported) {
+    const Stats current = stats();
+    if (current.dropped == reported.dropped && current.sampled == reported.sampled) return;
+
+    if (chunks.empty()) chunks.emplace_back();
+    LogFormatter::append(chunks.back(), LogLevel::WARN, std::chrono::system_clock::now(),
+        "AsyncLoggerStrategy: records lost on overflow", std::map<std::string, std::any>{
+            {"dropped", static_cast<int64_t>(current.dropped - reported.dropped)},
+            {"sampled", static_cast<int64_t>(current.sampled - reported.sampled)},
+            {"dropped_total", static_cast<int64_t>(current.dropped)}
+        });
+    reported = current;
+}
+
+void AsyncLoggerStrategy::write(std::vector<std::string>& chunks) {
+    if (chunks.empty()) return;
+
+    std::size_t total = 0;
+    for (const auto& chunk : chunks) total += chunk.size();
+
+    if (fd_ >= 0 && options_.maxFileBytes > 0 && fileSize_ > 0 && fileSize_ + total > options_.maxFileBytes) {
+        rotate();
+    }
+
+#ifdef _WIN32
+    for (const auto& chunk : chunks) {
+        std::fwrite(chunk.data(), 1, chunk.size(), stderr);
+    }
+    std::fflush(stderr);
+#else
+    const int fd = fd_ >= 0 ? fd_ : STDERR_FILENO;
+    std::vector<iovec> iov;
+    iov.reserve(chunks.size());
+    for (auto& chunk : chunks) {
+        if (!chunk.empty()) iov.push_back(iovec{chunk.data(), chunk.size()});
+    }
+
+    std::size_t first = 0;
+    while (first < iov.size()) {
+        const int count = static_cast<int>(std::min<std::size_t>(iov.size() - first, kMaxIov));
+        const ssize_t n = ::writev(fd, iov.data() + first, count);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            // Nowhere to report a failing log sink: lose the batch, keep the writer alive
+            break;
+        }
+        fileSize_ += static_cast<std::uint64_t>(n);
+
+        // Partial write: skip fully written buffers, shift into the first unfinished one
+        auto left = static_cast<std::size_t>(n);
+        while (first < iov.size() && left >= iov[first].iov_len) {
+            left -= iov[first].iov_len;
+            ++first;
+        }
+        if (left > 0) {
+            iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+            iov[first].iov_len -= left;
+        }
+    }
+#endif
+
+    // Keep one chunk's capacity around for the next pass
+    chunks.resize(1);
+    chunks.front().clear();
+    if (chunks.front().capacity() < kChunkBytes) chunks.clear();
+}
+
+void AsyncLoggerStrategy::settle(const std::size_t records) {
+    written_.fetch_add(records, std::memory_order_relaxed);
+    pending_.fetch_sub(records, std::memory_order_release);
+}
+
+void AsyncLoggerStrategy::flush() {
+    while (pending_.load(std::memory_order_acquire) > 0 && !stopping_.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+void AsyncLoggerStrategy::openFile() {
+#ifdef _WIN32
+    throw std::runtime_error("AsyncLoggerStrategy: file sink is not supported on Windows");
+#else
+    fd_ = ::open(options_.filePath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::system_error(errno, std::generic_category(), "AsyncLoggerStrategy: cannot open " + options_.filePath);
+    }
+    const off_t size = ::lseek(fd_, 0, SEEK_END);
+    fileSize_ = size > 0 ? static_cast<std::uint64_t>(size) : 0;
+#endif
+}
+
+/// path -> path.1 -> ... -> path.{maxFiles}, the oldest one is removed
+void AsyncLoggerStrategy::rotate() {
+#ifndef _WIN32
+    namespace fs = std::filesystem;
+    std::error_code ec;
+
+    ::close(fd_);
+    fd_ = -1;
+
+    const std::string& path = options_.filePath;
+    if (options_.maxFiles == 0) {
+        fs::remove(path, ec);
+    } else {
+        fs::remove(path + "." + std::to_string(options_.maxFiles), ec);
+        for (std::size_t i = options_.maxFiles - 1; i >= 1; --i) {
+            fs::rename(path + "." + std::to_string(i), path + "." + std::to_string(i + 1), ec);
+        }
+        fs::rename(path, path + ".1", ec);
+    }
+
+    try {
+        openFile();
+    } catch (const std::exception&) {
+        // Fall back to stderr rather than losing every following line
+        fd_ = -1;
+    }
+#endif
+}
@@ -0,0 +1,162 @@
+#pragma once
+#include "core/loggers/interfaces/LoggerInterface.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Callers never touch a file descriptor: every thread pushes records into its own
+/// single-producer ring, one background thread drains all rings, formats and writes
+/// the batch with a single writev() to stderr or to a rotating file.
+class AsyncLoggerStrategy final : public LoggerInterface {
+public:
+    /// What a producer does when its ring is full
+    enum class Overflow {
+        /// Record is discarded and counted
+        Drop,
+        /// Caller waits for the writer (never loses a line, may stall the I/O thread)
+        Block,
+        /// Above 3/4 of capacity only WARN/ERROR and every sampleEvery-th other record are kept
+        Sample
+    };
+
+    struct Options {
+        /// Records per thread, rounded up to a power of two
+        std::size_t ringCapacity = 8192;
+        Overflow overflow = Overflow::Drop;
+        std::size_t sampleEvery = 10;
+        /// Empty -> stderr
+        std::string filePath;
+        /// Rotation threshold for the file sink, 0 disables rotation
+        std::uint64_t maxFileBytes = 64ull * 1024 * 1024;
+        /// Rotated files kept next to the active one: path.1 ... path.N
+        std::size_t maxFiles = 5;
+        /// Longest idle sleep of the writer thread
+        std::chrono::milliseconds maxIdle{5};
+    };
+
+    struct Stats {
+        std::uint64_t written = 0;
+        std::uint64_t dropped = 0;
+        std::uint64_t sampled = 0;
+    };
+
+    explicit AsyncLoggerStrategy(Options options);
+    ~AsyncLoggerStrategy() override;
+
+    AsyncLoggerStrategy(const AsyncLoggerStrategy&) = delete;
+    AsyncLoggerStrategy& operator=(const AsyncLoggerStrategy&) = delete;
+
+    void log(LogLevel level, const std::string& msg, const std::optional<std::map<std::string, std::any>>& params) override;
+    /// Fields are copied into the ring slot, no allocation once the slot has warmed up
+    void logFields(LogLevel level, std::string_view msg, std::span<const LogField> fields) override;
+
+    /// Blocks until everything pushed before the call is written
+    void flush();
+
+    [[nodiscard]] Stats stats() const noexcept;
+
+    static Overflow parseOverflow(const std::string& value);
+
+private:
+    /// Fields beyond this are not recorded
+    static constexpr std::size_t kMaxFields = 16;
+    /// Fields kept in the slot itself, the rest spill into Record::spill
+    static constexpr std::size_t kInlineFields = 4;
+
+    /// LogField with its strings moved into Record::text, lists are rendered to a string
+    struct StoredField {
+        LogField::Kind kind = LogField::Kind::Null;
+        std::uint32_t keyOffset = 0;
+        std::uint32_t keyLength = 0;
+        std::uint32_t textOffset = 0;
+        std::uint32_t textLength = 0;
+        union {
+            std::int64_t i = 0;
+            std::uint64_t u;
+            double d;
+            bool b;
+        };
+    };
+
+    /// Slots are preallocated for the whole ring: keep them small, a few hundred bytes
+    /// each plus the warmed-up capacity of the strings
+    struct Record {
+        LogLevel level = LogLevel::INFO;
+        std::chrono::system_clock::time_point timestamp;
+        std::string msg;
+        /// Legacy map API
+        std::optional<std::map<std::string, std::any>> params;
+        std::array<StoredField, kInlineFields> fields{};
+        /// Fields past kInlineFields, keeps its capacity between laps
+        std::vector<StoredField> spill;
+        std::uint8_t fieldCount = 0;
+        /// Keys and string values of fields
+        std::string text;
+
+        StoredField& field(const std::size_t n) { return n < kInlineFields ? fields[n] : spill[n - kInlineFields]; }
+        const StoredField& field(const std::size_t n) const { return n < kInlineFields ? fields[n] : spill[n - kInlineFields]; }
+    };
+
+    /// SPSC ring: the owning thread advances head, the writer advances tail
+    struct Ring {
+        explicit Ring(std::size_t capacity);
+
+        std::vector<Record> slots;
+        std::size_t mask;
+        alignas(64) std::atomic<std::size_t> head{0};
+        alignas(64) std::atomic<std::size_t> tail{0};
+        /// Owning thread exited: the writer removes the ring once it is drained
+        std::atomic<bool> closed{false};
+        /// Producer-only, Sample policy
+        std::uint64_t sampleCounter = 0;
+    };
+
+    class ThreadRings;
+
+    const std::uint64_t id_;
+    const Options options_;
+
+    std::mutex ringsMutex_;
+    std::vector<std::shared_ptr<Ring>> rings_;
+    std::atomic<std::uint64_t> ringsVersion_{0};
+
+    std::atomic<std::uint64_t> written_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> sampled_{0};
+    std::atomic<std::uint64_t> pending_{0};
+
+    std::atomic<bool> stopping_{false};
+    int fd_ = -1;
+    std::uint64_t fileSize_ = 0;
+    std::thread writer_;
+
+    /// Writer thread only
+    std::vector<LogField> scratch_;
+
+    Ring& localRing();
+    /// Applies the overflow policy, fill(Record&) writes the slot
+    template <class Fill>
+    void enqueue(LogLevel level, Fill&& fill);
+    template <class Fill>
+    bool push(Ring& ring, Fill& fill);
+    static void storeFields(Record& record, std::span<const LogField> fields);
+    void formatRecord(std::string& out, const Record& record);
+
+    void run();
+    /// One pass over all rings, returns records written
+    std::size_t drain(std::vector<std::shared_ptr<Ring>>& rings, std::vector<std::string>& chunks);
+    void reportLosses(std::vector<std::string>& chunks, Stats& reported);
+    void write(std::vector<std::string>& chunks);
+    /// Counts records as written once their batch reached the sink
+    void settle(std::size_t records);
+
+    void openFile();
+    void rotate();
+};
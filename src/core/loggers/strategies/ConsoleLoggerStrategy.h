@@ -1,76 +1,31 @@
 #pragma once
 #include "core/loggers/interfaces/LoggerInterface.h"
+#include "core/loggers/LogFormatter.h"
 #include <iostream>
 #include <chrono>
-#include <iomanip>
-#include <boost/algorithm/string/join.hpp>
 #include <mutex>
-#include <ctime>
 
+/// Synchronous, one locked write per line. Fine for tools and tests, see AsyncLoggerStrategy for the server
 class ConsoleLoggerStrategy final : public LoggerInterface {
 public:
     void log(const LogLevel level, const std::string& msg, const std::optional<std::map<std::string, std::any>>& params) override {
-        std::lock_guard lk(m_);
-
-        const auto now = std::chrono::system_clock::now();
-        const auto t   = std::chrono::system_clock::to_time_t(now);
+        std::string line;
+        LogFormatter::append(line, level, std::chrono::system_clock::now(), msg, params);
 
-        std::tm tm{};
-#ifdef _WIN32
-        localtime_s(&tm, &t);
-#else
-        localtime_r(&t, &tm);
-#endif
-
-        std::ostringstream oss;
-        oss << "[" << std::put_time(&tm, "%F %T") << "] "
-            << levelToString(level) << ": " << msg;
+        std::lock_guard lk(m_);
+        std::cerr.write(line.data(), static_cast<std::streamsize>(line.size()));
+        std::cerr.flush();
+    }
 
-        if (params && !params->empty()) {
-            oss << " | Params: ";
-            bool first = true;
-            for (const auto& [k, v] : *params) {
-                if (!first) oss << ", ";
-                first = false;
+    void logFields(const LogLevel level, const std::string_view msg, const std::span<const LogField> fields) override {
+        std::string line;
+        LogFormatter::append(line, level, std::chrono::system_clock::now(), msg, fields);
 
-                if (v.type() == typeid(std::string)) {
-                    oss << k << '=' << std::any_cast<const std::string&>(v);
-                } else if (v.type() == typeid(int)) {
-                    oss << k << '=' << std::any_cast<int>(v);
-                } else if (v.type() == typeid(int64_t)) {
-                    oss << k << '=' << std::any_cast<int64_t>(v);
-                } else if (v.type() == typeid(std::vector<std::string>)){
-                    const auto& vec = std::any_cast<const std::vector<std::string>&>(v);
-                    oss << k << "=" << boost::algorithm::join(vec, ",");
-                } else if (v.type() == typeid(std::vector<int64_t>)){
-                    const auto& vec = std::any_cast<const std::vector<int64_t>&>(v);
-                    std::vector<std::string> strs;
-                    strs.reserve(vec.size());
-                    for (auto x : vec) strs.push_back(std::to_string(x));
-                    oss << k << "=" << boost::algorithm::join(strs, ",");
-                } else if (v.type() == typeid(std::vector<int>)){
-                    const auto& vec = std::any_cast<const std::vector<int>&>(v);
-                    std::vector<std::string> strs;
-                    strs.reserve(vec.size());
-                    for (auto x : vec) strs.push_back(std::to_string(x));
-                    oss << k << "=" << boost::algorithm::join(strs, ",");
-                } else {
-                    oss << k << "=<unsupported>";
-                }
-            }
-        }
-        std::cerr << oss.str() << std::endl;
+        std::lock_guard lk(m_);
+        std::cerr.write(line.data(), static_cast<std::streamsize>(line.size()));
+        std::cerr.flush();
     }
 
 private:
     inline static std::mutex m_;
-    static std::string levelToString(const LogLevel level) {
-        switch (level) {
-            case LogLevel::DEBUG: return "DEBUG";
-            case LogLevel::INFO:  return "INFO";
-            case LogLevel::WARN:  return "WARN";
-            case LogLevel::ERR: return "ERROR";
-        }
-        return "?";
-    }
 };
@@ -0,0 +1,70 @@
+#include "core/metrics/HdrHistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace metrics {
+    std::size_t HdrHistogram::bucketFor(const std::uint64_t value) noexcept {
+        if (value < kSubBuckets) return static_cast<std::size_t>(value);
+
+        const auto exponent = static_cast<std::uint32_t>(std::bit_width(value) - 1);
+        if (exponent > kMaxExponent) return kBuckets - 1;
+
+        // Top kSubBucketBits bits below the leading one select the sub-bucket
+        const auto sub = static_cast<std::size_t>((value >> (exponent - kSubBucketBits)) & (kSubBuckets - 1));
+        return kSubBuckets + (exponent - kSubBucketBits) * kSubBuckets + sub;
+    }
+
+    std::uint64_t HdrHistogram::upperBound(const std::size_t bucket) noexcept {
+        if (bucket < kSubBuckets) return bucket;
+
+        const std::size_t exponent = (bucket - kSubBuckets) / kSubBuckets + kSubBucketBits;
+        const std::size_t sub = (bucket - kSubBuckets) % kSubBuckets;
+        const std::uint64_t width = std::uint64_t{1} << (exponent - kSubBucketBits);
+        const std::uint64_t lower = (std::uint64_t{kSubBuckets} + sub) * width;
+        return lower + width - 1;
+    }
+
+    void HdrHistogram::record(const std::uint64_t value, const std::uint64_t times) noexcept {
+        counts_[bucketFor(value)] += times;
+        count_ += times;
+        sum_ += value * times;
+        max_ = std::max(max_, value);
+    }
+
+    void HdrHistogram::addBucket(const std::size_t bucket, const std::uint64_t count) noexcept {
+        if (count == 0) return;
+        counts_[bucket] += count;
+        count_ += count;
+        max_ = std::max(max_, upperBound(bucket));
+    }
+
+    void HdrHistogram::merge(const HdrHistogram& other) noexcept {
+        for (std::size_t i = 0; i < kBuckets; ++i) counts_[i] += other.counts_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    void HdrHistogram::reset() noexcept {
+        std::ranges::fill(counts_, 0);
+        count_ = sum_ = max_ = 0;
+    }
+
+    double HdrHistogram::mean() const noexcept {
+        return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0;
+    }
+
+    std::uint64_t HdrHistogram::percentile(const double p) const noexcept {
+        if (count_ == 0) return 0;
+
+        const auto rank = static_cast<std::uint64_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(count_)));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += counts_[i];
+            if (seen >= std::max<std::uint64_t>(rank, 1)) return std::min(upperBound(i), max_);
+        }
+        return max_;
+    }
+}
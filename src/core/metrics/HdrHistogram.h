@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace metrics {
+    /// Log-linear buckets in the spirit of HdrHistogram: values below kSubBuckets are exact,
+    /// above that every power of two is split into kSubBuckets equal buckets (~12.5% relative error).
+    /// Values are integers in the caller's unit (microseconds for latencies), anything above
+    /// 2^kMaxExponent lands in the last bucket.
+    class HdrHistogram {
+    public:
+        static constexpr std::uint32_t kSubBucketBits = 3;
+        static constexpr std::uint32_t kSubBuckets = 1u << kSubBucketBits;
+        static constexpr std::uint32_t kMaxExponent = 36;
+        static constexpr std::size_t kBuckets = kSubBuckets + (kMaxExponent - kSubBucketBits + 1) * kSubBuckets;
+
+        static std::size_t bucketFor(std::uint64_t value) noexcept;
+        /// Highest value that lands in the bucket
+        static std::uint64_t upperBound(std::size_t bucket) noexcept;
+
+        HdrHistogram() : counts_(kBuckets, 0) {}
+
+        void record(std::uint64_t value, std::uint64_t times = 1) noexcept;
+        void addBucket(std::size_t bucket, std::uint64_t count) noexcept;
+        void merge(const HdrHistogram& other) noexcept;
+        void reset() noexcept;
+
+        [[nodiscard]] std::uint64_t count() const noexcept { return count_; }
+        [[nodiscard]] std::uint64_t sum() const noexcept { return sum_; }
+        [[nodiscard]] std::uint64_t max() const noexcept { return max_; }
+        void setSum(const std::uint64_t sum) noexcept { sum_ = sum; }
+        [[nodiscard]] double mean() const noexcept;
+        /// p in [0, 100], upper bound of the bucket holding the p-th percentile
+        [[nodiscard]] std::uint64_t percentile(double p) const noexcept;
+        [[nodiscard]] const std::vector<std::uint64_t>& buckets() const noexcept { return counts_; }
+
+    private:
+        std::vector<std::uint64_t> counts_;
+        std::uint64_t count_ = 0;
+        std::uint64_t sum_ = 0;
+        std::uint64_t max_ = 0;
+    };
+}
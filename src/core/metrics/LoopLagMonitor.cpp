@@ -0,0 +1,239 @@
+#include "core/metrics/LoopLagMonitor.h"
+#include "core/loggers/Log.h"
+#include "core/loggers/LoggerSingleton.h"
+#include "core/metrics/MetricsRegistry.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <execinfo.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace metrics {
+    namespace {
+        constexpr int kMaxFrames = 64;
+
+        /// Filled by the signal handler on the sampled thread, read by the watchdog (the only requester).
+        /// requested holds the id of the sample the watchdog waits for, 0 when nobody waits: a handler claims it
+        /// by swapping it to 0 before touching frames, so a signal delivered after the watchdog gave up, or a
+        /// second one for the same request, leaves the buffer alone.
+        struct StackSample {
+            std::atomic<std::uint64_t> requested{0};
+            std::atomic<std::uint64_t> filled{0};
+            void* frames[kMaxFrames]{};
+            int depth = 0;
+        };
+
+        StackSample stackSample;
+
+        int stackSignal() {
+            return SIGRTMIN + 1;
+        }
+
+        /// backtrace() is not async-signal-safe by POSIX. With glibc it is usable here once libgcc is loaded
+        /// (the constructor warms it up), it does not allocate or lock afterwards; a frame without unwind
+        /// information can still end the walk early or, rarely, crash: LOOP_STALL_STACKS=false turns sampling off
+        void onStackSignal(int) {
+            std::uint64_t id = stackSample.requested.load(std::memory_order_acquire);
+            if (id == 0 || !stackSample.requested.compare_exchange_strong(id, 0, std::memory_order_acq_rel)) return;
+
+            const int savedErrno = errno;
+            stackSample.depth = ::backtrace(stackSample.frames, kMaxFrames);
+            stackSample.filled.store(id, std::memory_order_release);
+            errno = savedErrno;
+        }
+
+        std::int64_t steadyNs() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count();
+        }
+
+        struct LagMetrics {
+            metrics::Family<metrics::Histogram> lag;
+            metrics::Counter stalls;
+        };
+
+        const LagMetrics& lagMetrics() {
+            auto& registry = MetricsRegistry::instance();
+            static const LagMetrics m{
+                registry.histogramFamily("event_loop_lag_seconds", "How late periodic probe timers fire", {"executor"}),
+                registry.counter("event_loop_stalls_total", "Probes overdue by more than the stall threshold")
+            };
+            return m;
+        }
+    }
+
+    LoopLagMonitor::LoopLagMonitor(Options options) : options_(options) {
+        if (options_.captureStacks && options_.stallThreshold.count() > 0) {
+            // backtrace() loads libgcc on first use, which allocates: never let that happen in the handler
+            void* warmup[1];
+            ::backtrace(warmup, 1);
+
+            struct sigaction action{};
+            action.sa_handler = onStackSignal;
+            sigemptyset(&action.sa_mask);
+            action.sa_flags = SA_RESTART;
+            ::sigaction(stackSignal(), &action, nullptr);
+        }
+    }
+
+    LoopLagMonitor::~LoopLagMonitor() {
+        stop();
+    }
+
+    void LoopLagMonitor::watch(std::string name, net::any_io_executor executor, const bool stallWatch) {
+        auto state = std::make_shared<Probe>();
+        state->name = std::move(name);
+        state->stallWatch = stallWatch;
+        state->lastTick.store(steadyNs(), std::memory_order_relaxed);
+
+        const std::weak_ptr<Probe> weak = state;
+        MetricsRegistry::instance().callbackGauge(
+            "event_loop_lag_last_seconds",
+            "Lag of the latest probe wake-up",
+            {{"executor", state->name}},
+            [weak]() -> double {
+                const auto probe = weak.lock();
+                return probe ? static_cast<double>(probe->lastLagNs.load(std::memory_order_relaxed)) / 1e9 : 0.0;
+            }
+        );
+
+        {
+            std::lock_guard lock(mutex_);
+            probes_.push_back(state);
+        }
+        net::co_spawn(executor, probe(std::move(state), options_.interval), net::detached);
+    }
+
+    void LoopLagMonitor::registerCurrentThread() {
+        std::lock_guard lock(mutex_);
+        threads_.push_back(IoThread{::pthread_self(), static_cast<long>(::syscall(SYS_gettid))});
+    }
+
+    void LoopLagMonitor::start() {
+        if (options_.stallThreshold.count() <= 0 || watchdog_.joinable()) return;
+        watchdog_ = std::thread([this] { runWatchdog(); });
+    }
+
+    void LoopLagMonitor::stop() {
+        stopping_.store(true, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(mutex_);
+            for (const auto& probe : probes_) probe->stopping.store(true, std::memory_order_relaxed);
+        }
+        wake_.notify_all();
+        if (watchdog_.joinable()) watchdog_.join();
+    }
+
+    net::awaitable<void> LoopLagMonitor::probe(
+        const std::shared_ptr<Probe> state,
+        const std::chrono::milliseconds interval
+    ) {
+        net::steady_timer timer(co_await net::this_coro::executor);
+        const auto series = lagMetrics().lag.with({state->name});
+
+        while (!state->stopping.load(std::memory_order_relaxed)) {
+            const auto due = std::chrono::steady_clock::now() + interval;
+            timer.expires_at(due);
+            boost::system::error_code ec;
+            co_await timer.async_wait(net::redirect_error(net::use_awaitable, ec));
+            if (ec) co_return;
+
+            const auto lag = std::chrono::steady_clock::now() - due;
+            series.observe(lag);
+            state->lastLagNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(lag).count(), std::memory_order_relaxed);
+            state->lastTick.store(steadyNs(), std::memory_order_relaxed);
+        }
+    }
+
+    void LoopLagMonitor::runWatchdog() {
+        const auto period = std::max(options_.interval / 2, std::chrono::milliseconds(10));
+        const auto threshold = std::chrono::duration_cast<std::chrono::nanoseconds>(options_.interval + options_.stallThreshold);
+
+        std::unique_lock lock(mutex_);
+        while (!stopping_.load(std::memory_order_relaxed)) {
+            wake_.wait_for(lock, period, [this] { return stopping_.load(std::memory_order_relaxed); });
+            if (stopping_.load(std::memory_order_relaxed)) return;
+
+            const std::int64_t now = steadyNs();
+            for (const auto& probe : probes_) {
+                if (!probe->stallWatch) continue;
+                const auto overdue = std::chrono::nanoseconds(now - probe->lastTick.load(std::memory_order_relaxed));
+                if (overdue < threshold) {
+                    probe->stallReported = false;
+                    continue;
+                }
+                if (probe->stallReported) continue;
+                probe->stallReported = true;
+                onStall(*probe, overdue);
+            }
+        }
+    }
+
+    /// Runs on the watchdog thread with mutex_ held
+    void LoopLagMonitor::onStall(Probe& probe, const std::chrono::nanoseconds overdue) {
+        lagMetrics().stalls.inc();
+        const auto overdueMs = std::chrono::duration_cast<std::chrono::milliseconds>(overdue).count();
+
+        const auto now = std::chrono::steady_clock::now();
+        const bool sample = options_.captureStacks && !threads_.empty()
+            && (lastSampleAt_ == std::chrono::steady_clock::time_point{} || now - lastSampleAt_ >= options_.sampleCooldown);
+        if (!sample) {
+            LOG_WARN("LoopLagMonitor: event loop stalled",
+                {"executor", probe.name},
+                {"overdue_ms", overdueMs}
+            );
+            return;
+        }
+        lastSampleAt_ = now;
+
+        for (const auto& thread : threads_) {
+            LOG_WARN("LoopLagMonitor: event loop stalled",
+                {"executor", probe.name},
+                {"overdue_ms", overdueMs},
+                {"thread", static_cast<std::int64_t>(thread.tid)},
+                {"stack", sampleStack(thread)}
+            );
+        }
+    }
+
+    std::vector<std::string> LoopLagMonitor::sampleStack(const IoThread& thread) {
+        // Watchdog thread only, ids are never reused
+        static std::uint64_t nextId = 0;
+        const std::uint64_t id = ++nextId;
+        stackSample.requested.store(id, std::memory_order_release);
+        if (::pthread_kill(thread.handle, stackSignal()) != 0) {
+            stackSample.requested.store(0, std::memory_order_release);
+            return {};
+        }
+
+        // The thread is stuck in user code or a syscall: the handler runs right away (syscalls are restarted)
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+        while (stackSample.filled.load(std::memory_order_acquire) != id) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                // Withdraw the request; if a handler claimed it already, it is mid-walk: wait for it to finish,
+                // the next request must not share the buffer with it
+                std::uint64_t expected = id;
+                if (stackSample.requested.compare_exchange_strong(expected, 0, std::memory_order_acq_rel)) {
+                    return {"<no sample: signal not delivered in time>"};
+                }
+                while (stackSample.filled.load(std::memory_order_acquire) != id) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                }
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+
+        std::vector<std::string> frames;
+        char** symbols = ::backtrace_symbols(stackSample.frames, stackSample.depth);
+        if (!symbols) return frames;
+        // Frame 0 is the handler itself, 1 the signal trampoline
+        for (int i = 2; i < stackSample.depth; ++i) frames.emplace_back(symbols[i]);
+        std::free(symbols);
+        return frames;
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <boost/asio.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+
+namespace net = boost::asio;
+
+namespace metrics {
+    /// Event-loop lag probes and a stall watchdog.
+    ///
+    /// Every watched executor runs a timer coroutine that wakes each interval: how late it wakes up is
+    /// the scheduling lag (event_loop_lag_seconds{executor}). A blocking call on the loop shows up there
+    /// only after it returned, so a watchdog thread also checks the last wake-up of every probe:
+    /// when one is overdue by stallThreshold, the registered I/O threads are interrupted with a signal
+    /// and their stacks are logged while the stall is still going on (one sample per stall, cooldown between).
+    class LoopLagMonitor {
+    public:
+        struct Options {
+            std::chrono::milliseconds interval{100};
+            /// Overdue probe -> stall; 0 disables the watchdog
+            std::chrono::milliseconds stallThreshold{200};
+            /// Minimal time between two stack samples
+            std::chrono::seconds sampleCooldown{10};
+            bool captureStacks = true;
+        };
+
+        explicit LoopLagMonitor(Options options);
+        ~LoopLagMonitor();
+        LoopLagMonitor(const LoopLagMonitor&) = delete;
+        LoopLagMonitor& operator=(const LoopLagMonitor&) = delete;
+
+        /// Starts a probe on executor (an io_context, a strand, the blocking pool).
+        /// stallWatch: overdue probe triggers the watchdog, off for pools that are allowed to be busy
+        void watch(std::string name, net::any_io_executor executor, bool stallWatch = true);
+        /// The calling thread runs a watched loop: it is the one sampled on a stall
+        void registerCurrentThread();
+        /// Starts the watchdog thread, probes start in watch()
+        void start();
+        void stop();
+
+    private:
+        struct Probe {
+            std::string name;
+            /// steady_clock ns of the last wake-up
+            std::atomic<std::int64_t> lastTick{0};
+            std::atomic<std::int64_t> lastLagNs{0};
+            /// Shared with the probe coroutine, which may outlive the monitor until its loop is destroyed
+            std::atomic<bool> stopping{false};
+            bool stallWatch = true;
+            bool stallReported = false;
+        };
+
+        struct IoThread {
+            pthread_t handle;
+            long tid;
+        };
+
+        Options options_;
+        std::atomic<bool> stopping_{false};
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::vector<std::shared_ptr<Probe>> probes_;
+        std::vector<IoThread> threads_;
+        std::thread watchdog_;
+        std::chrono::steady_clock::time_point lastSampleAt_{};
+
+        static net::awaitable<void> probe(std::shared_ptr<Probe> state, std::chrono::milliseconds interval);
+        void runWatchdog();
+        void onStall(Probe& probe, std::chrono::nanoseconds overdue);
+        [[nodiscard]] static std::vector<std::string> sampleStack(const IoThread& thread);
+    };
+}
@@ -0,0 +1,388 @@
+#include "core/metrics/MetricsRegistry.h"
+
+#include <charconv>
+#include <stdexcept>
+
+namespace metrics {
+    namespace {
+        constexpr char kSeparator = '\x1f';
+
+        void appendDouble(std::string& out, const double value) {
+            char buf[64];
+            const auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+            out.append(buf, end);
+        }
+
+        void appendEscaped(std::string& out, const std::string_view value) {
+            for (const char c : value) {
+                switch (c) {
+                    case '\\': out += "\\\\"; break;
+                    case '"':  out += "\\\""; break;
+                    case '\n': out += "\\n"; break;
+                    default:   out += c;
+                }
+            }
+        }
+
+        /// name{a="1",b="2"[,extra]}
+        void appendSeriesName(
+            std::string& out,
+            const std::string& name,
+            const std::string_view suffix,
+            const Labels& labels,
+            const std::string_view extraLabel = {},
+            const std::string_view extraValue = {}
+        ) {
+            out += name;
+            out += suffix;
+            if (labels.empty() && extraLabel.empty()) return;
+
+            out += '{';
+            bool first = true;
+            for (const auto& [k, v] : labels) {
+                if (!first) out += ',';
+                first = false;
+                out += k;
+                out += "=\"";
+                appendEscaped(out, v);
+                out += '"';
+            }
+            if (!extraLabel.empty()) {
+                if (!first) out += ',';
+                out += extraLabel;
+                out += "=\"";
+                out += extraValue;
+                out += '"';
+            }
+            out += '}';
+        }
+    }
+
+    // --- handles ---
+
+    void Counter::inc(const std::uint64_t n) const noexcept {
+        auto& value = MetricsRegistry::localShard().at(slot_);
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    void Gauge::add(const std::int64_t n) const noexcept {
+        // Two's complement deltas, the scrape reads the sum back as signed
+        auto& value = MetricsRegistry::localShard().at(slot_);
+        value.store(value.load(std::memory_order_relaxed) + static_cast<std::uint64_t>(n), std::memory_order_relaxed);
+    }
+
+    void Histogram::record(const std::uint64_t v) const noexcept {
+        auto& shard = MetricsRegistry::localShard();
+        auto& bucket = shard.at(slot_ + static_cast<std::uint32_t>(HdrHistogram::bucketFor(v)));
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        auto& sum = shard.at(slot_ + static_cast<std::uint32_t>(HdrHistogram::kBuckets));
+        sum.store(sum.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+    }
+
+    // --- shards ---
+
+    MetricsRegistry::Shard::~Shard() {
+        for (auto& chunk : chunks) delete chunk.load(std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint64_t>& MetricsRegistry::Shard::at(const std::uint32_t slot) {
+        auto& ref = chunks[slot / kChunkSlots];
+        Chunk* chunk = ref.load(std::memory_order_relaxed);
+        if (!chunk) {
+            chunk = new Chunk{};
+            ref.store(chunk, std::memory_order_release);
+        }
+        return (*chunk)[slot % kChunkSlots];
+    }
+
+    std::uint64_t MetricsRegistry::Shard::read(const std::uint32_t slot) const {
+        const Chunk* chunk = chunks[slot / kChunkSlots].load(std::memory_order_acquire);
+        return chunk ? (*chunk)[slot % kChunkSlots].load(std::memory_order_relaxed) : 0;
+    }
+
+    /// Registers the calling thread's shard, folds it into retired_ when the thread exits
+    class MetricsRegistry::ShardHandle {
+    public:
+        ShardHandle() : shard(new Shard) { MetricsRegistry::instance().attach(shard); }
+        ~ShardHandle() {
+            MetricsRegistry::instance().detach(shard);
+            delete shard;
+        }
+        Shard* shard;
+    };
+
+    MetricsRegistry::Shard& MetricsRegistry::localShard() {
+        thread_local ShardHandle handle;
+        return *handle.shard;
+    }
+
+    void MetricsRegistry::attach(Shard* shard) {
+        std::lock_guard lk(m_);
+        shards_.push_back(shard);
+    }
+
+    void MetricsRegistry::detach(Shard* shard) {
+        std::lock_guard lk(m_);
+        retired_.resize(nextSlot_, 0);
+        for (std::uint32_t slot = 0; slot < nextSlot_; ++slot) retired_[slot] += shard->read(slot);
+        std::erase(shards_, shard);
+    }
+
+    std::uint64_t MetricsRegistry::sumLocked(const std::uint32_t slot) const {
+        std::uint64_t total = slot < retired_.size() ? retired_[slot] : 0;
+        for (const Shard* shard : shards_) total += shard->read(slot);
+        return total;
+    }
+
+    // --- registration ---
+
+    MetricsRegistry& MetricsRegistry::instance() {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    const std::vector<double>& MetricsRegistry::defaultLatencyBuckets() {
+        static const std::vector<double> buckets{
+            0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+        };
+        return buckets;
+    }
+
+    std::size_t MetricsRegistry::slotsFor(const Type type) {
+        return type == Type::Histogram ? HdrHistogram::kBuckets + 1 : 1;
+    }
+
+    std::uint32_t MetricsRegistry::family(
+        const std::string& name,
+        const std::string& help,
+        const Type type,
+        std::vector<std::string> labelNames
+    ) {
+        std::lock_guard lk(m_);
+        if (const auto it = byName_.find(name); it != byName_.end()) {
+            const FamilyData& existing = *families_[it->second];
+            if (existing.type != type || existing.labelNames != labelNames) {
+                throw std::logic_error("Metric registered twice with a different shape: " + name);
+            }
+            return it->second;
+        }
+
+        auto data = std::make_unique<FamilyData>();
+        data->name = name;
+        data->help = help;
+        data->type = type;
+        data->labelNames = std::move(labelNames);
+
+        const auto id = static_cast<std::uint32_t>(families_.size());
+        families_.push_back(std::move(data));
+        byName_.emplace(name, id);
+        return id;
+    }
+
+    Family<Counter> MetricsRegistry::counterFamily(const std::string& name, const std::string& help, std::vector<std::string> labelNames) {
+        return Family<Counter>(family(name, help, Type::Counter, std::move(labelNames)));
+    }
+
+    Family<Gauge> MetricsRegistry::gaugeFamily(const std::string& name, const std::string& help, std::vector<std::string> labelNames) {
+        return Family<Gauge>(family(name, help, Type::Gauge, std::move(labelNames)));
+    }
+
+    Family<Histogram> MetricsRegistry::histogramFamily(
+        const std::string& name,
+        const std::string& help,
+        std::vector<std::string> labelNames,
+        std::vector<double> buckets,
+        const double scale
+    ) {
+        const std::uint32_t id = family(name, help, Type::Histogram, std::move(labelNames));
+        std::lock_guard lk(m_);
+        FamilyData& data = *families_[id];
+        data.buckets = std::move(buckets);
+        std::ranges::sort(data.buckets);
+        data.scale = scale;
+        return Family<Histogram>(id);
+    }
+
+    Counter MetricsRegistry::counter(const std::string& name, const std::string& help) {
+        return counterFamily(name, help, {}).with({});
+    }
+
+    Gauge MetricsRegistry::gauge(const std::string& name, const std::string& help) {
+        return gaugeFamily(name, help, {}).with({});
+    }
+
+    Histogram MetricsRegistry::histogram(const std::string& name, const std::string& help) {
+        return histogramFamily(name, help, {}).with({});
+    }
+
+    void MetricsRegistry::callbackGauge(const std::string& name, const std::string& help, Labels labels, std::function<double()> fn) {
+        std::vector<std::string> labelNames;
+        labelNames.reserve(labels.size());
+        for (const auto& [k, v] : labels) labelNames.push_back(k);
+
+        const std::uint32_t id = family(name, help, Type::Gauge, std::move(labelNames));
+        std::lock_guard lk(m_);
+        families_[id]->callbacks.emplace_back(std::move(labels), std::move(fn));
+    }
+
+    std::uint32_t MetricsRegistry::resolve(const std::uint32_t familyId, const std::initializer_list<std::string_view> values) {
+        // Per-thread cache: steady state is one hash lookup, no lock, no allocation
+        thread_local std::string key;
+        thread_local std::unordered_map<std::string, std::uint32_t> cache;
+
+        key.clear();
+        key.append(reinterpret_cast<const char*>(&familyId), sizeof(familyId));
+        for (const std::string_view value : values) {
+            key += kSeparator;
+            key += value;
+        }
+        if (const auto it = cache.find(key); it != cache.end()) return it->second;
+
+        std::uint32_t slot;
+        {
+            std::lock_guard lk(m_);
+            slot = seriesLocked(*families_.at(familyId), key.substr(sizeof(familyId)), values);
+        }
+        cache.emplace(key, slot);
+        return slot;
+    }
+
+    std::uint32_t MetricsRegistry::seriesLocked(
+        FamilyData& family,
+        const std::string& key,
+        const std::initializer_list<std::string_view> values
+    ) {
+        if (const auto it = family.index.find(key); it != family.index.end()) return it->second;
+
+        if (values.size() != family.labelNames.size()) {
+            throw std::logic_error("Metric " + family.name + ": label values do not match label names");
+        }
+
+        // Slot 0 stays unused: default-constructed handles write there harmlessly
+        if (nextSlot_ == 0) nextSlot_ = 1;
+        const std::size_t need = slotsFor(family.type);
+        if (nextSlot_ + need > kChunkSlots * kMaxChunks) {
+            throw std::length_error("MetricsRegistry: too many series");
+        }
+        const std::uint32_t slot = nextSlot_;
+        nextSlot_ += static_cast<std::uint32_t>(need);
+
+        Series series{{}, slot};
+        auto value = values.begin();
+        for (const auto& labelName : family.labelNames) {
+            series.labels.emplace_back(labelName, std::string(*value++));
+        }
+        family.series.push_back(std::move(series));
+        family.index.emplace(key, slot);
+        return slot;
+    }
+
+    // --- scrape ---
+
+    std::int64_t MetricsRegistry::value(const std::uint32_t slot) {
+        std::lock_guard lk(m_);
+        return static_cast<std::int64_t>(sumLocked(slot));
+    }
+
+    HdrHistogram MetricsRegistry::snapshot(const Histogram& histogram) {
+        std::lock_guard lk(m_);
+        HdrHistogram out;
+        for (std::size_t bucket = 0; bucket < HdrHistogram::kBuckets; ++bucket) {
+            out.addBucket(bucket, sumLocked(histogram.slot_ + static_cast<std::uint32_t>(bucket)));
+        }
+        out.setSum(sumLocked(histogram.slot_ + static_cast<std::uint32_t>(HdrHistogram::kBuckets)));
+        return out;
+    }
+
+    std::string MetricsRegistry::render() {
+        // Callbacks may take their own locks: evaluate them outside of m_
+        std::vector<std::vector<double>> callbackValues;
+        {
+            std::vector<std::vector<std::function<double()>>> callbacks;
+            {
+                std::lock_guard lk(m_);
+                callbacks.resize(families_.size());
+                for (std::size_t i = 0; i < families_.size(); ++i) {
+                    for (const auto& [labels, fn] : families_[i]->callbacks) callbacks[i].push_back(fn);
+                }
+            }
+            callbackValues.resize(callbacks.size());
+            for (std::size_t i = 0; i < callbacks.size(); ++i) {
+                for (const auto& fn : callbacks[i]) callbackValues[i].push_back(fn());
+            }
+        }
+
+        std::lock_guard lk(m_);
+        std::string out;
+        out.reserve(16 * 1024);
+
+        for (std::size_t i = 0; i < families_.size(); ++i) {
+            const FamilyData& family = *families_[i];
+            out += "# HELP ";
+            out += family.name;
+            out += ' ';
+            out += family.help;
+            out += "\n# TYPE ";
+            out += family.name;
+            out += family.type == Type::Counter ? " counter\n" : family.type == Type::Gauge ? " gauge\n" : " histogram\n";
+
+            for (const Series& series : family.series) {
+                if (family.type != Type::Histogram) {
+                    appendSeriesName(out, family.name, "", series.labels);
+                    out += ' ';
+                    const std::uint64_t raw = sumLocked(series.slot);
+                    out += family.type == Type::Gauge
+                        ? std::to_string(static_cast<std::int64_t>(raw))
+                        : std::to_string(raw);
+                    out += '\n';
+                    continue;
+                }
+
+                std::array<std::uint64_t, HdrHistogram::kBuckets> counts{};
+                std::uint64_t total = 0;
+                for (std::size_t b = 0; b < HdrHistogram::kBuckets; ++b) {
+                    counts[b] = sumLocked(series.slot + static_cast<std::uint32_t>(b));
+                    total += counts[b];
+                }
+
+                // A fine bucket counts towards the first boundary that covers its upper bound
+                std::size_t fine = 0;
+                std::uint64_t cumulative = 0;
+                for (const double le : family.buckets) {
+                    while (fine < HdrHistogram::kBuckets
+                        && static_cast<double>(HdrHistogram::upperBound(fine)) * family.scale <= le) {
+                        cumulative += counts[fine++];
+                    }
+                    char leText[32];
+                    const auto [end, ec] = std::to_chars(leText, leText + sizeof(leText), le, std::chars_format::fixed);
+                    appendSeriesName(out, family.name, "_bucket", series.labels, "le", std::string_view(leText, end - leText));
+                    out += ' ';
+                    out += std::to_string(cumulative);
+                    out += '\n';
+                }
+                appendSeriesName(out, family.name, "_bucket", series.labels, "le", "+Inf");
+                out += ' ';
+                out += std::to_string(total);
+                out += '\n';
+
+                appendSeriesName(out, family.name, "_sum", series.labels);
+                out += ' ';
+                appendDouble(out, static_cast<double>(sumLocked(series.slot + static_cast<std::uint32_t>(HdrHistogram::kBuckets))) * family.scale);
+                out += '\n';
+
+                appendSeriesName(out, family.name, "_count", series.labels);
+                out += ' ';
+                out += std::to_string(total);
+                out += '\n';
+            }
+
+            for (std::size_t c = 0; c < family.callbacks.size() && c < callbackValues[i].size(); ++c) {
+                appendSeriesName(out, family.name, "", family.callbacks[c].first);
+                out += ' ';
+                appendDouble(out, callbackValues[i][c]);
+                out += '\n';
+            }
+        }
+        return out;
+    }
+}
@@ -0,0 +1,181 @@
+#pragma once
+#include "core/metrics/HdrHistogram.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace metrics {
+    using Labels = std::vector<std::pair<std::string, std::string>>;
+
+    class MetricsRegistry;
+
+    /// Handles are plain slot indices: cheap to copy, valid for the process lifetime.
+    /// Every thread writes into its own shard (single writer, relaxed load + store, no RMW),
+    /// the scrape sums the shards.
+    class Counter {
+    public:
+        Counter() = default;
+        void inc(std::uint64_t n = 1) const noexcept;
+
+    private:
+        friend class MetricsRegistry;
+        template <class> friend class Family;
+        explicit Counter(const std::uint32_t slot) : slot_(slot) {}
+        std::uint32_t slot_ = 0;
+    };
+
+    /// Up/down value kept as per-thread deltas (in-flight requests, queue depth).
+    /// Absolute values sampled from elsewhere go through MetricsRegistry::callbackGauge.
+    class Gauge {
+    public:
+        Gauge() = default;
+        void add(std::int64_t n) const noexcept;
+        void inc() const noexcept { add(1); }
+        void dec() const noexcept { add(-1); }
+
+    private:
+        friend class MetricsRegistry;
+        template <class> friend class Family;
+        explicit Gauge(const std::uint32_t slot) : slot_(slot) {}
+        std::uint32_t slot_ = 0;
+    };
+
+    /// HdrHistogram buckets + sum, values in the family's raw unit
+    class Histogram {
+    public:
+        Histogram() = default;
+        void record(std::uint64_t value) const noexcept;
+        /// Microseconds
+        void observe(const std::chrono::steady_clock::duration d) const noexcept {
+            record(static_cast<std::uint64_t>(std::max<std::int64_t>(
+                0, std::chrono::duration_cast<std::chrono::microseconds>(d).count())));
+        }
+
+    private:
+        friend class MetricsRegistry;
+        template <class> friend class Family;
+        explicit Histogram(const std::uint32_t slot) : slot_(slot) {}
+        std::uint32_t slot_ = 0;
+    };
+
+    /// Labeled series of one metric, with() resolves label values through a per-thread cache
+    template <class Metric>
+    class Family {
+    public:
+        Family() = default;
+        Metric with(std::initializer_list<std::string_view> values) const;
+
+    private:
+        friend class MetricsRegistry;
+        explicit Family(const std::uint32_t id) : id_(id) {}
+        std::uint32_t id_ = 0;
+    };
+
+    class MetricsRegistry {
+    public:
+        static MetricsRegistry& instance();
+
+        /// Latency buckets in seconds (exported unit), used for histograms recorded in microseconds
+        static const std::vector<double>& defaultLatencyBuckets();
+
+        Family<Counter> counterFamily(const std::string& name, const std::string& help, std::vector<std::string> labelNames);
+        Family<Gauge> gaugeFamily(const std::string& name, const std::string& help, std::vector<std::string> labelNames);
+        /// scale converts raw values to the exported unit (1e-6: microseconds -> seconds)
+        Family<Histogram> histogramFamily(
+            const std::string& name,
+            const std::string& help,
+            std::vector<std::string> labelNames,
+            std::vector<double> buckets = defaultLatencyBuckets(),
+            double scale = 1e-6
+        );
+
+        Counter counter(const std::string& name, const std::string& help);
+        Gauge gauge(const std::string& name, const std::string& help);
+        Histogram histogram(const std::string& name, const std::string& help);
+
+        /// Evaluated on every scrape, fn must be thread-safe and outlive the registry (or guard itself)
+        void callbackGauge(const std::string& name, const std::string& help, Labels labels, std::function<double()> fn);
+
+        /// Prometheus text exposition format 0.0.4
+        [[nodiscard]] std::string render();
+
+        /// Merged value of one series (tests, benchmarks)
+        [[nodiscard]] std::int64_t value(std::uint32_t slot);
+        [[nodiscard]] HdrHistogram snapshot(const Histogram& histogram);
+
+    private:
+        template <class Metric> friend class Family;
+        friend class Counter;
+        friend class Gauge;
+        friend class Histogram;
+
+        enum class Type { Counter, Gauge, Histogram };
+
+        struct Series {
+            Labels labels;
+            std::uint32_t slot;
+        };
+
+        struct FamilyData {
+            std::string name;
+            std::string help;
+            Type type;
+            std::vector<std::string> labelNames;
+            std::vector<Series> series;
+            std::unordered_map<std::string, std::uint32_t> index;
+            std::vector<double> buckets;
+            double scale = 1.0;
+            std::vector<std::pair<Labels, std::function<double()>>> callbacks;
+        };
+
+        static constexpr std::size_t kChunkSlots = 1024;
+        static constexpr std::size_t kMaxChunks = 256;
+        using Chunk = std::array<std::atomic<std::uint64_t>, kChunkSlots>;
+
+        /// One per thread. Only the owner thread writes values and allocates chunks.
+        struct Shard {
+            std::array<std::atomic<Chunk*>, kMaxChunks> chunks{};
+            ~Shard();
+            std::atomic<std::uint64_t>& at(std::uint32_t slot);
+            [[nodiscard]] std::uint64_t read(std::uint32_t slot) const;
+        };
+
+        class ShardHandle;
+
+        std::mutex m_;
+        std::vector<std::unique_ptr<FamilyData>> families_;
+        std::unordered_map<std::string, std::uint32_t> byName_;
+        std::uint32_t nextSlot_ = 0;
+        std::vector<Shard*> shards_;
+        /// Values of exited threads
+        std::vector<std::uint64_t> retired_;
+
+        MetricsRegistry() = default;
+
+        static Shard& localShard();
+        void attach(Shard* shard);
+        void detach(Shard* shard);
+
+        std::uint32_t family(const std::string& name, const std::string& help, Type type, std::vector<std::string> labelNames);
+        std::uint32_t resolve(std::uint32_t familyId, std::initializer_list<std::string_view> values);
+        std::uint32_t seriesLocked(FamilyData& family, const std::string& key, std::initializer_list<std::string_view> values);
+        [[nodiscard]] std::uint64_t sumLocked(std::uint32_t slot) const;
+        static std::size_t slotsFor(Type type);
+    };
+
+    template <class Metric>
+    Metric Family<Metric>::with(const std::initializer_list<std::string_view> values) const {
+        return Metric(MetricsRegistry::instance().resolve(id_, values));
+    }
+}
@@ -0,0 +1,65 @@
+#include "core/metrics/RuntimeMetrics.h"
+#include "core/db/postgres/interfaces/PgPoolInterface.h"
+#include "core/metrics/MetricsRegistry.h"
+#include "core/profiling/AllocationTracker.h"
+
+#include <fstream>
+#include <unistd.h>
+
+namespace metrics {
+    namespace {
+        /// Resident pages from /proc/self/statm, 0 where there is no procfs
+        double residentBytes() {
+            std::ifstream statm("/proc/self/statm");
+            std::uint64_t size = 0;
+            std::uint64_t resident = 0;
+            if (!(statm >> size >> resident)) return 0.0;
+            return static_cast<double>(resident) * static_cast<double>(::sysconf(_SC_PAGESIZE));
+        }
+    }
+
+    void registerPgPool(const std::shared_ptr<PgPoolInterface>& pool) {
+        auto& registry = MetricsRegistry::instance();
+        const std::weak_ptr<PgPoolInterface> weak = pool;
+
+        const auto stat = [weak](auto field) {
+            return [weak, field]() -> double {
+                const auto pool = weak.lock();
+                return pool ? static_cast<double>(field(pool->stats())) : 0.0;
+            };
+        };
+
+        registry.callbackGauge("db_pool_connections", "Pool connections by state", {{"state", "leased"}},
+            stat([](const PgPoolInterface::Stats& s) { return s.leased; }));
+        registry.callbackGauge("db_pool_connections", "Pool connections by state", {{"state", "idle"}},
+            stat([](const PgPoolInterface::Stats& s) { return s.idle; }));
+        registry.callbackGauge("db_pool_size", "Configured pool size", {},
+            stat([](const PgPoolInterface::Stats& s) { return s.size; }));
+        registry.callbackGauge("db_pool_waiting", "Coroutines waiting for a connection", {},
+            stat([](const PgPoolInterface::Stats& s) { return s.waiting; }));
+        registry.callbackGauge("db_pool_breaker_open", "1 while the circuit breaker rejects queries", {},
+            stat([](const PgPoolInterface::Stats& s) { return s.breakerOpen ? 1 : 0; }));
+    }
+
+    void registerBlockingPool(const std::size_t threads) {
+        MetricsRegistry::instance().callbackGauge("blocking_pool_threads", "Threads of the blocking pool", {},
+            [threads]() -> double { return static_cast<double>(threads); });
+    }
+
+    void registerHeap() {
+        using profiling::AllocationTracker;
+        auto& registry = MetricsRegistry::instance();
+        registry.callbackGauge("process_resident_memory_bytes", "Resident set size", {}, residentBytes);
+        // mallinfo2 walks the arenas under their locks: cheap enough once per scrape
+        registry.callbackGauge("malloc_bytes", "glibc allocator bytes by state", {{"state", "in_use"}},
+            []() -> double { return static_cast<double>(AllocationTracker::mallocStats().inUseBytes); });
+        registry.callbackGauge("malloc_bytes", "glibc allocator bytes by state", {{"state", "free"}},
+            []() -> double { return static_cast<double>(AllocationTracker::mallocStats().freeBytes); });
+        if constexpr (!AllocationTracker::kEnabled) return;
+
+        registry.callbackGauge("heap_live_allocations", "Blocks allocated through operator new and not freed yet", {},
+            []() -> double { return static_cast<double>(AllocationTracker::totals().liveAllocations()); });
+        registry.callbackGauge("heap_live_bytes", "Usable bytes of live operator new blocks", {},
+            []() -> double { return static_cast<double>(AllocationTracker::totals().liveBytes()); });
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+
+class PgPoolInterface;
+
+namespace metrics {
+    /// Callback gauges over PgPoolInterface::stats(): connections by state, waiters, breaker.
+    /// The pool is held weakly, a destroyed pool reports zeros.
+    void registerPgPool(const std::shared_ptr<PgPoolInterface>& pool);
+    /// blocking_pool_threads: with blocking_pool_active gives the saturation of async_offload's pool
+    void registerBlockingPool(std::size_t threads);
+    /// Resident set size, malloc in-use/free bytes, plus live heap allocations and bytes when built with APP_ALLOC_TRACKING
+    void registerHeap();
+}
@@ -0,0 +1,33 @@
+#include "core/metrics/controllers/MetricsController.h"
+#include "core/metrics/MetricsRegistry.h"
+
+bool MetricsController::authorized(const Request& request) const {
+    if (token_.empty()) return true;
+
+    const auto header = request.raw().base().find(http::field::authorization);
+    if (header == request.raw().base().end()) return false;
+    const std::string_view auth(header->value().data(), header->value().size());
+    if (!auth.starts_with("Bearer ")) return false;
+
+    // Constant time over the configured token: the length is the only thing a mismatch reveals
+    const std::string_view token = auth.substr(7);
+    unsigned char diff = token.size() != token_.size();
+    for (std::size_t i = 0; i < token_.size(); ++i) {
+        diff |= static_cast<unsigned char>(token_[i] ^ (i < token.size() ? token[i] : 0));
+    }
+    return diff == 0;
+}
+
+net::awaitable<Outcome> MetricsController::index(const Request& request) const {
+    if (!authorized(request)) {
+        co_return JsonResult{json{{"error", "Invalid metrics token"}}, http::status::unauthorized};
+    }
+
+    Response response{http::status::ok, request.version()};
+    response.set(http::field::content_type, "text/plain; version=0.0.4; charset=utf-8");
+    response.set(http::field::cache_control, "no-store");
+    response.keep_alive(request.keep_alive());
+    response.body() = metrics::MetricsRegistry::instance().render();
+    response.prepare_payload();
+    co_return response;
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "core/http/interfaces/HttpInterface.h"
+#include "core/http/ResponseTypes.h"
+#include "core/request/Request.h"
+
+#include <string>
+
+/// Prometheus scrape endpoint, text exposition format.
+/// Open unless a token is set: then scrapes need Authorization: Bearer <token> (Prometheus authorization.credentials)
+class MetricsController {
+public:
+    explicit MetricsController(std::string token = {}) : token_(std::move(token)) {}
+
+    [[nodiscard]] net::awaitable<Outcome> index(const Request& request) const;
+
+private:
+    std::string token_;
+
+    [[nodiscard]] bool authorized(const Request& request) const;
+};
@@ -0,0 +1,37 @@
+#include "core/middlewares/CaptureMiddleware.h"
+
+net::awaitable<Outcome> CaptureMiddleware::handle(Request& request, Next next) {
+    if (!writer_->sample()) co_return co_await next(request);
+
+    // Taken before the handler runs: handlers may move the body out
+    capture::Record record;
+    record.arrivalUs = writer_->elapsedUs();
+    record.method = request.method();
+    record.target = writer_->redactor().target(request.target());
+    std::vector<std::pair<std::string, std::string>> headers;
+    for (const auto& field : request.headers()) {
+        headers.emplace_back(std::string(field.name_string()), std::string(field.value()));
+    }
+    record.headers = writer_->redactor().headers(headers);
+    record.body = writer_->redactor().body(request.content_type(), request.body());
+
+    const auto startedAt = std::chrono::steady_clock::now();
+    const auto finish = [&](const unsigned status) {
+        record.status = status;
+        record.durationUs = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startedAt).count()
+        );
+        writer_->append(record);
+    };
+
+    std::optional<Outcome> outcome;
+    try {
+        outcome = co_await next(request);
+    } catch (...) {
+        // Rendered by the router: 503 when the database is unavailable, 500 otherwise
+        finish(statusOf(std::current_exception()));
+        throw;
+    }
+    finish(statusOf(*outcome));
+    co_return std::move(*outcome);
+}
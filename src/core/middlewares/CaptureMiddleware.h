@@ -0,0 +1,19 @@
+#pragma once
+#include <memory>
+
+#include "core/capture/CaptureLog.h"
+#include "core/interfaces/MiddlewareInterface.h"
+
+/// Records sampled requests into a capture file for benchmarks/replay (CAPTURE_PATH).
+/// Headers and bodies are redacted before they leave the request (capture::Redactor),
+/// the served status and duration are stored next to them for comparison.
+/// Register globally right after RequestIdMiddleware: everything behind it is part of the duration.
+class CaptureMiddleware final : public MiddlewareInterface {
+public:
+    explicit CaptureMiddleware(std::shared_ptr<capture::CaptureWriter> writer) : writer_(std::move(writer)) {}
+
+    net::awaitable<Outcome> handle(Request& request, Next next) override;
+
+private:
+    std::shared_ptr<capture::CaptureWriter> writer_;
+};
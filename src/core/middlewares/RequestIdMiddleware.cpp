@@ -0,0 +1,91 @@
+#include "core/middlewares/RequestIdMiddleware.h"
+#include "core/tracing/Span.h"
+#include "core/tracing/TraceExporter.h"
+
+namespace {
+    constexpr std::string_view kRequestIdHeader = "x-request-id";
+    constexpr std::string_view kTraceParentHeader = "traceparent";
+
+    std::string_view headerValue(const Request& request, const std::string_view name) {
+        const auto& headers = request.headers();
+        const auto it = headers.find(boost::beast::string_view{name.data(), name.size()});
+        if (it == headers.end()) return {};
+        return {it->value().data(), it->value().size()};
+    }
+}
+
+bool RequestIdMiddleware::isValidRequestId(const std::string_view id) {
+    if (id.empty() || id.size() > 128) return false;
+    for (const char c : id) {
+        const bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+            || c == '-' || c == '_' || c == '.';
+        if (!ok) return false;
+    }
+    return true;
+}
+
+void RequestIdMiddleware::identify(trace::RequestContext& ctx, const Request& request) {
+    const auto& exporter = trace::TraceExporter::instance();
+
+    if (const auto parent = trace::TraceParent::parse(headerValue(request, kTraceParentHeader))) {
+        ctx.traceId = parent->traceId;
+        ctx.remoteParentSpanId = parent->parentSpanId;
+        // Parent-based: the caller already made the head decision
+        ctx.sampled = parent->sampled && exporter.enabled();
+    } else {
+        ctx.traceId = trace::randomTraceId();
+        ctx.sampled = exporter.shouldSample(ctx.traceId);
+    }
+    ctx.rootSpanId = trace::randomId();
+
+    const std::string_view incoming = headerValue(request, kRequestIdHeader);
+    ctx.requestId = isValidRequestId(incoming) ? std::string(incoming) : ctx.traceId.hex();
+}
+
+std::shared_ptr<trace::RequestContext> RequestIdMiddleware::contextFor(const Request& request) {
+    auto ctx = std::make_shared<trace::RequestContext>();
+    identify(*ctx, request);
+    return ctx;
+}
+
+net::awaitable<Outcome> RequestIdMiddleware::handle(Request& request, Next next) {
+    if (trace::RequestContext* ctx = trace::current()) {
+        identify(*ctx, request);
+    } else {
+        trace::attach(contextFor(request));
+    }
+
+    trace::Span span("http.request", trace::SpanKind::Server);
+    const auto method = http::to_string(request.method());
+    span.setAttribute("http.method", std::string_view{method.data(), method.size()});
+    span.setAttribute("http.target", request.target());
+    if (const auto* ctx = trace::current()) span.setAttribute("request.id", ctx->requestId);
+
+    std::optional<Outcome> outcome;
+    try {
+        outcome = co_await next(request);
+    } catch (const std::exception& e) {
+        span.setAttribute("http.status_code", static_cast<std::int64_t>(statusOf(std::current_exception())));
+        span.setError(e.what());
+        throw;
+    }
+    span.setAttribute("http.status_code", static_cast<std::int64_t>(statusOf(*outcome)));
+    co_return std::move(*outcome);
+}
+
+net::awaitable<Response> RequestIdMiddleware::after(const Request& request, Response&& response) {
+    // 404 / 405 / 415 are answered without running the chain
+    trace::RequestContext* ctx = trace::current();
+    std::shared_ptr<trace::RequestContext> created;
+    if (!ctx) {
+        created = contextFor(request);
+        ctx = created.get();
+    } else if (ctx->requestId.empty()) {
+        identify(*ctx, request);
+    }
+
+    const trace::TraceParent parent{ctx->traceId, ctx->rootSpanId, ctx->sampled};
+    response.set("X-Request-Id", ctx->requestId);
+    response.set("traceparent", parent.format());
+    co_return std::move(response);
+}
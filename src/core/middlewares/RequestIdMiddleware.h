@@ -0,0 +1,26 @@
+#pragma once
+#include <memory>
+#include <string_view>
+
+#include "core/interfaces/MiddlewareInterface.h"
+#include "core/tracing/TraceContext.h"
+
+/// Request-scoped trace context and correlation headers.
+///
+///  - X-Request-Id is taken from the request when it looks sane, otherwise it is the trace id;
+///  - traceparent (W3C) continues the caller's trace and its sampling decision,
+///    without one a new trace is started and sampled by TraceExporter's ratio;
+///  - the whole chain runs inside the root "http.request" span;
+///  - responses carry X-Request-Id and traceparent pointing at the root span.
+/// Register globally and first: spans of later middlewares need the context.
+class RequestIdMiddleware final : public MiddlewareInterface {
+public:
+    net::awaitable<Outcome> handle(Request& request, Next next) override;
+    net::awaitable<Response> after(const Request& request, Response&& response) override;
+
+    /// Up to 128 of [A-Za-z0-9._-]: ends up in logs and response headers as is
+    static bool isValidRequestId(std::string_view id);
+    /// Fills ids and the sampling decision of a context created by the session
+    static void identify(trace::RequestContext& ctx, const Request& request);
+    static std::shared_ptr<trace::RequestContext> contextFor(const Request& request);
+};
@@ -0,0 +1,211 @@
+#include "core/middlewares/ResponseCacheMiddleware.h"
+#include "core/caching/RequestKey.h"
+#include "core/loggers/LoggerSingleton.h"
+#include "core/renderers/json/JsonRenderer.h"
+
+#include <openssl/evp.h>
+
+namespace {
+    constexpr std::string_view kCacheControl = "private, no-cache";
+
+    std::string_view trim(std::string_view s) {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+        return s;
+    }
+
+    bool isWrite(const http::verb method) {
+        return method == http::verb::post
+            || method == http::verb::put
+            || method == http::verb::patch
+            || method == http::verb::delete_;
+    }
+}
+
+std::string ResponseCacheMiddleware::etagFor(const std::string_view body) {
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int length = 0;
+    if (EVP_Digest(body.data(), body.size(), digest, &length, EVP_sha256(), nullptr) != 1) {
+        throw std::runtime_error("ResponseCacheMiddleware::etagFor: sha256 failed");
+    }
+
+    static constexpr char hex[] = "0123456789abcdef";
+    std::string etag;
+    etag.reserve(2 + 2 * length);
+    etag += '"';
+    for (unsigned int i = 0; i < length; ++i) {
+        const unsigned char byte = digest[i];
+        etag += hex[byte >> 4];
+        etag += hex[byte & 0x0F];
+    }
+    etag += '"';
+    return etag;
+}
+
+bool ResponseCacheMiddleware::matches(const std::string_view ifNoneMatch, const std::string_view etag) {
+    if (etag.empty()) return false;
+
+    std::string_view rest = ifNoneMatch;
+    while (!rest.empty()) {
+        const std::size_t comma = rest.find(',');
+        std::string_view candidate = trim(rest.substr(0, comma));
+        rest = comma == std::string_view::npos ? std::string_view{} : rest.substr(comma + 1);
+
+        if (candidate == "*") return true;
+        // If-None-Match uses weak comparison
+        if (candidate.starts_with("W/")) candidate.remove_prefix(2);
+        if (candidate == etag) return true;
+    }
+    return false;
+}
+
+net::awaitable<Outcome> ResponseCacheMiddleware::handle(Request& request, Next next) {
+    const http::verb method = request.method();
+
+    if (isWrite(method)) {
+        Outcome outcome = co_await next(request);
+        Response response = JsonRenderer::toResponse(request, std::move(outcome));
+        if (response.result_int() >= 200 && response.result_int() < 300) {
+            co_await invalidate();
+        }
+        co_return response;
+    }
+
+    if (method != http::verb::get && method != http::verb::head) {
+        co_return co_await next(request);
+    }
+
+    const std::string gen = co_await generation();
+    const std::string key = "rc:" + opts_.scope + ":" + gen + ":" + RequestKey::build(request);
+
+    std::string ifNoneMatch;
+    if (const auto it = request.raw().find(http::field::if_none_match); it != request.raw().end()) {
+        ifNoneMatch = std::string(it->value());
+    }
+
+    std::optional<SharedPayloadCache::Entry> hit = local_.get(key);
+    if (!hit) {
+        if (auto cached = co_await load(key)) {
+            const auto remaining = std::chrono::seconds(opts_.ttl) - cached->age(std::chrono::system_clock::now());
+            hit = toEntry(std::move(*cached));
+            if (remaining.count() > 0) local_.put(key, *hit, remaining);
+        }
+    }
+    if (hit) {
+        if (!ifNoneMatch.empty() && matches(ifNoneMatch, hit->etag)) {
+            co_return notModified(request, hit->etag);
+        }
+        co_return fromCache(request, *hit);
+    }
+
+    Outcome outcome = co_await next(request);
+    Response response = JsonRenderer::toResponse(request, std::move(outcome));
+
+    // Stale answers (serve-stale) must not become fresh cache entries
+    if (response.result() != http::status::ok || response.find(http::field::warning) != response.end()) {
+        co_return response;
+    }
+
+    CachedResponse cached;
+    cached.status = response.result_int();
+    if (const auto it = response.find(http::field::content_type); it != response.end()) {
+        cached.contentType = std::string(it->value());
+    }
+    cached.etag = etagFor(response.body());
+    cached.body = response.body();
+    cached.storedAt = std::chrono::system_clock::now();
+    co_await store(key, cached);
+
+    const SharedPayloadCache::Entry entry = toEntry(std::move(cached));
+    local_.put(key, entry, std::chrono::seconds(opts_.ttl));
+
+    if (!ifNoneMatch.empty() && matches(ifNoneMatch, entry.etag)) {
+        co_return notModified(request, entry.etag);
+    }
+    // Same shape as a hit: first and following responses are byte-identical
+    co_return fromCache(request, entry);
+}
+
+net::awaitable<std::string> ResponseCacheMiddleware::generation() const {
+    try {
+        const auto gen = co_await cache_->get("rc:gen:" + opts_.scope);
+        co_return gen.value_or("0");
+    } catch (const std::exception& e) {
+        LoggerSingleton::get().warn("ResponseCacheMiddleware::generation: cache unavailable", {
+            {"scope", opts_.scope},
+            {"error", std::string(e.what())}
+        });
+    }
+    co_return std::string("0");
+}
+
+net::awaitable<void> ResponseCacheMiddleware::invalidate() const {
+    try {
+        co_await cache_->increment("rc:gen:" + opts_.scope);
+    } catch (const std::exception& e) {
+        LoggerSingleton::get().error("ResponseCacheMiddleware::invalidate: failed to bump generation", {
+            {"scope", opts_.scope},
+            {"error", std::string(e.what())}
+        });
+    }
+}
+
+net::awaitable<std::optional<CachedResponse>> ResponseCacheMiddleware::load(const std::string& key) const {
+    std::optional<std::string> raw;
+    try {
+        raw = co_await cache_->get(key);
+    } catch (const std::exception& e) {
+        LoggerSingleton::get().warn("ResponseCacheMiddleware::load: cache unavailable", {
+            {"key", key},
+            {"error", std::string(e.what())}
+        });
+    }
+    if (!raw) co_return std::nullopt;
+    co_return CachedResponse::decode(*raw);
+}
+
+net::awaitable<void> ResponseCacheMiddleware::store(const std::string& key, const CachedResponse& cached) const {
+    try {
+        co_await cache_->set(key, cached.encode(), opts_.ttl);
+    } catch (const std::exception& e) {
+        LoggerSingleton::get().warn("ResponseCacheMiddleware::store: cache unavailable", {
+            {"key", key},
+            {"error", std::string(e.what())}
+        });
+    }
+}
+
+Response ResponseCacheMiddleware::notModified(const Request& request, const std::string& etag) {
+    // 304 has no body and no Content-Length of its own
+    Response response{http::status::not_modified, request.version()};
+    response.set(http::field::server, "beast-coawait");
+    response.set(http::field::etag, etag);
+    response.set(http::field::cache_control, kCacheControl);
+    response.keep_alive(request.keep_alive());
+    return response;
+}
+
+SharedPayloadCache::Entry ResponseCacheMiddleware::toEntry(CachedResponse&& cached) {
+    std::vector<std::pair<http::field, std::string>> headers{
+        {http::field::server, "beast-coawait"},
+        {http::field::etag, cached.etag},
+        {http::field::cache_control, std::string(kCacheControl)},
+    };
+    if (!cached.contentType.empty()) headers.emplace_back(http::field::content_type, cached.contentType);
+
+    SharedPayloadCache::Entry entry;
+    entry.status = cached.status;
+    entry.etag = cached.etag;
+    entry.payload = SharedPayload::make(std::move(cached.body), headers);
+    return entry;
+}
+
+Response ResponseCacheMiddleware::fromCache(const Request& request, const SharedPayloadCache::Entry& entry) {
+    // Pointer copy; HEAD is handled by the session (Content-Length of the payload, no body)
+    return Response::shared(
+        static_cast<http::status>(entry.status),
+        request.version(),
+        request.keep_alive(),
+        entry.payload
+    );
+}
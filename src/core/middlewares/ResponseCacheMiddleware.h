@@ -0,0 +1,56 @@
+#pragma once
+#include <memory>
+#include <string>
+
+#include "core/caching/CachedResponse.h"
+#include "core/caching/SharedPayloadCache.h"
+#include "core/caching/interfaces/CacheInterface.h"
+#include "core/interfaces/MiddlewareInterface.h"
+
+/// Route-level response cache with strong ETags and conditional GET/HEAD.
+///
+///  - GET/HEAD: rendered 200 bodies are stored by path + sorted query + principal, ETag = sha256(body);
+///    a matching If-None-Match is answered 304 straight from the cache, the handler is not invoked;
+///    HEAD is answered from stored metadata (Content-Length without body);
+///    hot entries are kept as shared payloads, a hit is written without copying the body.
+///  - POST/PUT/PATCH/DELETE with 2xx bump the scope generation, every stored entry of the scope is orphaned.
+/// Register after authentication (key includes user_id). The same instance may be attached to several
+/// prefixes (e.g. /users and /register) so writes through any of them invalidate the scope.
+class ResponseCacheMiddleware final : public MiddlewareInterface {
+public:
+    struct Options {
+        /// Generation counter namespace
+        std::string scope;
+        /// Seconds, entries are additionally invalidated by scope generation
+        int ttl = 30;
+        /// Process-local shared payloads in front of the cache
+        std::size_t localEntries = 1024;
+    };
+
+    ResponseCacheMiddleware(std::shared_ptr<CachingInterface> cache, Options options)
+        : cache_(std::move(cache)),
+          opts_(std::move(options)),
+          local_(SharedPayloadCache::Options{.maxEntries = opts_.localEntries}) {}
+
+    net::awaitable<Outcome> handle(Request& request, Next next) override;
+
+    /// Quoted hex sha256 of the body
+    static std::string etagFor(std::string_view body);
+    /// If-None-Match semantics (weak comparison, lists, "*")
+    static bool matches(std::string_view ifNoneMatch, std::string_view etag);
+
+private:
+    std::shared_ptr<CachingInterface> cache_;
+    Options opts_;
+    SharedPayloadCache local_;
+
+    net::awaitable<std::string> generation() const;
+    net::awaitable<void> invalidate() const;
+    net::awaitable<std::optional<CachedResponse>> load(const std::string& key) const;
+    net::awaitable<void> store(const std::string& key, const CachedResponse& cached) const;
+
+    [[nodiscard]] static Response notModified(const Request& request, const std::string& etag);
+    /// Takes the body: it becomes the shared payload
+    [[nodiscard]] static SharedPayloadCache::Entry toEntry(CachedResponse&& cached);
+    [[nodiscard]] static Response fromCache(const Request& request, const SharedPayloadCache::Entry& entry);
+};
@@ -0,0 +1,114 @@
+#include "core/middlewares/ServeStaleMiddleware.h"
+#include "core/caching/RequestKey.h"
+#include "core/errors/Errors.h"
+#include "core/loggers/LoggerSingleton.h"
+#include "core/renderers/json/JsonRenderer.h"
+
+namespace {
+    constexpr std::string_view kWarningStale = R"(110 - "Response is Stale")";
+    constexpr std::string_view kWarningRevalidationFailed = R"(111 - "Revalidation Failed")";
+}
+
+std::string ServeStaleMiddleware::keyFor(const Request& request) {
+    return "stale:" + RequestKey::build(request);
+}
+
+net::awaitable<Outcome> ServeStaleMiddleware::handle(Request& request, Next next) {
+    if (request.method() != http::verb::get) {
+        co_return co_await next(request);
+    }
+
+    const std::string key = keyFor(request);
+
+    // Breaker open or queue saturated: do not add load, answer from what we have
+    if (pool_->degraded()) {
+        if (const auto stale = co_await load(key)) {
+            LoggerSingleton::get().warn("ServeStaleMiddleware::handle: database degraded, serving stale", {
+                {"key", key},
+                {"age", static_cast<int64_t>(stale->age(std::chrono::system_clock::now()).count())}
+            });
+            co_return serve(request, *stale, kWarningStale);
+        }
+    }
+
+    std::optional<Outcome> outcome;
+    std::optional<std::string> unavailable;
+    try {
+        outcome = co_await next(request);
+    } catch (const DbUnavailableError& e) {
+        unavailable = e.what();
+    }
+
+    if (unavailable) {
+        if (const auto stale = co_await load(key)) {
+            LoggerSingleton::get().warn("ServeStaleMiddleware::handle: database unavailable, serving stale", {
+                {"key", key},
+                {"error", *unavailable},
+                {"age", static_cast<int64_t>(stale->age(std::chrono::system_clock::now()).count())}
+            });
+            co_return serve(request, *stale, kWarningRevalidationFailed);
+        }
+        throw DbUnavailableError(*unavailable);
+    }
+
+    // Render here to keep exactly the bytes we are going to send
+    Response response = JsonRenderer::toResponse(request, std::move(*outcome));
+
+    // A shared payload leaves body() empty, storing it would serve an empty 200 later
+    if (response.result() == http::status::ok && !response.sharedPayload() && response.body().size() <= opts_.maxBodyBytes) {
+        co_await store(key, response);
+    }
+    co_return response;
+}
+
+net::awaitable<std::optional<CachedResponse>> ServeStaleMiddleware::load(const std::string& key) const {
+    std::optional<std::string> raw;
+    try {
+        raw = co_await cache_->get(key);
+    } catch (const std::exception& e) {
+        LoggerSingleton::get().warn("ServeStaleMiddleware::load: cache unavailable", {
+            {"key", key},
+            {"error", std::string(e.what())}
+        });
+    }
+    if (!raw) co_return std::nullopt;
+
+    auto cached = CachedResponse::decode(*raw);
+    if (!cached || cached->age(std::chrono::system_clock::now()) > opts_.maxStale) co_return std::nullopt;
+    co_return cached;
+}
+
+net::awaitable<void> ServeStaleMiddleware::store(const std::string& key, const Response& response) const {
+    CachedResponse cached;
+    cached.status = response.result_int();
+    if (const auto it = response.find(http::field::content_type); it != response.end()) {
+        cached.contentType = std::string(it->value());
+    }
+    cached.body = response.body();
+    cached.storedAt = std::chrono::system_clock::now();
+
+    try {
+        co_await cache_->set(key, cached.encode(), static_cast<int>(opts_.maxStale.count()));
+    } catch (const std::exception& e) {
+        LoggerSingleton::get().warn("ServeStaleMiddleware::store: cache unavailable", {
+            {"key", key},
+            {"error", std::string(e.what())}
+        });
+    }
+}
+
+Response ServeStaleMiddleware::serve(
+    const Request& request,
+    const CachedResponse& cached,
+    const std::string_view warning
+) const {
+    Response response{static_cast<http::status>(cached.status), request.version()};
+    response.set(http::field::server, "beast-coawait");
+    if (!cached.contentType.empty()) response.set(http::field::content_type, cached.contentType);
+    response.set(http::field::age, std::to_string(cached.age(std::chrono::system_clock::now()).count()));
+    response.set(http::field::warning, warning);
+    response.keep_alive(request.keep_alive());
+    response.body() = cached.body;
+    response.prepare_payload();
+    return response;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "core/caching/CachedResponse.h"
+#include "core/caching/interfaces/CacheInterface.h"
+#include "core/db/postgres/interfaces/PgPoolInterface.h"
+#include "core/interfaces/MiddlewareInterface.h"
+
+/// Keeps the last known good GET 200 response and serves it while the database is unavailable.
+///
+/// Stale response is served when:
+///  - PgPool is degraded (breaker open, waiter queue saturated) -> no query at all, Warning: 110;
+///  - the handler fails with DbUnavailableError                   -> Warning: 111.
+/// Older than maxStale is never served, the original error goes on to the router.
+/// Bodies over maxBodyBytes and shared payloads (answered from the response cache) are not stored.
+/// Register per route (scoped use) after authentication: key includes user_id.
+class ServeStaleMiddleware final : public MiddlewareInterface {
+public:
+    struct Options {
+        /// Oldest response allowed to be served, also the storage ttl
+        std::chrono::seconds maxStale{60};
+        /// Larger bodies are not kept: a copy per key and user would outweigh the outage it covers
+        std::size_t maxBodyBytes = 256 * 1024;
+    };
+
+    ServeStaleMiddleware(
+        std::shared_ptr<CachingInterface> cache,
+        std::shared_ptr<PgPoolInterface> pool,
+        const Options options
+    ) : cache_(std::move(cache)), pool_(std::move(pool)), opts_(options) {}
+
+    net::awaitable<Outcome> handle(Request& request, Next next) override;
+
+    /// path + sorted query + principal
+    static std::string keyFor(const Request& request);
+
+private:
+    std::shared_ptr<CachingInterface> cache_;
+    std::shared_ptr<PgPoolInterface> pool_;
+    Options opts_;
+
+    net::awaitable<std::optional<CachedResponse>> load(const std::string& key) const;
+    net::awaitable<void> store(const std::string& key, const Response& response) const;
+    [[nodiscard]] Response serve(const Request& request, const CachedResponse& cached, std::string_view warning) const;
+};
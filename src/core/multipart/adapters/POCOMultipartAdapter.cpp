@@ -8,6 +8,7 @@
 #include <Poco/Net/MessageHeader.h>
 #include <Poco/StreamCopier.h>
 #include <Poco/Exception.h>
+#include <algorithm>
 
 #include "core/errors/Errors.h"
 
@@ -87,7 +88,9 @@ std::string POCOMultipartAdapter::headerGet(const Poco::Net::MessageHeader& h, c
 
 std::string POCOMultipartAdapter::trimCopy(std::string s) {
     auto isSpace = [](const unsigned char c) { return std::isspace(c) != 0;};
-    while (!s.empty() && isSpace(static_cast<unsigned char>(s.front()))) s.erase(s.begin());
+    // One erase for the whole prefix: erasing char by char from the front is quadratic in its length
+    const auto first = std::find_if_not(s.begin(), s.end(), [&](const char c) { return isSpace(static_cast<unsigned char>(c)); });
+    s.erase(s.begin(), first);
     while (!s.empty() && isSpace(static_cast<unsigned char>(s.back()))) s.pop_back();
     return s;
 }
@@ -20,6 +20,21 @@ net::awaitable<Outcome> SwaggerController::index(const Request& request) const{
         "/openapi/"
     );
 }
+
+net::awaitable<Outcome> SwaggerController::document(const Request& request) const {
+    if (!document_) {
+        co_return JsonRenderer{}.error(request, http::status::not_found, "Not found", request.keep_alive());
+    }
+    co_return Response::shared(http::status::ok, request.version(), request.keep_alive(), document_);
+}
+
+void SwaggerController::setDocument(std::string document) {
+    document_ = SharedPayload::make(std::move(document), {
+        {http::field::server, "beast-coawait"},
+        {http::field::content_type, "application/json"},
+    });
+}
+
 //
 // Created by user on 27.02.2026.
 //
@@ -9,6 +9,7 @@
 #include "../../renderers/json/JsonRenderer.h"
 #include "core/http/ResponseTypes.h"
 #include <fstream>
+#include <memory>
 #include <utility>
 
 class SwaggerController {
@@ -18,9 +19,15 @@ public:
     ) : rootPath_(std::move(rootPath)) {};
 
     [[nodiscard]] net::awaitable<Outcome> index(const Request& request) const;
+    /// Generated document from memory, every response shares one payload
+    [[nodiscard]] net::awaitable<Outcome> document(const Request& request) const;
+
+    /// Called once, after routes are registered
+    void setDocument(std::string document);
 
 private:
     std::filesystem::path rootPath_;
+    std::shared_ptr<const SharedPayload> document_;
 };
 
 #endif //BEAST_API_SWAGGERCONTROLLER_H
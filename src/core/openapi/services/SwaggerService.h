@@ -11,14 +11,16 @@
 class SwaggerService
 {
 public:
-    /// Sync, works only on build
-    static void generate(const Router& router, const std::filesystem::path& rootPath)
+    /// Sync, works only on build. Returns the written document to be served from memory as well
+    static std::string generate(const Router& router, const std::filesystem::path& rootPath)
     {
         const Json documentation = OpenApiBuilder::build(router);
+        std::string dumped = documentation.dump(4);
 
         std::ofstream file(rootPath / "public/openapi/swagger.json");
-        file << documentation.dump(4);
+        file << dumped;
         file.close();
+        return dumped;
     }
 };
 
@@ -0,0 +1,152 @@
+#include "core/profiling/AllocationTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+namespace profiling {
+    namespace {
+        constexpr std::size_t kMaxThreads = 512;
+
+        struct alignas(64) ThreadBlock {
+            std::atomic<std::uint64_t> allocations{0};
+            std::atomic<std::uint64_t> frees{0};
+            std::atomic<std::uint64_t> allocatedBytes{0};
+            std::atomic<std::uint64_t> freedBytes{0};
+        };
+
+        /// Static storage: claiming a block must not allocate, it happens inside operator new.
+        /// Block 0 is shared by threads past kMaxThreads (RMW there, single writer elsewhere).
+        ThreadBlock blocks[kMaxThreads];
+        std::atomic<std::size_t> claimed{1};
+
+        ThreadBlock* claimBlock() noexcept {
+            const std::size_t index = claimed.fetch_add(1, std::memory_order_relaxed);
+            return index < kMaxThreads ? &blocks[index] : &blocks[0];
+        }
+
+        ThreadBlock& block() noexcept {
+            thread_local ThreadBlock* mine = claimBlock();
+            return *mine;
+        }
+
+        void bump(std::atomic<std::uint64_t>& counter, const std::uint64_t n, const bool shared) noexcept {
+            if (shared) counter.fetch_add(n, std::memory_order_relaxed);
+            else counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        [[maybe_unused]] void onAllocate(void* ptr) noexcept {
+            if (!ptr) return;
+            ThreadBlock& b = block();
+            const bool shared = &b == &blocks[0];
+            bump(b.allocations, 1, shared);
+            bump(b.allocatedBytes, ::malloc_usable_size(ptr), shared);
+        }
+
+        [[maybe_unused]] void onFree(void* ptr) noexcept {
+            if (!ptr) return;
+            ThreadBlock& b = block();
+            const bool shared = &b == &blocks[0];
+            bump(b.frees, 1, shared);
+            bump(b.freedBytes, ::malloc_usable_size(ptr), shared);
+        }
+
+        [[maybe_unused]] void* allocate(const std::size_t size, const std::size_t alignment, const bool nothrow) {
+            const std::size_t n = size ? size : 1;
+            void* ptr = nullptr;
+            while (true) {
+                ptr = alignment > alignof(std::max_align_t)
+                    ? std::aligned_alloc(alignment, (n + alignment - 1) / alignment * alignment)
+                    : std::malloc(n);
+                if (ptr) break;
+                const std::new_handler handler = std::get_new_handler();
+                if (!handler) {
+                    if (nothrow) return nullptr;
+                    throw std::bad_alloc();
+                }
+                handler();
+            }
+            onAllocate(ptr);
+            return ptr;
+        }
+
+        [[maybe_unused]] void deallocate(void* ptr) noexcept {
+            onFree(ptr);
+            std::free(ptr);
+        }
+    }
+
+    AllocationCounts AllocationTracker::thisThread() noexcept {
+        if constexpr (!kEnabled) return {};
+        const ThreadBlock& b = block();
+        return {b.allocations.load(std::memory_order_relaxed), b.allocatedBytes.load(std::memory_order_relaxed)};
+    }
+
+    AllocationTracker::MallocStats AllocationTracker::mallocStats() noexcept {
+        MallocStats stats;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+        const struct mallinfo2 info = ::mallinfo2();
+        stats.arenaBytes = info.arena;
+        stats.mmappedBytes = info.hblkhd;
+        stats.inUseBytes = info.uordblks + info.hblkhd;
+        stats.freeBytes = info.fordblks;
+        stats.releasableBytes = info.keepcost;
+#endif
+        return stats;
+    }
+
+    AllocationTracker::Totals AllocationTracker::totals() noexcept {
+        Totals totals;
+        if constexpr (!kEnabled) return totals;
+        const std::size_t used = std::min(claimed.load(std::memory_order_relaxed), kMaxThreads);
+        totals.threads = claimed.load(std::memory_order_relaxed) - 1;
+        for (std::size_t i = 0; i < used; ++i) {
+            totals.allocations += blocks[i].allocations.load(std::memory_order_relaxed);
+            totals.frees += blocks[i].frees.load(std::memory_order_relaxed);
+            totals.allocatedBytes += blocks[i].allocatedBytes.load(std::memory_order_relaxed);
+            totals.freedBytes += blocks[i].freedBytes.load(std::memory_order_relaxed);
+        }
+        return totals;
+    }
+}
+
+#if APP_ALLOC_TRACKING
+// Replaceable global allocation functions: every variant has to be replaced, the library defaults
+// of the missing ones would pair a tracked new with an untracked delete
+void* operator new(const std::size_t size) { return profiling::allocate(size, 0, false); }
+void* operator new[](const std::size_t size) { return profiling::allocate(size, 0, false); }
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept {
+    try { return profiling::allocate(size, 0, true); } catch (...) { return nullptr; }
+}
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept {
+    try { return profiling::allocate(size, 0, true); } catch (...) { return nullptr; }
+}
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+    return profiling::allocate(size, static_cast<std::size_t>(alignment), false);
+}
+void* operator new[](const std::size_t size, const std::align_val_t alignment) {
+    return profiling::allocate(size, static_cast<std::size_t>(alignment), false);
+}
+void* operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return profiling::allocate(size, static_cast<std::size_t>(alignment), true); } catch (...) { return nullptr; }
+}
+void* operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return profiling::allocate(size, static_cast<std::size_t>(alignment), true); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* ptr) noexcept { profiling::deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { profiling::deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { profiling::deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { profiling::deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { profiling::deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { profiling::deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { profiling::deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { profiling::deallocate(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { profiling::deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { profiling::deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { profiling::deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { profiling::deallocate(ptr); }
+#endif
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+
+#ifndef APP_ALLOC_TRACKING
+#define APP_ALLOC_TRACKING 0
+#endif
+
+namespace profiling {
+    struct AllocationCounts {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+
+        AllocationCounts operator-(const AllocationCounts& other) const noexcept {
+            return {allocations - other.allocations, bytes - other.bytes};
+        }
+    };
+
+    /// Global operator new/delete replacement counting allocations per thread (cmake -DAPP_ALLOC_TRACKING=ON).
+    ///
+    /// Every thread owns a counter block (single writer, relaxed load + store, as metrics shards):
+    /// the hooks never lock and never allocate. Sizes are malloc_usable_size(), so frees are matched
+    /// without a header in front of every block. Built without the option, everything here is a no-op
+    /// and the default operators are used.
+    class AllocationTracker {
+    public:
+        static constexpr bool kEnabled = APP_ALLOC_TRACKING != 0;
+
+        struct Totals {
+            std::uint64_t allocations = 0;
+            std::uint64_t frees = 0;
+            std::uint64_t allocatedBytes = 0;
+            std::uint64_t freedBytes = 0;
+            std::uint64_t threads = 0;
+
+            [[nodiscard]] std::uint64_t liveAllocations() const noexcept { return allocations > frees ? allocations - frees : 0; }
+            [[nodiscard]] std::uint64_t liveBytes() const noexcept { return allocatedBytes > freedBytes ? allocatedBytes - freedBytes : 0; }
+        };
+
+        /// Monotonic counters of the calling thread: per-request attribution takes deltas around resumptions
+        static AllocationCounts thisThread() noexcept;
+        /// Sum over all threads that ever allocated, approximate while they run
+        static Totals totals() noexcept;
+
+        /// glibc allocator view (mallinfo2), available without tracking; zeros elsewhere
+        struct MallocStats {
+            std::uint64_t arenaBytes = 0;
+            std::uint64_t mmappedBytes = 0;
+            std::uint64_t inUseBytes = 0;
+            std::uint64_t freeBytes = 0;
+            /// Could be given back to the OS by malloc_trim
+            std::uint64_t releasableBytes = 0;
+        };
+        static MallocStats mallocStats() noexcept;
+    };
+}
@@ -0,0 +1,315 @@
+#include "core/profiling/CpuProfiler.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <elf.h>
+#include <execinfo.h>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace profiling {
+    namespace {
+        constexpr int kMaxFrames = 64;
+        /// Frame 0 is the handler itself, 1 the signal trampoline
+        constexpr int kHandlerFrames = 2;
+        constexpr std::size_t kMaxSamples = 1u << 16;
+
+        struct Slot {
+            std::atomic<bool> ready{false};
+            long tid = 0;
+            int depth = 0;
+            void* frames[kMaxFrames]{};
+        };
+
+        /// Written by the SIGPROF handler on any thread: allocated before the timer is armed,
+        /// released after it is deleted and all handlers are done
+        struct Buffer {
+            std::unique_ptr<Slot[]> slots;
+            std::size_t capacity = 0;
+            std::atomic<std::size_t> next{0};
+            std::atomic<std::uint64_t> dropped{0};
+            std::atomic<int> inHandler{0};
+        };
+
+        Buffer buffer;
+        std::atomic<bool> collecting{false};
+
+        void onProfSignal(int) {
+            // Entered before the check: stop() flips collecting, then waits for inHandler to drain
+            buffer.inHandler.fetch_add(1);
+            if (!collecting.load()) {
+                buffer.inHandler.fetch_sub(1);
+                return;
+            }
+            const int savedErrno = errno;
+            const std::size_t index = buffer.next.fetch_add(1, std::memory_order_relaxed);
+            if (index < buffer.capacity) {
+                Slot& slot = buffer.slots[index];
+                slot.tid = static_cast<long>(::syscall(SYS_gettid));
+                slot.depth = ::backtrace(slot.frames, kMaxFrames);
+                slot.ready.store(true, std::memory_order_release);
+            } else {
+                buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            errno = savedErrno;
+            buffer.inHandler.fetch_sub(1);
+        }
+
+        void installHandler() {
+            static const bool installed = [] {
+                // backtrace() loads libgcc on first use, which allocates: never let that happen in the handler
+                void* warmup[1];
+                ::backtrace(warmup, 1);
+
+                struct sigaction action{};
+                action.sa_handler = onProfSignal;
+                sigemptyset(&action.sa_mask);
+                action.sa_flags = SA_RESTART;
+                return ::sigaction(SIGPROF, &action, nullptr) == 0;
+            }();
+            (void)installed;
+        }
+
+        std::string threadName(const long tid) {
+            std::ifstream comm("/proc/self/task/" + std::to_string(tid) + "/comm");
+            std::string name;
+            std::getline(comm, name);
+            if (name.empty()) name = "thread";
+            return name + "-" + std::to_string(tid);
+        }
+
+        /// GCC emits a coroutine body as "f(f()::_Z1fv.Frame*) [clone .actor]": show it as "f [coro]"
+        std::string coroutineAware(std::string name) {
+            constexpr std::string_view actor = " [clone .actor]";
+            if (!name.ends_with(actor)) return name;
+            name.resize(name.size() - actor.size());
+            if (name.ends_with(".Frame*)")) {
+                // The frame parameter repeats the function name: the '(' followed by the name itself opens it
+                for (std::size_t open = name.find('('); open != std::string::npos; open = name.find('(', open + 1)) {
+                    if (name.compare(open + 1, open, name, 0, open) == 0) {
+                        name.resize(open);
+                        break;
+                    }
+                }
+            }
+            return name + " [coro]";
+        }
+
+        /// .symtab of a module: dladdr only sees exported symbols, static functions and
+        /// coroutine bodies (local "f.actor" clones) live here
+        class ElfSymbols {
+        public:
+            explicit ElfSymbols(const char* path) {
+                std::ifstream file(path, std::ios::binary);
+                Elf64_Ehdr header{};
+                if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+                    || std::memcmp(header.e_ident, ELFMAG, SELFMAG) != 0 || header.e_ident[EI_CLASS] != ELFCLASS64) {
+                    return;
+                }
+                std::vector<Elf64_Shdr> sections(header.e_shnum);
+                file.seekg(static_cast<std::streamoff>(header.e_shoff));
+                if (!file.read(reinterpret_cast<char*>(sections.data()), static_cast<std::streamsize>(sections.size() * sizeof(Elf64_Shdr)))) return;
+
+                for (const Elf64_Shdr& section : sections) {
+                    if (section.sh_type != SHT_SYMTAB || section.sh_link >= sections.size()) continue;
+                    const Elf64_Shdr& strtab = sections[section.sh_link];
+                    std::vector<Elf64_Sym> symbols(section.sh_size / sizeof(Elf64_Sym));
+                    std::string names(strtab.sh_size, '\0');
+                    file.seekg(static_cast<std::streamoff>(section.sh_offset));
+                    file.read(reinterpret_cast<char*>(symbols.data()), static_cast<std::streamsize>(symbols.size() * sizeof(Elf64_Sym)));
+                    file.seekg(static_cast<std::streamoff>(strtab.sh_offset));
+                    file.read(names.data(), static_cast<std::streamsize>(names.size()));
+                    if (!file) return;
+
+                    for (const Elf64_Sym& symbol : symbols) {
+                        if (ELF64_ST_TYPE(symbol.st_info) != STT_FUNC || symbol.st_value == 0 || symbol.st_name >= names.size()) continue;
+                        functions_.push_back({symbol.st_value, symbol.st_size, names.c_str() + symbol.st_name});
+                    }
+                }
+                std::ranges::sort(functions_, {}, &Function::start);
+            }
+
+            /// offset: address relative to the module load base
+            [[nodiscard]] const char* find(const std::size_t offset) const {
+                auto it = std::ranges::upper_bound(functions_, offset, {}, &Function::start);
+                if (it == functions_.begin()) return nullptr;
+                --it;
+                return offset < it->start + std::max<std::size_t>(it->size, 1) ? it->name.c_str() : nullptr;
+            }
+
+        private:
+            struct Function {
+                std::size_t start;
+                std::size_t size;
+                std::string name;
+            };
+            std::vector<Function> functions_;
+        };
+
+        /// Symbolization runs on one thread per profile (the controller offloads it), cache is guarded anyway
+        const char* localSymbol(const Dl_info& info, void* address) {
+            static std::mutex mutex;
+            static std::unordered_map<std::string, std::unique_ptr<ElfSymbols>> modules;
+            if (!info.dli_fname) return nullptr;
+
+            std::lock_guard lock(mutex);
+            auto [module, fresh] = modules.try_emplace(info.dli_fname);
+            if (fresh) {
+                // The main executable reports argv[0], which may be relative or gone after chdir
+                const bool self = info.dli_fname[0] != '/';
+                module->second = std::make_unique<ElfSymbols>(self ? "/proc/self/exe" : info.dli_fname);
+            }
+            const auto offset = reinterpret_cast<std::size_t>(address) - reinterpret_cast<std::size_t>(info.dli_fbase);
+            return module->second->find(offset);
+        }
+
+        std::string symbolize(void* address) {
+            Dl_info info{};
+            const bool resolved = ::dladdr(address, &info) != 0;
+            if (resolved && !info.dli_sname) info.dli_sname = localSymbol(info, address);
+            if (!resolved || !info.dli_sname) {
+                // No symbol (static function, stripped binary): module + offset, resolvable with addr2line
+                const auto base = reinterpret_cast<std::size_t>(info.dli_fbase);
+                char hex[32];
+                std::snprintf(hex, sizeof(hex), "0x%zx", reinterpret_cast<std::size_t>(address) - base);
+                const char* module = info.dli_fname ? std::strrchr(info.dli_fname, '/') : nullptr;
+                return module ? std::string(module + 1) + "+" + hex : std::string(hex);
+            }
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            std::string name = status == 0 && demangled ? demangled : info.dli_sname;
+            std::free(demangled);
+            // ';' separates frames in the folded format
+            std::ranges::replace(name, ';', ':');
+            return coroutineAware(std::move(name));
+        }
+
+        /// Asio's scheduler and awaitable machinery sit between every two coroutine frames: one frame instead.
+        /// Only the qualified name counts, template arguments mention asio everywhere
+        bool isAsioInternal(const std::string& name) {
+            const std::size_t qualified = name.find("boost::asio::");
+            return qualified != std::string::npos && qualified < name.find('<') && qualified < name.find('(');
+        }
+    }
+
+    CpuProfiler& CpuProfiler::instance() {
+        static CpuProfiler profiler;
+        return profiler;
+    }
+
+    bool CpuProfiler::start(const int hz, const std::chrono::seconds maxDuration) {
+        if (hz <= 0 || running_.exchange(true, std::memory_order_acq_rel)) return false;
+        installHandler();
+
+        const auto threads = static_cast<std::size_t>(std::max(1L, ::sysconf(_SC_NPROCESSORS_ONLN)));
+        buffer.capacity = std::clamp<std::size_t>(
+            static_cast<std::size_t>(hz) * static_cast<std::size_t>(maxDuration.count()) * threads,
+            1024,
+            kMaxSamples
+        );
+        buffer.slots = std::make_unique<Slot[]>(buffer.capacity);
+        buffer.next.store(0, std::memory_order_relaxed);
+        buffer.dropped.store(0, std::memory_order_relaxed);
+
+        timer_t timer{};
+        sigevent event{};
+        event.sigev_notify = SIGEV_SIGNAL;
+        event.sigev_signo = SIGPROF;
+        if (::timer_create(CLOCK_PROCESS_CPUTIME_ID, &event, &timer) != 0) {
+            buffer.slots.reset();
+            running_.store(false, std::memory_order_release);
+            return false;
+        }
+        timer_ = timer;
+        hz_ = hz;
+        startedAt_ = std::chrono::steady_clock::now();
+        collecting.store(true);
+
+        const long periodNs = 1'000'000'000L / hz;
+        itimerspec spec{};
+        spec.it_interval.tv_sec = periodNs / 1'000'000'000L;
+        spec.it_interval.tv_nsec = periodNs % 1'000'000'000L;
+        spec.it_value = spec.it_interval;
+        ::timer_settime(timer, 0, &spec, nullptr);
+        return true;
+    }
+
+    CpuProfiler::Profile CpuProfiler::stop() {
+        Profile profile;
+        if (!running_.load(std::memory_order_acquire)) return profile;
+
+        ::timer_delete(static_cast<timer_t>(timer_));
+        timer_ = nullptr;
+        collecting.store(false);
+        // A signal raised just before timer_delete may still be running its handler
+        while (buffer.inHandler.load() != 0) std::this_thread::yield();
+
+        profile.hz = hz_;
+        profile.duration = std::chrono::steady_clock::now() - startedAt_;
+        profile.dropped = buffer.dropped.load(std::memory_order_relaxed);
+        const std::size_t count = std::min(buffer.next.load(std::memory_order_relaxed), buffer.capacity);
+        profile.samples.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const Slot& slot = buffer.slots[i];
+            if (!slot.ready.load(std::memory_order_acquire) || slot.depth <= kHandlerFrames) continue;
+            profile.samples.push_back(Sample{
+                slot.tid,
+                std::vector<void*>(slot.frames + kHandlerFrames, slot.frames + slot.depth)
+            });
+        }
+        buffer.slots.reset();
+        buffer.capacity = 0;
+        running_.store(false, std::memory_order_release);
+        return profile;
+    }
+
+    std::string CpuProfiler::folded(const Profile& profile) {
+        std::unordered_map<void*, std::string> symbols;
+        std::unordered_map<long, std::string> threads;
+        std::map<std::string, std::uint64_t> stacks;
+
+        for (const Sample& sample : profile.samples) {
+            auto [thread, newThread] = threads.try_emplace(sample.tid);
+            if (newThread) thread->second = threadName(sample.tid);
+
+            std::string line = thread->second;
+            bool previousAsio = false;
+            // backtrace() is leaf first, folded stacks are root first
+            for (auto it = sample.frames.rbegin(); it != sample.frames.rend(); ++it) {
+                auto [symbol, fresh] = symbols.try_emplace(*it);
+                if (fresh) symbol->second = symbolize(*it);
+
+                const bool asio = isAsioInternal(symbol->second);
+                if (asio && previousAsio) continue;
+                previousAsio = asio;
+                line += ';';
+                line += asio ? "[asio]" : symbol->second;
+            }
+            ++stacks[line];
+        }
+
+        std::vector<std::pair<std::string, std::uint64_t>> sorted(stacks.begin(), stacks.end());
+        std::ranges::sort(sorted, [](const auto& a, const auto& b) { return a.second > b.second; });
+
+        std::string out;
+        for (const auto& [stack, count] : sorted) {
+            out += stack;
+            out += ' ';
+            out += std::to_string(count);
+            out += '\n';
+        }
+        return out;
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace profiling {
+    /// Sampling CPU profiler for the whole process, no perf or ptrace needed.
+    ///
+    /// A POSIX timer on CLOCK_PROCESS_CPUTIME_ID raises SIGPROF every 1/hz of consumed CPU; the kernel
+    /// delivers it to the thread that is running, so every thread (I/O loop, blocking pool, logger) is sampled
+    /// in proportion to the CPU it burns. The handler only copies backtrace() into a preallocated buffer,
+    /// symbolization happens after stop(). One session at a time.
+    class CpuProfiler {
+    public:
+        struct Sample {
+            long tid = 0;
+            std::vector<void*> frames;
+        };
+
+        struct Profile {
+            std::vector<Sample> samples;
+            /// Buffer was full
+            std::uint64_t dropped = 0;
+            int hz = 0;
+            std::chrono::nanoseconds duration{0};
+        };
+
+        static CpuProfiler& instance();
+
+        /// false: another session is running or the timer could not be created
+        bool start(int hz, std::chrono::seconds maxDuration);
+        Profile stop();
+        [[nodiscard]] bool running() const noexcept { return running_.load(std::memory_order_relaxed); }
+
+        /// Folded stacks (Brendan Gregg's flamegraph.pl, speedscope, inferno): "thread;outer;...;leaf count"
+        static std::string folded(const Profile& profile);
+
+    private:
+        CpuProfiler() = default;
+
+        std::atomic<bool> running_{false};
+        std::chrono::steady_clock::time_point startedAt_{};
+        int hz_ = 0;
+        /// timer_t
+        void* timer_ = nullptr;
+    };
+}
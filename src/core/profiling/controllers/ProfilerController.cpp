@@ -0,0 +1,116 @@
+#include "core/profiling/controllers/ProfilerController.h"
+#include "core/helpers/Offload.h"
+#include "core/loggers/Log.h"
+#include "core/loggers/LoggerSingleton.h"
+#include "core/profiling/AllocationTracker.h"
+#include "core/profiling/CpuProfiler.h"
+
+#include <algorithm>
+#include <optional>
+
+namespace {
+    std::optional<long> queryNumber(
+        const std::unordered_map<std::string, std::string>& query,
+        const std::string& key,
+        const long fallback
+    ) {
+        const auto it = query.find(key);
+        if (it == query.end() || it->second.empty()) return fallback;
+        try {
+            std::size_t parsed = 0;
+            const long value = std::stol(it->second, &parsed);
+            if (parsed != it->second.size() || value <= 0) return std::nullopt;
+            return value;
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    }
+
+    /// Session must end even when the coroutine is destroyed mid-wait (shutdown, dropped connection)
+    struct SessionGuard {
+        bool active = true;
+        ~SessionGuard() {
+            if (active) (void)profiling::CpuProfiler::instance().stop();
+        }
+    };
+}
+
+net::awaitable<Outcome> ProfilerController::profile(const Request& request) const {
+    const auto query = request.query();
+    const auto seconds = queryNumber(query, "seconds", options_.defaultDuration.count());
+    const auto hz = queryNumber(query, "hz", options_.defaultHz);
+    if (!seconds || !hz) {
+        co_return JsonResult{
+            json{{"error", "seconds and hz must be positive integers"}},
+            http::status::bad_request,
+            request.keep_alive()
+        };
+    }
+    const auto duration = std::chrono::seconds(std::min<long>(*seconds, options_.maxDuration.count()));
+    const int frequency = static_cast<int>(std::min<long>(*hz, options_.maxHz));
+
+    auto& profiler = profiling::CpuProfiler::instance();
+    if (!profiler.start(frequency, duration)) {
+        co_return JsonResult{
+            json{{"error", "Profiler is busy"}},
+            http::status::conflict,
+            request.keep_alive()
+        };
+    }
+    LOG_INFO("ProfilerController::profile: started",
+        {"seconds", static_cast<std::int64_t>(duration.count())},
+        {"hz", frequency}
+    );
+
+    SessionGuard guard;
+    net::steady_timer timer(co_await net::this_coro::executor);
+    timer.expires_after(duration);
+    boost::system::error_code ec;
+    co_await timer.async_wait(net::redirect_error(net::use_awaitable, ec));
+    guard.active = false;
+    auto samples = std::make_shared<profiling::CpuProfiler::Profile>(profiler.stop());
+
+    // dladdr + ELF symbol tables: milliseconds to seconds, never on the I/O loop
+    auto fold = [samples]() { return profiling::CpuProfiler::folded(*samples); };
+    std::string folded = co_await async_offload(blockingPool_.get_executor(), std::move(fold));
+
+    Response response{http::status::ok, request.version()};
+    response.set(http::field::content_type, "text/plain; charset=utf-8");
+    response.set(http::field::cache_control, "no-store");
+    response.set("X-Profile-Samples", std::to_string(samples->samples.size()));
+    response.set("X-Profile-Dropped", std::to_string(samples->dropped));
+    response.set("X-Profile-Hz", std::to_string(samples->hz));
+    response.keep_alive(request.keep_alive());
+    response.body() = std::move(folded);
+    response.prepare_payload();
+    co_return response;
+}
+
+net::awaitable<Outcome> ProfilerController::heap(const Request& request) const {
+    using profiling::AllocationTracker;
+    const AllocationTracker::MallocStats malloc = AllocationTracker::mallocStats();
+
+    json body{
+        {"tracking", AllocationTracker::kEnabled},
+        {"malloc", {
+            {"arena_bytes", malloc.arenaBytes},
+            {"mmapped_bytes", malloc.mmappedBytes},
+            {"in_use_bytes", malloc.inUseBytes},
+            {"free_bytes", malloc.freeBytes},
+            {"releasable_bytes", malloc.releasableBytes}
+        }}
+    };
+    if constexpr (AllocationTracker::kEnabled) {
+        const AllocationTracker::Totals totals = AllocationTracker::totals();
+        body["allocations"] = {
+            {"total", totals.allocations},
+            {"frees", totals.frees},
+            {"live", totals.liveAllocations()},
+            {"allocated_bytes", totals.allocatedBytes},
+            {"freed_bytes", totals.freedBytes},
+            {"live_bytes", totals.liveBytes()},
+            {"threads", totals.threads}
+        };
+    }
+    co_return JsonResult{body, http::status::ok, request.keep_alive()};
+}
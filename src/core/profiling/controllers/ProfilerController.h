@@ -0,0 +1,32 @@
+#pragma once
+#include "core/http/interfaces/HttpInterface.h"
+#include "core/http/ResponseTypes.h"
+#include "core/request/Request.h"
+
+#include <boost/asio/thread_pool.hpp>
+#include <chrono>
+
+/// GET /debug/pprof/profile?seconds=N&hz=M: samples every thread for N seconds (CpuProfiler),
+/// answers with folded stacks for flame graphs. GET /debug/heap: allocator snapshot (AllocationTracker).
+/// Debug only: routed behind auth and PROFILER_ENABLED
+class ProfilerController {
+public:
+    struct Options {
+        std::chrono::seconds defaultDuration{30};
+        std::chrono::seconds maxDuration{60};
+        /// Not a multiple of common timer frequencies, avoids lockstep sampling
+        int defaultHz = 99;
+        int maxHz = 1000;
+    };
+
+    explicit ProfilerController(net::thread_pool& blockingPool) : ProfilerController(blockingPool, Options{}) {}
+    ProfilerController(net::thread_pool& blockingPool, const Options options)
+        : blockingPool_(blockingPool), options_(options) {}
+
+    [[nodiscard]] net::awaitable<Outcome> profile(const Request& request) const;
+    [[nodiscard]] net::awaitable<Outcome> heap(const Request& request) const;
+
+private:
+    net::thread_pool& blockingPool_;
+    Options options_;
+};
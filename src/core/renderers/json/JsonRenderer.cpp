@@ -33,6 +33,24 @@ Response JsonRenderer::render(
     return response;
 }
 
+Response JsonRenderer::toResponse(const Request& request, Outcome&& outcome) {
+    return std::visit([&]<typename T0>(T0&& v) -> Response {
+        using T = std::decay_t<T0>;
+        if constexpr (std::is_same_v<T, Response>) {
+            return std::forward<T0>(v);
+        } else {
+            return JsonRenderer{}.render(
+                request,
+                v.status,
+                v.body,
+                v.keepAlive,
+                {},
+                v.dumpIndent
+            );
+        }
+    }, std::move(outcome));
+}
+
 Response JsonRenderer::error(
     const Request& request,
     http::status status,
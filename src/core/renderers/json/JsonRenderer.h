@@ -2,6 +2,7 @@
 
 
 #include "core/renderers/interfaces/RendererInterface.h"
+#include "core/http/ResponseTypes.h"
 
 
 class JsonRenderer final : public RendererInterface{
@@ -24,4 +25,7 @@ public:
         std::unordered_map<http::field, std::string> additionalHeaders = {},
         int dumpIndent = -1
     ) override;
+
+    /// Handler outcome -> wire response (JsonResult is rendered, Response passes through)
+    static Response toResponse(const Request& request, Outcome&& outcome);
 };
@@ -1,12 +1,12 @@
 #pragma once
 
-#include "core/db/postgres/interfaces/PgPool.h"
+#include "core/db/postgres/interfaces/PgPoolInterface.h"
 #include <memory>
 
 class BaseRepository {
 public:
-    explicit BaseRepository(std::shared_ptr<PgPool> pool) : pool_(std::move(pool)) {}
+    explicit BaseRepository(std::shared_ptr<PgPoolInterface> pool) : pool_(std::move(pool)) {}
 
 protected:
-    std::shared_ptr<PgPool> pool_;
+    std::shared_ptr<PgPoolInterface> pool_;
 };
@@ -13,6 +13,7 @@
 #include "core/http/ResponseTypes.h"
 #include "core/loggers/LoggerSingleton.h"
 #include "core/multipart/MultipartAdapterFactory.h"
+#include "core/tracing/Span.h"
 
 struct MultipartPart {
     std::string name;
@@ -114,6 +115,9 @@ public:
     }
 
     void parseMultipart() {
+        trace::Span span("multipart.parse");
+        const trace::PhaseTimer timer(trace::Phase::Parse);
+        span.setAttribute("size", static_cast<std::int64_t>(body().size()));
         const auto adapter = MultipartAdapterFactory::create(env_.multipart_adapter);
 
         auto parts = adapter->parse(content_type(), body());
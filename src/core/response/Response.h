@@ -6,6 +6,7 @@
 #define BEAST_API_RESPONSE_H
 
 #include "core/http/interfaces/HttpInterface.h"
+#include "core/http/SharedPayload.h"
 
 class Response final : public RawResponse
 {
@@ -26,6 +27,25 @@ public:
         res.prepare_payload();
         return res;
     }
+
+    /// Response over a shared immutable payload: body() stays empty, HttpSession writes the payload zero-copy
+    static Response shared(
+        const http::status code,
+        const unsigned version,
+        const bool keepAlive,
+        std::shared_ptr<const SharedPayload> payload
+    ) {
+        Response res{code, version};
+        res.keep_alive(keepAlive);
+        res.share(std::move(payload));
+        return res;
+    }
+
+    void share(std::shared_ptr<const SharedPayload> payload) { shared_ = std::move(payload); }
+    [[nodiscard]] const std::shared_ptr<const SharedPayload>& sharedPayload() const noexcept { return shared_; }
+
+private:
+    std::shared_ptr<const SharedPayload> shared_;
 };
 
 #endif //BEAST_API_RESPONSE_H
@@ -2,7 +2,11 @@
 #include "core/errors/Errors.h"
 #include "core/renderers/json/JsonRenderer.h"
 #include <boost/beast/http.hpp>
+#include "core/loggers/Log.h"
 #include "core/loggers/LoggerSingleton.h"
+#include "core/metrics/MetricsRegistry.h"
+#include "core/tracing/Span.h"
+#include <boost/core/demangle.hpp>
 #include <algorithm>
 #include <ranges>
 #include <sstream>
@@ -51,6 +55,48 @@ std::vector<std::shared_ptr<MiddlewareInterface>> Router::collectMiddlewaresFor(
     return out;
 }
 
+static std::string_view toStdView(const boost::beast::string_view sv) {
+    return {sv.data(), sv.size()};
+}
+
+struct RouterMetrics {
+    metrics::Family<metrics::Counter> requests;
+    metrics::Family<metrics::Histogram> latency;
+    metrics::Gauge inFlight;
+};
+
+static const RouterMetrics& routerMetrics() {
+    auto& registry = metrics::MetricsRegistry::instance();
+    static const RouterMetrics m{
+        registry.counterFamily("http_requests_total", "HTTP requests by route and status", {"method", "route", "status"}),
+        registry.histogramFamily("http_request_duration_seconds", "Time from dispatch to rendered response", {"method", "route", "status"}),
+        registry.gauge("http_requests_in_flight", "Requests being dispatched")
+    };
+    return m;
+}
+
+static void recordRequest(
+    const http::verb method,
+    const std::string& route,
+    const unsigned status,
+    const std::chrono::steady_clock::duration elapsed
+) {
+    const RouterMetrics& m = routerMetrics();
+    const std::string statusText = std::to_string(status);
+    const std::string_view methodText = toStdView(http::to_string(method));
+    m.requests.with({methodText, route, statusText}).inc();
+    m.latency.with({methodText, route, statusText}).observe(elapsed);
+    m.inFlight.dec();
+}
+
+/// Adds its lifetime to total, exception paths included
+struct Stopwatch {
+    std::chrono::steady_clock::duration& total;
+    std::chrono::steady_clock::time_point startedAt = std::chrono::steady_clock::now();
+
+    ~Stopwatch() { total += std::chrono::steady_clock::now() - startedAt; }
+};
+
 static std::string buildAllowHeader(const Router::MethodMap& mm) {
     struct Item { http::verb verb; const char* name; };
     static constexpr Item items[]{
@@ -115,6 +161,15 @@ Outcome Router::make500(const Request& request, const std::string& err) {
     return JsonRenderer{}.error(request, http::status::internal_server_error, err, false);
 }
 
+Outcome Router::make503(const Request& request, const std::string& err) {
+    const std::unordered_map<http::field, std::string> additionalHeaders = {
+        {http::field::retry_after, "5"}
+    };
+    return JsonRenderer{}.error(
+        request, http::status::service_unavailable, err, false, additionalHeaders
+    );
+}
+
 Outcome Router::makeOptionsAllow(const Request& request, const MethodMap& mm) {
     const std::unordered_map<http::field, std::string> additionalHeaders = {
         {http::field::allow, buildAllowHeader(mm)}
@@ -133,19 +188,47 @@ std::string Router::normalizeTarget(const Request& request) {
 net::awaitable<Outcome> Router::runChain(Request& request, RouteFn leaf, std::vector<std::shared_ptr<MiddlewareInterface>>& middlewares) {
     // Compiling chain of middleware to one next()
     using Next = MiddlewareInterface::Next;
+    using Clock = std::chrono::steady_clock;
 
-    Next next = [leaf](Request& r) -> net::awaitable<Outcome> {
+    // Time spent inside each link including everything after it: own time of link i = inner[i] - inner[i + 1]
+    std::vector<Clock::duration> inner(middlewares.size() + 1, Clock::duration::zero());
+    trace::RequestContext* ctx = trace::RequestTimings::enabled() ? trace::current() : nullptr;
+
+    Next next = [leaf, &inner, index = middlewares.size()](Request& r) -> net::awaitable<Outcome> {
+        trace::Span span("handler");
+        const Stopwatch watch{inner[index]};
         co_return co_await leaf(r);
     };
 
-    for (auto & middleware_ : std::ranges::reverse_view(middlewares)) {
+    for (std::size_t i = middlewares.size(); i-- > 0;) {
         Next prev = std::move(next);
-        next = [middleware_, prev](Request& request_) -> net::awaitable<Outcome> {
+        next = [middleware_ = middlewares[i], prev, &inner, i](Request& request_) -> net::awaitable<Outcome> {
+            // Includes everything after this middleware: children show what it added itself
+            trace::Span span("middleware");
+            if (span.recording()) span.setAttribute("middleware.type", boost::core::demangle(typeid(*middleware_).name()));
+            const Stopwatch watch{inner[i]};
             co_return co_await middleware_->handle(request_, prev);
         };
     }
 
-    co_return co_await next(request);
+    // Own time of every middleware goes to its phase, the handler's own time has no phase of its own:
+    // its DB / offload / parse parts are accounted where they happen
+    const auto account = [ctx, &inner, &middlewares] {
+        if (!ctx) return;
+        for (std::size_t i = 0; i < middlewares.size(); ++i) {
+            ctx->timings.add(middlewares[i]->phase(), inner[i] - inner[i + 1]);
+        }
+    };
+
+    std::optional<Outcome> outcome;
+    try {
+        outcome = co_await next(request);
+    } catch (...) {
+        account();
+        throw;
+    }
+    account();
+    co_return std::move(*outcome);
 }
 
 net::awaitable<Response> Router::runAfter(const Request& request, Response&& response, const std::vector<std::shared_ptr<MiddlewareInterface>>& middlewares) {
@@ -157,21 +240,8 @@ net::awaitable<Response> Router::runAfter(const Request& request, Response&& res
 }
 
 Response Router::render(const Request& request, Outcome&& outcome) {
-    return std::visit([&]<typename T0>(T0&& v) -> Response {
-        using T = std::decay_t<T0>;
-        if constexpr (std::is_same_v<T, Response>) {
-            return std::forward<T0>(v);
-        } else {
-            return JsonRenderer{}.render(
-                request,
-                v.status,
-                v.body,
-                v.keepAlive,
-                {},
-                v.dumpIndent
-            );
-        }
-    }, std::move(outcome));
+    const trace::PhaseTimer timer(trace::Phase::Render);
+    return JsonRenderer::toResponse(request, std::move(outcome));
 }
 
 /// Compiling route with
@@ -214,13 +284,41 @@ Router::RouteEntry Router::compileRoute(const std::string& tmpl)
 }
 
 net::awaitable<Response> Router::dispatch(Request request, const EnvConfig& env) const {
-    LoggerSingleton::get().info("Router::dispatch: called", {
-        {"method", std::string(http::to_string(request.method()))},
-        {"target", std::string(request.target())}
-    });
+    const auto startedAt = std::chrono::steady_clock::now();
+    const http::verb method = request.method();
+    // Unmatched targets share one label, keeps the series count bounded
+    std::string route = "unmatched";
+    routerMetrics().inFlight.inc();
+
+    std::optional<Response> response;
+    try {
+        response = co_await handle(std::move(request), env, route);
+    } catch (...) {
+        recordRequest(method, route, 500, std::chrono::steady_clock::now() - startedAt);
+        throw;
+    }
+    recordRequest(method, route, response->result_int(), std::chrono::steady_clock::now() - startedAt);
+
+    if (trace::RequestContext* ctx = trace::current(); ctx && trace::RequestTimings::enabled()) {
+        ctx->timings.route = route;
+        if (trace::RequestTimings::mode() == trace::RequestTimings::Mode::Header) {
+            response->set("Server-Timing", ctx->timings.serverTiming(std::chrono::steady_clock::now()));
+        }
+    }
+    co_return std::move(*response);
+}
+
+net::awaitable<Response> Router::handle(Request request, const EnvConfig& env, std::string& route) const {
+    LOG_INFO("Router::dispatch: called",
+        {"method", toStdView(http::to_string(request.method()))},
+        {"target", toStdView(request.target())}
+    );
     std::string error_msg;
+    bool unavailable = false;
     const auto path = normalizeTarget(request);
 
+    std::optional<trace::PhaseTimer> routing;
+    routing.emplace(trace::Phase::Route);
     auto middlewares = collectMiddlewaresFor(path);
 
     const MethodMap* methods = nullptr;
@@ -238,19 +336,25 @@ net::awaitable<Response> Router::dispatch(Request request, const EnvConfig& env)
 
             matchedEntry = &entry;
             methods = &entry.methods;
+            route = entry.original;
             break;
         }
     }
+    routing.reset();
 
     if (!methods)
         co_return co_await runAfter(request, render(request, make404(request)), middlewares);
 
-    // Auto-HEAD: if no HEAD, but GET exists — return GET without body
+    // Auto-HEAD: if no HEAD, but GET exists — return GET headers (with its Content-Length) without body
     if (request.method() == http::verb::head && !methods->contains(http::verb::head) && methods->contains(http::verb::get)) {
         Outcome outcome = co_await runChain(request, methods->at(http::verb::get), middlewares);
         Response response = render(request, std::move(outcome));
-        response.body().clear();
-        response.set(http::field::content_length, "0");
+        // Middlewares (response cache) may answer with metadata only: Content-Length already set, empty body
+        if (!response.body().empty()) {
+            const std::size_t length = response.body().size();
+            response.body().clear();
+            response.content_length(length);
+        }
         for (auto& middleware : middlewares) {
             response = co_await middleware->after(request, std::move(response));
         };
@@ -313,10 +417,10 @@ net::awaitable<Response> Router::dispatch(Request request, const EnvConfig& env)
 
     std::string bodyContentTypeError;
 
-    LoggerSingleton::get().debug("Router::dispatch: Request content-type", {
+    LOG_DEBUG("Router::dispatch: Request content-type",
         {"ct", ct},
-        {"size", (int)request.raw().body().size()}
-    });
+        {"size", request.raw().body().size()}
+    );
 
     try {
         if (ct.find("application/json") != std::string::npos) {
@@ -343,6 +447,12 @@ net::awaitable<Response> Router::dispatch(Request request, const EnvConfig& env)
         auto outcome = co_await runChain(request, itMeth->second, middlewares);
         Response response = render(request, std::move(outcome));
         co_return co_await runAfter(request, std::move(response), middlewares);
+    } catch (const DbUnavailableError& e) {
+        LoggerSingleton::get().error("Router::dispatch: database unavailable", {
+            {"error", std::string(e.what())}
+        });
+        unavailable = true;
+        error_msg = "Database temporarily unavailable";
     } catch (const DbError& e) {
         error_msg = e.what() && *e.what() ? e.what() : "Database error";
     } catch (const std::exception& e) {
@@ -351,7 +461,7 @@ net::awaitable<Response> Router::dispatch(Request request, const EnvConfig& env)
 
     co_return co_await runAfter(
         request,
-        render(request, make500(request, error_msg)),
+        render(request, unavailable ? make503(request, error_msg) : make500(request, error_msg)),
         middlewares
     );
 }
@@ -88,6 +88,7 @@ public:
     /// Use locally (scoped)
     Router& use(std::string pathPrefix, std::shared_ptr<MiddlewareInterface> middleware);
 
+    /// Routes the request and records http_requests_total / http_request_duration_seconds
     net::awaitable<Response> dispatch(Request request, const EnvConfig& env) const;
 
 private:
@@ -97,6 +98,9 @@ private:
     struct ScopedMiddlewares { std::string prefix; std::shared_ptr<MiddlewareInterface> middleware; };
     std::vector<ScopedMiddlewares> scoped_middlewares_;
 
+    /// route: matched template ("/users/{id}"), left untouched when nothing matched
+    net::awaitable<Response> handle(Request request, const EnvConfig& env, std::string& route) const;
+
     [[nodiscard]] std::vector<std::shared_ptr<MiddlewareInterface>> collectMiddlewaresFor(const std::string& path) const;
 
     static std::string normalizeTarget(const Request& request);
@@ -106,6 +110,7 @@ private:
     static Outcome make413(const Request& request, const MethodMap& mm);
     static Outcome make415(const Request& request, const MethodMap& mm);
     static Outcome make500(const Request& request, const std::string& err);
+    static Outcome make503(const Request& request, const std::string& err);
     static Outcome makeOptionsAllow(const Request& request, const MethodMap& mm);
 
     static net::awaitable<Outcome> runChain(Request& request, RouteFn leaf, std::vector<std::shared_ptr<MiddlewareInterface>>& middlewares) ;
@@ -0,0 +1,22 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+namespace validators {
+    /// Same language as ^[^@\s]+@[^@\s]+\.[^@\s]+$ in one pass. std::regex backtracks over every dot of the
+    /// domain (quadratic) and recurses per character: a long enough email in a login body crashed the process
+    inline bool isEmail(const std::string_view value) {
+        const auto isSpace = [](const char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+        if (std::ranges::any_of(value, isSpace)) return false;
+
+        const std::size_t at = value.find('@');
+        if (at == 0 || at == std::string_view::npos) return false;
+        const std::string_view domain = value.substr(at + 1);
+        if (domain.find('@') != std::string_view::npos) return false;
+
+        // A dot with at least one character on both sides
+        const std::size_t dot = domain.find('.', 1);
+        return dot != std::string_view::npos && dot + 1 < domain.size();
+    }
+}
@@ -0,0 +1,137 @@
+#include "core/tracing/RequestTimings.h"
+#include "core/metrics/MetricsRegistry.h"
+#include "core/profiling/AllocationTracker.h"
+#include "core/tracing/TraceContext.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+namespace trace {
+    namespace {
+        std::atomic<RequestTimings::Mode> timingMode{RequestTimings::Mode::Off};
+
+        constexpr std::array<std::string_view, static_cast<std::size_t>(Phase::Count)> kPhaseNames{
+            "parse", "route", "middleware", "auth", "db-acquire", "db-query",
+            "offload-queue", "offload-run", "render", "write"
+        };
+
+        struct TimingMetrics {
+            metrics::Family<metrics::Histogram> phase;
+            metrics::Family<metrics::Histogram> cpu;
+            metrics::Family<metrics::Histogram> suspended;
+            metrics::Family<metrics::Histogram> allocations;
+            metrics::Family<metrics::Histogram> allocatedBytes;
+        };
+
+        const TimingMetrics& timingMetrics() {
+            auto& registry = metrics::MetricsRegistry::instance();
+            static const TimingMetrics m{
+                registry.histogramFamily("http_request_phase_seconds", "Time spent per request phase", {"route", "phase"}),
+                registry.histogramFamily("http_request_cpu_seconds", "On-CPU time of I/O threads per request", {"route"}),
+                registry.histogramFamily("http_request_suspended_seconds", "Wall time minus on-CPU time per request", {"route"}),
+                registry.histogramFamily("http_request_allocations", "Heap allocations per request", {"route"},
+                    {1, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 50000}, 1.0),
+                registry.histogramFamily("http_request_allocated_bytes", "Heap bytes allocated per request", {"route"},
+                    {1024, 4096, 16384, 65536, 262144, 1048576, 4194304, 16777216, 67108864}, 1.0)
+            };
+            return m;
+        }
+
+        void appendMetric(std::string& out, const std::string_view name, const std::int64_t ns) {
+            char buf[48];
+            const int n = std::snprintf(buf, sizeof(buf), ";dur=%.3f", static_cast<double>(ns) / 1e6);
+            if (!out.empty()) out += ", ";
+            out += name;
+            out.append(buf, static_cast<std::size_t>(n));
+        }
+    }
+
+    void RequestTimings::setMode(const Mode mode) noexcept {
+        timingMode.store(mode, std::memory_order_relaxed);
+    }
+
+    RequestTimings::Mode RequestTimings::mode() noexcept {
+        return timingMode.load(std::memory_order_relaxed);
+    }
+
+    RequestTimings::Mode RequestTimings::parseMode(const std::string_view name) {
+        if (name == "metrics") return Mode::Metrics;
+        if (name == "header") return Mode::Header;
+        return Mode::Off;
+    }
+
+    std::string_view RequestTimings::phaseName(const Phase phase) {
+        return kPhaseNames[static_cast<std::size_t>(phase)];
+    }
+
+    std::int64_t RequestTimings::threadCpuNs() noexcept {
+        timespec ts{};
+        ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<std::int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+    }
+
+    void RequestTimings::add(const Phase phase, const std::chrono::steady_clock::duration elapsed) noexcept {
+        if (!enabled()) return;
+        phases_[static_cast<std::size_t>(phase)].fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+            std::memory_order_relaxed
+        );
+    }
+
+    void RequestTimings::addCpu(const std::int64_t ns) noexcept {
+        cpuNs_.fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    void RequestTimings::addAllocations(const std::uint64_t count, const std::uint64_t bytes) noexcept {
+        allocations_.fetch_add(count, std::memory_order_relaxed);
+        allocatedBytes_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    std::int64_t RequestTimings::phaseNs(const Phase phase) const noexcept {
+        return phases_[static_cast<std::size_t>(phase)].load(std::memory_order_relaxed);
+    }
+
+    std::string RequestTimings::serverTiming(const std::chrono::steady_clock::time_point now) const {
+        std::string out;
+        out.reserve(160);
+        for (std::size_t i = 0; i < phases_.size(); ++i) {
+            if (const std::int64_t ns = phases_[i].load(std::memory_order_relaxed); ns > 0) {
+                appendMetric(out, kPhaseNames[i], ns);
+            }
+        }
+        appendMetric(out, "cpu", cpuNs());
+        appendMetric(out, "total", std::chrono::duration_cast<std::chrono::nanoseconds>(now - startedAt_).count());
+        return out;
+    }
+
+    void RequestTimings::publish(const std::chrono::steady_clock::time_point finishedAt) const {
+        if (!enabled()) return;
+        const TimingMetrics& m = timingMetrics();
+        for (std::size_t i = 0; i < phases_.size(); ++i) {
+            if (const std::int64_t ns = phases_[i].load(std::memory_order_relaxed); ns > 0) {
+                m.phase.with({route, kPhaseNames[i]}).observe(std::chrono::nanoseconds(ns));
+            }
+        }
+        const auto wall = std::chrono::duration_cast<std::chrono::nanoseconds>(finishedAt - startedAt_);
+        const auto cpu = std::chrono::nanoseconds(cpuNs());
+        m.cpu.with({route}).observe(cpu);
+        m.suspended.with({route}).observe(std::max(wall - cpu, std::chrono::nanoseconds::zero()));
+        if constexpr (profiling::AllocationTracker::kEnabled) {
+            m.allocations.with({route}).record(allocations());
+            m.allocatedBytes.with({route}).record(allocatedBytes());
+        }
+    }
+
+    PhaseTimer::PhaseTimer(const Phase phase) : phase_(phase) {
+        if (!RequestTimings::enabled()) return;
+        if (const ContextSlot* slot = currentSlot(); slot && slot->context) {
+            context_ = slot->context;
+            startedAt_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    PhaseTimer::~PhaseTimer() {
+        if (context_) context_->timings.add(phase_, std::chrono::steady_clock::now() - startedAt_);
+    }
+}
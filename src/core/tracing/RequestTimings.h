@@ -0,0 +1,93 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace trace {
+    struct RequestContext;
+
+    /// Where a request spent its time, Server-Timing metric names in phaseName()
+    enum class Phase : std::uint8_t {
+        Parse,
+        Route,
+        Middleware,
+        Auth,
+        DbAcquire,
+        DbQuery,
+        OffloadQueue,
+        OffloadRun,
+        Render,
+        Write,
+        Count
+    };
+
+    /// Per-request phase durations and on-CPU time of the I/O threads.
+    ///
+    /// Phases are added from the I/O threads and from the blocking pool (offload), hence relaxed atomics.
+    /// On-CPU time is the thread CPU clock around every resumption of the session coroutine
+    /// (see ContextExecutor), suspended time is the rest of the wall time: a busy event loop shows up
+    /// as suspended time with low CPU, a slow handler as CPU.
+    class RequestTimings {
+    public:
+        /// off: nothing measured; metrics: phase histograms; header: metrics + Server-Timing response header
+        enum class Mode { Off, Metrics, Header };
+
+        static void setMode(Mode mode) noexcept;
+        static Mode mode() noexcept;
+        static bool enabled() noexcept { return mode() != Mode::Off; }
+        /// "off" | "metrics" | "header", anything else -> Off
+        static Mode parseMode(std::string_view name);
+        static std::string_view phaseName(Phase phase);
+        /// CLOCK_THREAD_CPUTIME_ID, nanoseconds
+        static std::int64_t threadCpuNs() noexcept;
+
+        void start(std::chrono::steady_clock::time_point at) noexcept { startedAt_ = at; }
+        [[nodiscard]] std::chrono::steady_clock::time_point startedAt() const noexcept { return startedAt_; }
+
+        void add(Phase phase, std::chrono::steady_clock::duration elapsed) noexcept;
+        void addCpu(std::int64_t ns) noexcept;
+        /// Heap allocations made on behalf of the request (AllocationTracker builds only)
+        void addAllocations(std::uint64_t count, std::uint64_t bytes) noexcept;
+        [[nodiscard]] std::uint64_t allocations() const noexcept { return allocations_.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::uint64_t allocatedBytes() const noexcept { return allocatedBytes_.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::int64_t phaseNs(Phase phase) const noexcept;
+        [[nodiscard]] std::int64_t cpuNs() const noexcept { return cpuNs_.load(std::memory_order_relaxed); }
+
+        /// "parse;dur=0.041, db-query;dur=1.203, ..., cpu;dur=0.310, total;dur=2.004" (milliseconds)
+        [[nodiscard]] std::string serverTiming(std::chrono::steady_clock::time_point now) const;
+        /// Phase, cpu, suspended (and allocation) histograms labelled with route, once per request after the write
+        void publish(std::chrono::steady_clock::time_point finishedAt) const;
+
+        /// Route template, set by the router: label of the published metrics
+        std::string route = "unmatched";
+
+    private:
+        std::array<std::atomic<std::int64_t>, static_cast<std::size_t>(Phase::Count)> phases_{};
+        std::atomic<std::int64_t> cpuNs_{0};
+        std::atomic<std::uint64_t> allocations_{0};
+        std::atomic<std::uint64_t> allocatedBytes_{0};
+        std::chrono::steady_clock::time_point startedAt_ = std::chrono::steady_clock::now();
+    };
+
+    /// Adds its lifetime to a phase of the current request. Reads the context at construction:
+    /// like Span, create it before the first co_await.
+    class PhaseTimer {
+    public:
+        explicit PhaseTimer(Phase phase);
+        ~PhaseTimer();
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+        /// Starts measuring again, e.g. once the wait that precedes the phase is over
+        void restart() noexcept { startedAt_ = std::chrono::steady_clock::now(); }
+
+    private:
+        std::shared_ptr<RequestContext> context_;
+        Phase phase_;
+        std::chrono::steady_clock::time_point startedAt_;
+    };
+}
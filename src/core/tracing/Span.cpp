@@ -0,0 +1,62 @@
+#include "core/tracing/Span.h"
+#include "core/tracing/TraceExporter.h"
+
+namespace trace {
+    Span::Span(const std::string_view name, const SpanKind kind) {
+        ContextSlot* slot = currentSlot();
+        if (!slot || !slot->context || !slot->context->sampled) return;
+
+        slot_ = slot;
+        context_ = slot->context;
+        startedAt_ = std::chrono::steady_clock::now();
+
+        record_.traceId = context_->traceId;
+        record_.name = name;
+        record_.kind = kind;
+        record_.startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+        if (kind == SpanKind::Server) {
+            // Server span is the one announced in the response traceparent
+            record_.spanId = context_->rootSpanId;
+            record_.parentSpanId = context_->remoteParentSpanId;
+        } else {
+            record_.spanId = randomId();
+            record_.parentSpanId = slot->activeSpan != 0 ? slot->activeSpan : context_->rootSpanId;
+        }
+        slot->activeSpan = record_.spanId;
+    }
+
+    Span::~Span() {
+        end();
+    }
+
+    void Span::setAttribute(const std::string_view key, const std::string_view value) {
+        if (!slot_) return;
+        record_.attributes.emplace_back(std::string(key), std::string(value));
+    }
+
+    void Span::setAttribute(const std::string_view key, const std::int64_t value) {
+        if (!slot_) return;
+        record_.attributes.emplace_back(std::string(key), std::to_string(value));
+    }
+
+    void Span::setError(const std::string_view message) {
+        if (!slot_) return;
+        record_.error = true;
+        record_.attributes.emplace_back("error.message", std::string(message));
+    }
+
+    void Span::end() {
+        if (!slot_) return;
+        record_.durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - startedAt_
+        ).count();
+        // The slot may already belong to the next request (attach() resets it) -> only pop our own span
+        if (slot_->activeSpan == record_.spanId && slot_->context == context_) {
+            slot_->activeSpan = record_.kind == SpanKind::Server ? 0 : record_.parentSpanId;
+        }
+        slot_ = nullptr;
+        TraceExporter::instance().submit(std::move(record_));
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "core/tracing/TraceContext.h"
+
+namespace trace {
+    enum class SpanKind { Internal, Server, Client };
+
+    /// Finished span as handed to the exporter
+    struct SpanRecord {
+        TraceId traceId;
+        std::uint64_t spanId = 0;
+        std::uint64_t parentSpanId = 0;
+        std::string name;
+        SpanKind kind = SpanKind::Internal;
+        /// Wall clock, nanoseconds since epoch
+        std::int64_t startNs = 0;
+        std::int64_t durationNs = 0;
+        bool error = false;
+        std::vector<std::pair<std::string, std::string>> attributes;
+    };
+
+    /// RAII span of the current request (see ContextSlot).
+    /// Unsampled or context-less spans cost one thread-local read and record nothing.
+    /// Open spans before the first co_await of a function: the slot is read at construction only.
+    class Span {
+    public:
+        explicit Span(std::string_view name, SpanKind kind = SpanKind::Internal);
+        ~Span();
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+        [[nodiscard]] bool recording() const noexcept { return slot_ != nullptr; }
+
+        void setAttribute(std::string_view key, std::string_view value);
+        void setAttribute(std::string_view key, std::int64_t value);
+        void setError(std::string_view message);
+        /// Ends the span early, destructor does nothing afterwards
+        void end();
+
+    private:
+        ContextSlot* slot_ = nullptr;
+        std::shared_ptr<RequestContext> context_;
+        std::chrono::steady_clock::time_point startedAt_;
+        SpanRecord record_;
+    };
+}
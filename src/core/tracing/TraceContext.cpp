@@ -0,0 +1,132 @@
+#include "core/tracing/TraceContext.h"
+
+#include <charconv>
+#include <random>
+
+namespace trace {
+    namespace {
+        thread_local ContextSlot* tlsSlot = nullptr;
+
+        void appendHex(std::string& out, const std::uint64_t value) {
+            static constexpr char digits[] = "0123456789abcdef";
+            for (int shift = 60; shift >= 0; shift -= 4) out += digits[(value >> shift) & 0xF];
+        }
+
+        bool parseHex(const std::string_view text, std::uint64_t& out) {
+            const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), out, 16);
+            return ec == std::errc{} && end == text.data() + text.size();
+        }
+
+        bool isLowerHex(const std::string_view text) {
+            for (const char c : text) {
+                if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) return false;
+            }
+            return true;
+        }
+    }
+
+    std::string TraceId::hex() const {
+        std::string out;
+        out.reserve(32);
+        appendHex(out, high);
+        appendHex(out, low);
+        return out;
+    }
+
+    std::string spanIdHex(const std::uint64_t spanId) {
+        std::string out;
+        out.reserve(16);
+        appendHex(out, spanId);
+        return out;
+    }
+
+    std::uint64_t randomId() {
+        thread_local std::mt19937_64 rng{std::random_device{}()};
+        std::uint64_t id = 0;
+        while (id == 0) id = rng();
+        return id;
+    }
+
+    TraceId randomTraceId() {
+        return TraceId{randomId(), randomId()};
+    }
+
+    std::optional<TraceParent> TraceParent::parse(const std::string_view header) {
+        // version(2) - trace id(32) - parent id(16) - flags(2)
+        if (header.size() < 55 || header[2] != '-' || header[35] != '-' || header[52] != '-') return std::nullopt;
+
+        const std::string_view version = header.substr(0, 2);
+        const std::string_view traceId = header.substr(3, 32);
+        const std::string_view parentId = header.substr(36, 16);
+        const std::string_view flags = header.substr(53, 2);
+        if (!isLowerHex(version) || version == "ff") return std::nullopt;
+        // Version 00 has nothing after the flags, later versions may append fields
+        if (version == "00" && header.size() != 55) return std::nullopt;
+        if (!isLowerHex(traceId) || !isLowerHex(parentId) || !isLowerHex(flags)) return std::nullopt;
+
+        TraceParent out;
+        std::uint64_t flagBits = 0;
+        if (!parseHex(traceId.substr(0, 16), out.traceId.high) || !parseHex(traceId.substr(16), out.traceId.low)
+            || !parseHex(parentId, out.parentSpanId) || !parseHex(flags, flagBits)) {
+            return std::nullopt;
+        }
+        if (!out.traceId.valid() || out.parentSpanId == 0) return std::nullopt;
+        out.sampled = (flagBits & 0x01) != 0;
+        return out;
+    }
+
+    std::string TraceParent::format() const {
+        std::string out = "00-";
+        out += traceId.hex();
+        out += '-';
+        appendHex(out, parentSpanId);
+        out += sampled ? "-01" : "-00";
+        return out;
+    }
+
+    ContextSlot* currentSlot() noexcept {
+        return tlsSlot;
+    }
+
+    RequestContext* current() noexcept {
+        return tlsSlot ? tlsSlot->context.get() : nullptr;
+    }
+
+    void attach(std::shared_ptr<RequestContext> ctx) {
+        if (!tlsSlot) return;
+        tlsSlot->context = std::move(ctx);
+        tlsSlot->activeSpan = 0;
+    }
+
+    void chargeCpu(const ContextSlot& slot, const std::int64_t ns) noexcept {
+        if (slot.context) slot.context->timings.addCpu(ns);
+    }
+
+    void chargeAllocations(const ContextSlot& slot, const profiling::AllocationCounts& counts) noexcept {
+        if (slot.context) slot.context->timings.addAllocations(counts.allocations, counts.bytes);
+    }
+
+    SlotScope::SlotScope(ContextSlot* slot) noexcept : previous_(tlsSlot) {
+        tlsSlot = slot;
+    }
+
+    SlotScope::~SlotScope() {
+        tlsSlot = previous_;
+    }
+
+    Captured Captured::here() {
+        if (!tlsSlot || !tlsSlot->context) return {};
+        return Captured{tlsSlot->context, tlsSlot->activeSpan};
+    }
+
+    ThreadScope::ThreadScope(const Captured& captured)
+        : slot_{captured.context, captured.parentSpan}
+        , scope_(&slot_)
+        , allocationsBefore_(profiling::AllocationTracker::thisThread()) {}
+
+    ThreadScope::~ThreadScope() {
+        if constexpr (profiling::AllocationTracker::kEnabled) {
+            if (RequestTimings::enabled()) chargeAllocations(slot_, profiling::AllocationTracker::thisThread() - allocationsBefore_);
+        }
+    }
+}
@@ -0,0 +1,178 @@
+#pragma once
+#include <boost/asio.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "core/profiling/AllocationTracker.h"
+#include "core/tracing/RequestTimings.h"
+
+namespace net = boost::asio;
+
+namespace trace {
+    struct TraceId {
+        std::uint64_t high = 0;
+        std::uint64_t low = 0;
+
+        [[nodiscard]] bool valid() const noexcept { return high != 0 || low != 0; }
+        [[nodiscard]] std::string hex() const;
+    };
+
+    std::string spanIdHex(std::uint64_t spanId);
+    std::uint64_t randomId();
+    TraceId randomTraceId();
+
+    /// W3C traceparent: 00-{32 hex trace id}-{16 hex parent span id}-{2 hex flags}
+    struct TraceParent {
+        TraceId traceId;
+        std::uint64_t parentSpanId = 0;
+        bool sampled = false;
+
+        static std::optional<TraceParent> parse(std::string_view header);
+        [[nodiscard]] std::string format() const;
+    };
+
+    /// One per request: HttpSession attaches it when the request head arrives,
+    /// RequestIdMiddleware fills in the identity
+    struct RequestContext {
+        std::string requestId;
+        TraceId traceId;
+        /// Span of the caller (traceparent), 0 for a new trace
+        std::uint64_t remoteParentSpanId = 0;
+        /// Root span of this service, reported back in the response traceparent
+        std::uint64_t rootSpanId = 0;
+        bool sampled = false;
+        RequestTimings timings;
+    };
+
+    /// What the code running right now belongs to. HttpSession owns one per session,
+    /// ContextExecutor makes it current on every resumption of the session coroutine.
+    struct ContextSlot {
+        std::shared_ptr<RequestContext> context;
+        /// Innermost open span on this slot, parent of the next one
+        std::uint64_t activeSpan = 0;
+    };
+
+    /// Slot of the calling thread, nullptr outside of ContextExecutor / ThreadScope
+    ContextSlot* currentSlot() noexcept;
+    /// Request context of the calling coroutine, nullptr if none
+    RequestContext* current() noexcept;
+    /// Installs ctx into the current slot (no-op without a slot)
+    void attach(std::shared_ptr<RequestContext> ctx);
+
+    /// Makes slot current for the lifetime of the scope, restores the previous one
+    class SlotScope {
+    public:
+        explicit SlotScope(ContextSlot* slot) noexcept;
+        ~SlotScope();
+        /// No slot was current before: not an inline dispatch from another handler
+        [[nodiscard]] bool outermost() const noexcept { return previous_ == nullptr; }
+        SlotScope(const SlotScope&) = delete;
+        SlotScope& operator=(const SlotScope&) = delete;
+
+    private:
+        ContextSlot* previous_;
+    };
+
+    /// Context captured on the I/O thread and re-installed elsewhere (blocking pool):
+    /// spans opened under ThreadScope become children of the span active at capture time
+    struct Captured {
+        std::shared_ptr<RequestContext> context;
+        std::uint64_t parentSpan = 0;
+
+        static Captured here();
+    };
+
+    /// Blocking pool side of Captured: heap allocations made under it are charged to the request
+    class ThreadScope {
+    public:
+        explicit ThreadScope(const Captured& captured);
+        ~ThreadScope();
+        ThreadScope(const ThreadScope&) = delete;
+        ThreadScope& operator=(const ThreadScope&) = delete;
+
+    private:
+        ContextSlot slot_;
+        SlotScope scope_;
+        profiling::AllocationCounts allocationsBefore_;
+    };
+
+    /// Adds on-CPU time of a resumption to the slot's request (RequestTimings)
+    void chargeCpu(const ContextSlot& slot, std::int64_t ns) noexcept;
+    /// Adds the heap allocations of a resumption to the slot's request
+    void chargeAllocations(const ContextSlot& slot, const profiling::AllocationCounts& counts) noexcept;
+
+    /// Executor adapter: every function it runs sees slot as current.
+    /// Coroutines spawned on it resume through execute(), so the context follows the coroutine
+    /// across co_await without passing it around.
+    template <class Inner>
+    class ContextExecutor {
+    public:
+        ContextExecutor(Inner inner, std::shared_ptr<ContextSlot> slot)
+            : inner_(std::move(inner)), slot_(std::move(slot)) {}
+
+        template <class F>
+        void execute(F&& f) const {
+            inner_.execute(Bound<std::decay_t<F>>{slot_, std::forward<F>(f)});
+        }
+
+        template <class Property>
+        auto query(const Property& p) const -> decltype(net::query(std::declval<const Inner&>(), p)) {
+            return net::query(inner_, p);
+        }
+
+        template <class Property>
+        auto require(const Property& p) const
+            -> ContextExecutor<std::decay_t<decltype(net::require(std::declval<const Inner&>(), p))>> {
+            return {net::require(inner_, p), slot_};
+        }
+
+        template <class Property>
+        auto prefer(const Property& p) const
+            -> ContextExecutor<std::decay_t<decltype(net::prefer(std::declval<const Inner&>(), p))>> {
+            return {net::prefer(inner_, p), slot_};
+        }
+
+        friend bool operator==(const ContextExecutor& a, const ContextExecutor& b) noexcept {
+            return a.inner_ == b.inner_ && a.slot_ == b.slot_;
+        }
+        friend bool operator!=(const ContextExecutor& a, const ContextExecutor& b) noexcept {
+            return !(a == b);
+        }
+
+        [[nodiscard]] const Inner& inner() const noexcept { return inner_; }
+        [[nodiscard]] const std::shared_ptr<ContextSlot>& slot() const noexcept { return slot_; }
+
+    private:
+        template <class F>
+        struct Bound {
+            std::shared_ptr<ContextSlot> slot;
+            F f;
+
+            void operator()() {
+                SlotScope scope(slot.get());
+                // Inline (nested) executions are already inside the outer measurement
+                if (!scope.outermost() || !RequestTimings::enabled()) {
+                    std::move(f)();
+                    return;
+                }
+                const std::int64_t cpuBefore = RequestTimings::threadCpuNs();
+                const profiling::AllocationCounts allocationsBefore = profiling::AllocationTracker::thisThread();
+                std::move(f)();
+                chargeCpu(*slot, RequestTimings::threadCpuNs() - cpuBefore);
+                if constexpr (profiling::AllocationTracker::kEnabled) {
+                    chargeAllocations(*slot, profiling::AllocationTracker::thisThread() - allocationsBefore);
+                }
+            }
+        };
+
+        Inner inner_;
+        std::shared_ptr<ContextSlot> slot_;
+    };
+}
@@ -0,0 +1,239 @@
+#include "core/tracing/TraceExporter.h"
+#include "core/loggers/LoggerSingleton.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace trace {
+    namespace {
+        /// Low 56 bits of the trace id are random in both W3C and our own ids
+        constexpr std::uint64_t kSampleBits = 56;
+        constexpr std::uint64_t kSampleMask = (std::uint64_t{1} << kSampleBits) - 1;
+
+        std::string nanosText(const std::int64_t ns) {
+            return std::to_string(ns);
+        }
+
+        int otlpKind(const SpanKind kind) {
+            switch (kind) {
+                case SpanKind::Server: return 2;
+                case SpanKind::Client: return 3;
+                case SpanKind::Internal: break;
+            }
+            return 1;
+        }
+    }
+
+    TraceExporter& TraceExporter::instance() {
+        static TraceExporter exporter;
+        return exporter;
+    }
+
+    TraceExporter::Format TraceExporter::parseFormat(const std::string_view name) {
+        if (name == "chrome") return Format::Chrome;
+        if (name == "otlp") return Format::Otlp;
+        return Format::None;
+    }
+
+    TraceExporter::~TraceExporter() {
+        stop();
+    }
+
+    void TraceExporter::start(Options options) {
+        stop();
+        options_ = std::move(options);
+        if (options_.format == Format::None) return;
+
+        const double ratio = std::clamp(options_.sampleRatio, 0.0, 1.0);
+        sampleThreshold_.store(ratio >= 1.0
+            ? kSampleMask + 1
+            : static_cast<std::uint64_t>(std::ldexp(ratio, static_cast<int>(kSampleBits))));
+
+        {
+            std::lock_guard writeLock(writeMutex_);
+            open();
+        }
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = false;
+            buffer_.reserve(std::min<std::size_t>(options_.maxBufferedSpans, 4096));
+        }
+        enabled_.store(true, std::memory_order_relaxed);
+        worker_ = std::thread([this] { run(); });
+
+        LoggerSingleton::get().info("TraceExporter::start: tracing enabled", {
+            {"file", path_},
+            {"sample_ratio", ratio}
+        });
+    }
+
+    void TraceExporter::stop() {
+        if (!worker_.joinable()) return;
+        enabled_.store(false, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        worker_.join();
+        flush();
+
+        std::lock_guard writeLock(writeMutex_);
+        if (out_.is_open()) out_.close();
+    }
+
+    bool TraceExporter::shouldSample(const TraceId& traceId) const noexcept {
+        if (!enabled()) return false;
+        return (traceId.low & kSampleMask) < sampleThreshold_.load(std::memory_order_relaxed);
+    }
+
+    void TraceExporter::submit(SpanRecord&& record) {
+        std::lock_guard lock(mutex_);
+        if (!enabled() || buffer_.size() >= options_.maxBufferedSpans) {
+            ++dropped_;
+            return;
+        }
+        buffer_.push_back(std::move(record));
+    }
+
+    TraceExporter::Stats TraceExporter::stats() const {
+        std::lock_guard lock(mutex_);
+        return Stats{exported_.load(std::memory_order_relaxed), dropped_};
+    }
+
+    void TraceExporter::flush() {
+        std::vector<SpanRecord> batch;
+        {
+            std::lock_guard lock(mutex_);
+            batch.swap(buffer_);
+        }
+        if (!batch.empty()) writeBatch(batch);
+    }
+
+    void TraceExporter::run() {
+        std::vector<SpanRecord> batch;
+        for (;;) {
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait_for(lock, options_.flushInterval, [this] { return stopping_; });
+                if (stopping_) return;
+                batch.swap(buffer_);
+            }
+            if (!batch.empty()) writeBatch(batch);
+            batch.clear();
+        }
+    }
+
+    void TraceExporter::writeBatch(std::vector<SpanRecord>& batch) {
+        std::string chunk;
+        if (options_.format == Format::Chrome) {
+            for (const auto& record : batch) {
+                chunk += chromeEvent(record);
+                chunk += ",\n";
+            }
+        } else {
+            chunk = otlpRequest(batch);
+            chunk += '\n';
+        }
+
+        std::lock_guard writeLock(writeMutex_);
+        if (!out_.is_open()) return;
+        out_.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        out_.flush();
+        written_ += chunk.size();
+        exported_.fetch_add(batch.size(), std::memory_order_relaxed);
+        rotateIfNeeded();
+    }
+
+    void TraceExporter::open() {
+        std::error_code ec;
+        fs::create_directories(options_.dir, ec);
+
+        const std::string suffix = options_.format == Format::Chrome ? ".json" : ".otlp.jsonl";
+        path_ = (fs::path(options_.dir) / ("trace-" + std::to_string(::getpid()) + suffix)).string();
+
+        out_.open(path_, std::ios::binary | std::ios::trunc);
+        written_ = 0;
+        if (!out_.is_open()) {
+            LoggerSingleton::get().error("TraceExporter::open: cannot open trace file", {{"file", path_}});
+            return;
+        }
+        if (options_.format == Format::Chrome) {
+            out_ << "[\n";
+            written_ = 2;
+        }
+    }
+
+    void TraceExporter::rotateIfNeeded() {
+        if (options_.maxFileBytes == 0 || written_ < options_.maxFileBytes) return;
+        out_.close();
+        std::error_code ec;
+        fs::rename(path_, path_ + ".1", ec);
+        open();
+    }
+
+    std::string TraceExporter::chromeEvent(const SpanRecord& record) const {
+        nlohmann::json args = {
+            {"trace_id", record.traceId.hex()},
+            {"span_id", spanIdHex(record.spanId)},
+            {"parent_id", spanIdHex(record.parentSpanId)}
+        };
+        for (const auto& [key, value] : record.attributes) args[key] = value;
+        if (record.error) args["error"] = true;
+
+        // One lane per request: coroutines of different requests interleave on the same thread
+        const nlohmann::json event = {
+            {"name", record.name},
+            {"cat", options_.serviceName},
+            {"ph", "X"},
+            {"ts", static_cast<double>(record.startNs) / 1000.0},
+            {"dur", static_cast<double>(record.durationNs) / 1000.0},
+            {"pid", ::getpid()},
+            {"tid", static_cast<std::int64_t>(record.traceId.low & 0x7fffffff)},
+            {"args", std::move(args)}
+        };
+        return event.dump();
+    }
+
+    std::string TraceExporter::otlpRequest(const std::vector<SpanRecord>& batch) const {
+        nlohmann::json spans = nlohmann::json::array();
+        for (const auto& record : batch) {
+            nlohmann::json attributes = nlohmann::json::array();
+            for (const auto& [key, value] : record.attributes) {
+                attributes.push_back({{"key", key}, {"value", {{"stringValue", value}}}});
+            }
+            nlohmann::json span = {
+                {"traceId", record.traceId.hex()},
+                {"spanId", spanIdHex(record.spanId)},
+                {"name", record.name},
+                {"kind", otlpKind(record.kind)},
+                // 64-bit integers are strings in OTLP/JSON
+                {"startTimeUnixNano", nanosText(record.startNs)},
+                {"endTimeUnixNano", nanosText(record.startNs + record.durationNs)},
+                {"attributes", std::move(attributes)},
+                {"status", {{"code", record.error ? 2 : 0}}}
+            };
+            if (record.parentSpanId != 0) span["parentSpanId"] = spanIdHex(record.parentSpanId);
+            spans.push_back(std::move(span));
+        }
+
+        const nlohmann::json request = {
+            {"resourceSpans", nlohmann::json::array({{
+                {"resource", {{"attributes", nlohmann::json::array({
+                    {{"key", "service.name"}, {"value", {{"stringValue", options_.serviceName}}}}
+                })}}},
+                {"scopeSpans", nlohmann::json::array({{
+                    {"scope", {{"name", "adequate-api"}}},
+                    {"spans", std::move(spans)}
+                }})}
+            }})}
+        };
+        return request.dump();
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "core/tracing/Span.h"
+
+namespace trace {
+    /// Buffered span exporter to local files, no collector needed.
+    ///
+    /// Spans are appended to a mutex-protected buffer (one push per span), a background thread
+    /// writes them in batches every flushInterval:
+    ///  - chrome : {dir}/trace-{pid}.json, Trace Event Format "X" events, open in chrome://tracing or Perfetto
+    ///             (the array is never closed, both viewers accept that);
+    ///  - otlp   : {dir}/trace-{pid}.otlp.jsonl, one OTLP/JSON ExportTraceServiceRequest per line.
+    /// Files rotate to *.1 at maxFileBytes. A full buffer drops spans instead of blocking requests.
+    class TraceExporter {
+    public:
+        enum class Format { None, Chrome, Otlp };
+
+        struct Options {
+            Format format = Format::None;
+            std::string dir = "traces";
+            /// Head sampling for new traces, [0, 1]; incoming traceparent decides on its own
+            double sampleRatio = 1.0;
+            std::chrono::milliseconds flushInterval{1000};
+            std::size_t maxBufferedSpans = 65536;
+            std::uint64_t maxFileBytes = 64ull * 1024 * 1024;
+            std::string serviceName = "adequate-api";
+        };
+
+        struct Stats {
+            std::uint64_t exported = 0;
+            std::uint64_t dropped = 0;
+        };
+
+        static TraceExporter& instance();
+        /// "none" | "chrome" | "otlp", anything else -> None
+        static Format parseFormat(std::string_view name);
+
+        /// Opens the output file and starts the flush thread, Format::None keeps tracing off
+        void start(Options options);
+        /// Writes what is buffered and stops the flush thread
+        void stop();
+        /// Synchronous write of the buffer (tests, shutdown)
+        void flush();
+
+        [[nodiscard]] bool enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+        /// Deterministic by trace id: every service with the same ratio makes the same decision
+        [[nodiscard]] bool shouldSample(const TraceId& traceId) const noexcept;
+        void submit(SpanRecord&& record);
+        [[nodiscard]] Stats stats() const;
+
+        ~TraceExporter();
+
+    private:
+        TraceExporter() = default;
+
+        Options options_;
+        std::atomic<bool> enabled_{false};
+        std::atomic<std::uint64_t> sampleThreshold_{0};
+
+        mutable std::mutex mutex_;
+        std::condition_variable wake_;
+        std::vector<SpanRecord> buffer_;
+        bool stopping_ = false;
+        std::uint64_t dropped_ = 0;
+        std::thread worker_;
+
+        /// Owned by whoever holds writeMutex_
+        std::mutex writeMutex_;
+        std::ofstream out_;
+        std::string path_;
+        std::uint64_t written_ = 0;
+        std::atomic<std::uint64_t> exported_{0};
+
+        void run();
+        void writeBatch(std::vector<SpanRecord>& batch);
+        void open();
+        void rotateIfNeeded();
+        [[nodiscard]] std::string chromeEvent(const SpanRecord& record) const;
+        [[nodiscard]] std::string otlpRequest(const std::vector<SpanRecord>& batch) const;
+    };
+}
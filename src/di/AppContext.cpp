@@ -32,10 +32,36 @@ void appctx::wire(const std::shared_ptr<AppContext>& ctx) {
     ctx->jwtService = std::make_unique<JwtService>(ctx->config);
     ctx->swaggerController = std::make_unique<SwaggerController>(ctx->rootPath);
     ctx->healthController = std::make_unique<HealthController>();
+    ctx->metricsController = std::make_unique<MetricsController>(ctx->config.metrics_token);
+    if (ctx->config.profiler_enabled) {
+        ctx->profilerController = std::make_unique<ProfilerController>(*ctx->blockingPool);
+    }
+    if (!ctx->config.capture_path.empty()) {
+        ctx->captureWriter = std::make_shared<capture::CaptureWriter>(capture::CaptureWriter::Options{
+            .path = ctx->config.capture_path,
+            .sampleRatio = ctx->config.capture_sample,
+            .maxBytes = ctx->config.capture_max_mb * 1024 * 1024
+        });
+    }
 
     ctx->usersRepository = std::make_unique<UsersRepository>(ctx->pg);
+    UsersRepositoryInterface* usersRepository = ctx->usersRepository.get();
+    if (ctx->cache && ctx->cacheAside && ctx->config.cache_ttl > 0) {
+        ctx->cachedUsersRepository = std::make_unique<CachedUsersRepository>(
+            *ctx->usersRepository,
+            ctx->cache,
+            *ctx->cacheAside,
+            CachedUsersRepository::Options{
+                .ttl = ctx->config.cache_ttl,
+                .staleWhileRevalidate = ctx->config.cache_stale_while_revalidate,
+                .staleIfError = ctx->config.cache_stale_if_error,
+            }
+        );
+        usersRepository = ctx->cachedUsersRepository.get();
+    }
+
     ctx->usersService = std::make_unique<UsersService>(
-        *ctx->usersRepository,
+        *usersRepository,
         *ctx->fileSystemService,
         *ctx->blockingPool,
         ctx->passwordHasher
@@ -49,7 +75,7 @@ void appctx::wire(const std::shared_ptr<AppContext>& ctx) {
     );
 
     ctx->authenticationService = std::make_unique<AuthenticationService>(
-        *ctx->usersRepository,
+        *usersRepository,
         *ctx->jwtService,
         *ctx->blockingPool,
         ctx->passwordHasher
@@ -1,7 +1,10 @@
 #pragma once
 #include <memory>
-#include "core/db/postgres/interfaces/PgPool.h"
+#include "core/db/postgres/interfaces/PgPoolInterface.h"
 #include "core/configs/EnvConfig.h"
+#include "core/caching/CacheAside.h"
+#include "core/caching/interfaces/CacheInterface.h"
+#include "core/capture/CaptureLog.h"
 #include "services/jwt/JwtService.h"
 
 /// Health
@@ -9,11 +12,14 @@
 /// Users
 #include "controllers/UsersController.h"
 #include "repositories/users/UsersRepository.h"
+#include "repositories/users/CachedUsersRepository.h"
 #include "services/users/UsersService.h"
 /// Authentication
 #include "controllers/auth/AuthenticationController.h"
 #include "core/hashers/SodiumPasswordHasher.h"
 #include "core/openapi/controllers/SwaggerController.h"
+#include "core/metrics/controllers/MetricsController.h"
+#include "core/profiling/controllers/ProfilerController.h"
 #include "middlewares/AuthenticationMiddleware.h"
 #include "services/auth/AuthenticationService.h"
 
@@ -22,18 +28,24 @@ struct AppContext {
 
     // Add a pool for blocking operations (files, cryptography, heavy calculations)
     std::shared_ptr<net::thread_pool> blockingPool;
-    std::shared_ptr<PgPool> pg;
+    std::shared_ptr<PgPoolInterface> pg;
     std::shared_ptr<app::security::SodiumPasswordHasher> passwordHasher;
     // std::shared_ptr<Redis>  redis;
+    std::shared_ptr<CachingInterface> cache;
+    std::shared_ptr<CacheAside> cacheAside;
 
     EnvConfig config;
     std::unique_ptr<JwtService> jwtService;
     std::unique_ptr<FileSystemService> fileSystemService;
     std::unique_ptr<SwaggerController> swaggerController;
+    std::unique_ptr<MetricsController> metricsController;
+    /// Only with PROFILER_ENABLED
+    std::unique_ptr<ProfilerController> profilerController;
 
     std::unique_ptr<HealthController> healthController;
 
     std::unique_ptr<UsersRepository> usersRepository;
+    std::unique_ptr<CachedUsersRepository> cachedUsersRepository;
     std::unique_ptr<UsersService> usersService;
     std::unique_ptr<UsersController> usersController;
 
@@ -41,6 +53,8 @@ struct AppContext {
     std::unique_ptr<AuthenticationController> authenticationController;
 
     std::shared_ptr<AuthenticationMiddleware> authenticationMiddleware;
+    /// Only with CAPTURE_PATH
+    std::shared_ptr<capture::CaptureWriter> captureWriter;
 };
 
 namespace appctx {
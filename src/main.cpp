@@ -3,11 +3,18 @@
 #include "core/configs/EnvConfig.h"
 #include "core/routers/Router.h"
 #include "routes/Routes.h"
+#include "core/db/postgres/interfaces/FakePgPool.h"
 #include "core/db/postgres/interfaces/PgPool.h"
+#include "core/db/postgres/interfaces/SlowQueryLog.h"
 #include "core/hashers/SodiumPasswordHasher.h"
+#include "core/caching/InMemoryCache.h"
+#include "core/caching/CacheAside.h"
 #include "di/AppContext.h"
 #include "core/loggers/LoggerFactory.h"
 #include "core/loggers/LoggerSingleton.h"
+#include "core/metrics/LoopLagMonitor.h"
+#include "core/metrics/RuntimeMetrics.h"
+#include "core/tracing/TraceExporter.h"
 
 inline void init_crypto_once() {
     if (sodium_init() < 0) {
@@ -21,8 +28,15 @@ int main() {
 
     // Singletons
     LoggerSingleton::init(
-        LoggerFactory::create("console")
+        LoggerFactory::create(env.log_driver, env)
     );
+    LoggerSingleton::get().setLevel(LoggerInterface::parseLevel(env.log_level));
+    trace::RequestTimings::setMode(trace::RequestTimings::parseMode(env.request_timing));
+    trace::TraceExporter::instance().start({
+        .format = trace::TraceExporter::parseFormat(env.trace_exporter),
+        .dir = env.trace_dir,
+        .sampleRatio = env.trace_sample_ratio
+    });
 
     net::io_context ioc{
         static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))
@@ -44,7 +58,36 @@ int main() {
 
     // DI context
     const auto ctx = std::make_shared<AppContext>();
-    ctx->pg = std::make_shared<PgPool>(ioc.get_executor(), env.pg_dsn, env.pg_pool_size);
+    if (env.db_driver == "fake") {
+        LoggerSingleton::get().warn("DATABASE_DRIVER=fake: queries are answered from memory", {
+            {"latency_us", env.fake_db_latency_us},
+            {"latency_dist", env.fake_db_latency_dist},
+            {"error_rate", env.fake_db_error_rate}
+        });
+        ctx->pg = std::make_shared<FakePgPool>(FakePgPool::Options{
+            .latency = FakePgPool::parseLatency(env.fake_db_latency_dist),
+            .meanLatency = std::chrono::microseconds(env.fake_db_latency_us),
+            .errorRate = env.fake_db_error_rate,
+            .failure = FakePgPool::parseFailure(env.fake_db_error),
+            .rows = env.fake_db_rows,
+            .passwordHash = passwordHasher.hash(env.fake_db_password),
+            .size = env.pg_pool_size,
+            .defaultTimeout = std::chrono::milliseconds(env.pg_query_timeout_ms)
+        });
+    } else {
+        const auto pg = std::make_shared<PgPool>(ioc.get_executor(), env.pg_dsn, env.pg_pool_size);
+        pg->setDefaultTimeout(std::chrono::milliseconds(env.pg_query_timeout_ms));
+        pg->setSlowQueryLog(std::make_shared<SlowQueryLog>(ioc.get_executor(), env.pg_dsn, SlowQueryLog::Options{
+            .threshold = std::chrono::milliseconds(env.pg_slow_query_ms),
+            .explainEvery = env.pg_explain_sample
+        }));
+        ctx->pg = pg;
+    }
+    metrics::registerPgPool(ctx->pg);
+    metrics::registerBlockingPool(std::thread::hardware_concurrency());
+    metrics::registerHeap();
+    ctx->cache = std::make_shared<InMemoryCache>();
+    ctx->cacheAside = std::make_shared<CacheAside>(ctx->cache, ioc.get_executor());
     ctx->blockingPool = blockingPool;
     ctx->config = env;
     ctx->passwordHasher = std::make_shared<app::security::SodiumPasswordHasher>(passwordHasher);
@@ -55,10 +98,25 @@ int main() {
 
     Router router;
     app::define_routes(router, ctx);
+
+    metrics::LoopLagMonitor loopMonitor({
+        .interval = std::chrono::milliseconds(env.loop_lag_interval_ms),
+        .stallThreshold = std::chrono::milliseconds(env.loop_stall_threshold_ms),
+        .captureStacks = env.loop_stall_stacks
+    });
+    loopMonitor.watch("io", ioc.get_executor());
+    // Lag here is queueing behind offloaded work, expected under load: no stall warnings
+    loopMonitor.watch("blocking", blockingPool->get_executor(), false);
+    // Bootstrap runs the loop on this thread
+    loopMonitor.registerCurrentThread();
+    loopMonitor.start();
+
     Bootstrap bootstrap;
     const int result =  bootstrap.run(ioc, env, router);
 
+    loopMonitor.stop();
     // Important: join on exit, to ensure graceful end of tasks
     blockingPool->join();
+    trace::TraceExporter::instance().stop();
     return result;
 }
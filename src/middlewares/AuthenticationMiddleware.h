@@ -19,6 +19,7 @@ public:
     {}
 
     net::awaitable<Outcome> handle(Request& request, Next next) override;
+    [[nodiscard]] trace::Phase phase() const noexcept override { return trace::Phase::Auth; }
 
 protected:
     JwtService& jwtService_;
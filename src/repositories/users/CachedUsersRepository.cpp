@@ -0,0 +1,247 @@
+#include "repositories/users/CachedUsersRepository.h"
+#include "core/loggers/LoggerSingleton.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <nlohmann/json.hpp>
+
+namespace {
+    using nlohmann::json;
+
+    const std::string kTableGenerationKey = "users:gen";
+
+    /// Microseconds since epoch, strictly increasing within the process even if the clock steps back
+    std::string nextUserGeneration() {
+        static std::atomic<std::int64_t> last{0};
+        const std::int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+        std::int64_t previous = last.load(std::memory_order_relaxed);
+        std::int64_t next;
+        do {
+            next = std::max(now, previous + 1);
+        } while (!last.compare_exchange_weak(previous, next, std::memory_order_relaxed));
+        return std::to_string(next);
+    }
+
+    std::int64_t toMicros(const std::chrono::system_clock::time_point tp) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count();
+    }
+
+    std::chrono::system_clock::time_point fromMicros(const std::int64_t us) {
+        return std::chrono::system_clock::time_point{std::chrono::microseconds(us)};
+    }
+
+    json entityToJson(const UserEntity& user) {
+        json j{
+            {"id", user.id},
+            {"created_at", toMicros(user.created_at)},
+            {"updated_at", toMicros(user.updated_at)},
+        };
+        j["username"] = user.username ? json(*user.username) : json(nullptr);
+        j["email"] = user.email ? json(*user.email) : json(nullptr);
+        j["picture"] = user.picture ? json(*user.picture) : json(nullptr);
+        j["password"] = user.password ? json(*user.password) : json(nullptr);
+        return j;
+    }
+
+    std::optional<std::string> optionalString(const json& j, const char* key) {
+        if (!j.contains(key) || j[key].is_null()) return std::nullopt;
+        return j[key].get<std::string>();
+    }
+
+    UserEntity entityFromJson(const json& j) {
+        UserEntity user;
+        user.id = j.at("id").get<std::int64_t>();
+        user.username = optionalString(j, "username");
+        user.email = optionalString(j, "email");
+        user.picture = optionalString(j, "picture");
+        user.password = optionalString(j, "password");
+        user.created_at = fromMicros(j.at("created_at").get<std::int64_t>());
+        user.updated_at = fromMicros(j.at("updated_at").get<std::int64_t>());
+        return user;
+    }
+
+    template <class T>
+    std::vector<T> sortedUnique(std::vector<T> values) {
+        std::ranges::sort(values);
+        values.erase(std::ranges::unique(values).begin(), values.end());
+        return values;
+    }
+} // namespace
+
+/// json::object is ordered by key, so dump() is stable
+std::string CachedUsersRepository::normalize(const UserListFilter& filters) {
+    json j = json::object();
+    if (filters.id) j["id"] = *filters.id;
+    // ANY() is set semantics, order and duplicates do not matter
+    if (filters.id__in) j["id__in"] = sortedUnique(*filters.id__in);
+    if (filters.username) j["username"] = *filters.username;
+    if (filters.username__in) j["username__in"] = sortedUnique(*filters.username__in);
+    if (filters.email) j["email"] = *filters.email;
+    if (filters.limit) j["limit"] = *filters.limit;
+    if (filters.offset && *filters.offset > 0) j["offset"] = *filters.offset;
+    return j.dump();
+}
+
+std::string CachedUsersRepository::normalize(const UserFilter& filters) {
+    json j = json::object();
+    if (filters.id) j["id"] = *filters.id;
+    if (filters.username) j["username"] = *filters.username;
+    if (filters.email) j["email"] = *filters.email;
+    return j.dump();
+}
+
+net::awaitable<std::vector<UserEntity>> CachedUsersRepository::getList(UserListFilter& filters) const {
+    const std::string tableGen = co_await tableGeneration();
+    const std::string key = "users:list:" + tableGen + ":" + normalize(filters);
+
+    CacheAside::Loader load = [this, filters]() { return loadList(filters); };
+    const std::string cached = co_await cacheAside_.getOrLoad(key, std::move(load), asideOptions());
+
+    std::optional<std::vector<UserEntity>> users;
+    try {
+        const json j = json::parse(cached);
+        users.emplace();
+        users->reserve(j.size());
+        for (const auto& item : j) users->push_back(entityFromJson(item));
+    } catch (const std::exception& e) {
+        users.reset();
+        LoggerSingleton::get().warn("CachedUsersRepository::getList: corrupted entry, bypassing cache", {
+            {"key", key},
+            {"error", std::string(e.what())}
+        });
+    }
+    if (users) co_return std::move(*users);
+
+    co_return co_await inner_.getList(filters);
+}
+
+net::awaitable<UserEntity> CachedUsersRepository::getOne(const UserFilter& filters) const {
+    const std::string tableGen = co_await tableGeneration();
+    std::string key = "users:one:" + tableGen;
+    if (filters.id) {
+        const std::string userGen = co_await userGeneration(*filters.id);
+        key += ":" + userGen;
+    }
+    key += ":" + normalize(filters);
+
+    // Not found is thrown by inner, shared with coalesced waiters and intentionally not cached
+    CacheAside::Loader load = [this, filters]() { return loadOne(filters); };
+    const std::string cached = co_await cacheAside_.getOrLoad(key, std::move(load), asideOptions());
+
+    std::optional<UserEntity> user;
+    try {
+        user = entityFromJson(json::parse(cached));
+    } catch (const std::exception& e) {
+        LoggerSingleton::get().warn("CachedUsersRepository::getOne: corrupted entry, bypassing cache", {
+            {"key", key},
+            {"error", std::string(e.what())}
+        });
+    }
+    if (user) co_return std::move(*user);
+
+    co_return co_await inner_.getOne(filters);
+}
+
+net::awaitable<bool> CachedUsersRepository::exists(const UserFilter& filters) const {
+    std::string key = "users:exists";
+    // Lookup by id alone (auth middleware, every request) must survive writes to other users
+    const bool byIdOnly = filters.id && !filters.email && !filters.username;
+    if (!byIdOnly) {
+        const std::string tableGen = co_await tableGeneration();
+        key += ":" + tableGen;
+    }
+    if (filters.id) {
+        const std::string userGen = co_await userGeneration(*filters.id);
+        key += ":u" + std::to_string(*filters.id) + ":" + userGen;
+    }
+    key += ":" + normalize(filters);
+
+    CacheAside::Loader load = [this, filters]() { return loadExists(filters); };
+    const std::string cached = co_await cacheAside_.getOrLoad(key, std::move(load), asideOptions());
+    co_return cached == "1";
+}
+
+net::awaitable<void> CachedUsersRepository::create(UserEntity& entity) const {
+    co_await inner_.create(entity);
+    // Negative exists() for the fresh id may be cached already
+    co_await invalidate(entity.id);
+}
+
+net::awaitable<void> CachedUsersRepository::update(UserEntity& entity) const {
+    co_await inner_.update(entity);
+    co_await invalidate(entity.id);
+}
+
+net::awaitable<void> CachedUsersRepository::remove(const std::int64_t& id) const {
+    co_await inner_.remove(id);
+    co_await invalidate(id);
+}
+
+net::awaitable<std::string> CachedUsersRepository::tableGeneration() const {
+    const auto gen = co_await cacheGet(kTableGenerationKey);
+    co_return gen.value_or("0");
+}
+
+net::awaitable<std::string> CachedUsersRepository::userGeneration(const std::int64_t id) const {
+    const auto gen = co_await cacheGet(kTableGenerationKey + ":" + std::to_string(id));
+    co_return gen.value_or("0");
+}
+
+net::awaitable<void> CachedUsersRepository::invalidate(const std::int64_t id) const {
+    try {
+        co_await cache_->increment(kTableGenerationKey);
+        co_await cache_->set(kTableGenerationKey + ":" + std::to_string(id), nextUserGeneration(), userGenerationTtl());
+    } catch (const std::exception& e) {
+        LoggerSingleton::get().error("CachedUsersRepository::invalidate: failed to bump generation", {
+            {"id", std::to_string(id)},
+            {"error", std::string(e.what())}
+        });
+    }
+}
+
+net::awaitable<std::optional<std::string>> CachedUsersRepository::cacheGet(const std::string& key) const {
+    try {
+        co_return co_await cache_->get(key);
+    } catch (const std::exception& e) {
+        LoggerSingleton::get().warn("CachedUsersRepository::cacheGet: cache unavailable", {
+            {"key", key},
+            {"error", std::string(e.what())}
+        });
+    }
+    co_return std::nullopt;
+}
+
+int CachedUsersRepository::userGenerationTtl() const {
+    if (opts_.ttl <= 0) return 0;
+    const int staleWindow = std::max({0, opts_.staleWhileRevalidate, opts_.staleIfError});
+    return 2 * (opts_.ttl + staleWindow);
+}
+
+CacheAside::Options CachedUsersRepository::asideOptions() const {
+    return CacheAside::Options{
+        .ttl = opts_.ttl,
+        .beta = opts_.beta,
+        .staleWhileRevalidate = opts_.staleWhileRevalidate,
+        .staleIfError = opts_.staleIfError,
+    };
+}
+
+net::awaitable<std::string> CachedUsersRepository::loadList(UserListFilter filters) const {
+    const std::vector<UserEntity> users = co_await inner_.getList(filters);
+    json j = json::array();
+    for (const auto& user : users) j.push_back(entityToJson(user));
+    co_return j.dump();
+}
+
+net::awaitable<std::string> CachedUsersRepository::loadOne(UserFilter filters) const {
+    const UserEntity user = co_await inner_.getOne(filters);
+    co_return entityToJson(user).dump();
+}
+
+net::awaitable<std::string> CachedUsersRepository::loadExists(UserFilter filters) const {
+    const bool found = co_await inner_.exists(filters);
+    co_return found ? "1" : "0";
+}
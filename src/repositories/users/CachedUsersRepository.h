@@ -0,0 +1,71 @@
+#pragma once
+#include <memory>
+#include <string>
+
+#include "core/caching/CacheAside.h"
+#include "core/caching/interfaces/CacheInterface.h"
+#include "repositories/users/interfaces/UsersRepositoryInterface.h"
+
+/// Cache-aside decorator for UsersRepository.
+///
+/// Keys embed generation counters instead of being deleted on write:
+///  - users:gen       -> table generation, bumped on every create/update/remove (lists, email lookups)
+///  - users:gen:{id}  -> per-user generation, set to a fresh stamp when that user changes (id lookups, auth
+///                      middleware); expires after twice the entry lifetime, so one per user ever written does not
+///                      pile up, and a stamp is never reused, so no entry keyed with an older one comes back
+/// Bumping a generation orphans every key built with the old value, the orphans die by ttl.
+/// Reads go through CacheAside: concurrent misses share one query, hot keys are refreshed before expiry.
+class CachedUsersRepository final : public UsersRepositoryInterface {
+public:
+    struct Options {
+        /// Seconds, entries are additionally invalidated by generations
+        int ttl = 30;
+        /// XFetch early refresh aggressiveness, 0 disables
+        double beta = 1.0;
+        /// Seconds a stale entry may be served while refreshing in background, 0 disables
+        int staleWhileRevalidate = 0;
+        /// Seconds an expired entry may be served while the database is unavailable, 0 disables
+        int staleIfError = 0;
+    };
+
+    CachedUsersRepository(
+        UsersRepositoryInterface& inner,
+        std::shared_ptr<CachingInterface> cache,
+        CacheAside& cacheAside,
+        const Options options
+    ) : inner_(inner), cache_(std::move(cache)), cacheAside_(cacheAside), opts_(options) {}
+
+    net::awaitable<std::vector<UserEntity>> getList(UserListFilter& filters) const override;
+    [[nodiscard]] net::awaitable<UserEntity> getOne(const UserFilter& filters) const override;
+    [[nodiscard]] net::awaitable<bool> exists(const UserFilter& filters) const override;
+
+    net::awaitable<void> create(UserEntity& entity) const override;
+    net::awaitable<void> update(UserEntity& entity) const override;
+    net::awaitable<void> remove(const std::int64_t& id) const override;
+
+    /// Normalized filter representation, equal filters -> equal keys
+    static std::string normalize(const UserListFilter& filters);
+    static std::string normalize(const UserFilter& filters);
+
+private:
+    UsersRepositoryInterface& inner_;
+    std::shared_ptr<CachingInterface> cache_;
+    CacheAside& cacheAside_;
+    Options opts_;
+
+    [[nodiscard]] CacheAside::Options asideOptions() const;
+
+    /// Loaders own their filters: a background refresh outlives the request
+    net::awaitable<std::string> loadList(UserListFilter filters) const;
+    net::awaitable<std::string> loadOne(UserFilter filters) const;
+    net::awaitable<std::string> loadExists(UserFilter filters) const;
+
+    net::awaitable<std::string> tableGeneration() const;
+    net::awaitable<std::string> userGeneration(std::int64_t id) const;
+    net::awaitable<void> invalidate(std::int64_t id) const;
+    /// Outlives every entry keyed with the generation, stale windows included. 0 -> never expires
+    [[nodiscard]] int userGenerationTtl() const;
+
+    /// Cache failures must never fail the request, they are logged and treated as miss
+    net::awaitable<std::optional<std::string>> cacheGet(const std::string& key) const;
+};
@@ -36,8 +36,7 @@ net::awaitable<std::vector<UserEntity>> UsersRepository::getList(UserListFilter&
 
     PgResult result = co_await pool_->query(
         qb.str(),
-        qb.params(),
-        std::chrono::seconds(5)
+        qb.params()
     );
 
     std::vector<UserEntity> users;
@@ -70,8 +69,7 @@ net::awaitable<UserEntity> UsersRepository::getOne(const UserFilter& filters) co
     qb.limit(1);
     auto [columns_names, rows] = co_await pool_->query(
         qb.str(),
-        qb.params(),
-        std::chrono::seconds(5)
+        qb.params()
     );
     UserEntity user;
     if (rows.empty()) throw ValidationError("user_not_found");
@@ -101,8 +99,7 @@ net::awaitable<bool> UsersRepository::exists(const UserFilter& filters) const {
     qb.exists();
     auto [columns_names, rows] = co_await pool_->query(
        qb.str(),
-       qb.params(),
-       std::chrono::seconds(5)
+       qb.params()
     );
     // first and only one exists anyway as a row
     co_return rows[0].columns[0].data == "t";
@@ -126,8 +123,7 @@ net::awaitable<void> UsersRepository::create(UserEntity& entity) const {
     auto result = co_await pool_->query(
         qb.str(),
         // Remember to coordinate params and fields order to ensure SQL build correctly
-        params,
-        std::chrono::seconds(5)
+        params
     );
 
     if (!result.rows.empty() && !result.rows[0].columns[0].is_null) {
@@ -182,8 +178,7 @@ net::awaitable<void> UsersRepository::update(UserEntity& entity) const
     co_await pool_->query(
         qb.str(),
         // Remember to coordinate params and fields order to ensure SQL build correctly
-        params,
-        std::chrono::seconds(5)
+        params
     );
 }
 
@@ -198,7 +193,6 @@ net::awaitable<void> UsersRepository::remove(const std::int64_t& id) const
 
     co_await pool_->query(
         qb.str(),
-        qb.params(),
-        std::chrono::seconds(5)
+        qb.params()
     );
 }
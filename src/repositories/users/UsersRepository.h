@@ -3,15 +3,16 @@
 #include "core/repositories/BaseRepository.h"
 #include "filters/users/UserFilter.h"
 #include "filters/users/UserListFilter.h"
+#include "repositories/users/interfaces/UsersRepositoryInterface.h"
 
-class UsersRepository : BaseRepository {
+class UsersRepository : BaseRepository, public UsersRepositoryInterface {
 public:
     using BaseRepository::BaseRepository;
-    net::awaitable<std::vector<UserEntity>> getList(UserListFilter& filters) const;
-    [[nodiscard]] net::awaitable<UserEntity> getOne(const UserFilter& filters) const;
-    [[nodiscard]] net::awaitable<bool> exists(const UserFilter& filters) const;
+    net::awaitable<std::vector<UserEntity>> getList(UserListFilter& filters) const override;
+    [[nodiscard]] net::awaitable<UserEntity> getOne(const UserFilter& filters) const override;
+    [[nodiscard]] net::awaitable<bool> exists(const UserFilter& filters) const override;
 
-    net::awaitable<void> create(UserEntity& entity) const;
-    net::awaitable<void> update(UserEntity& entity) const;
-    net::awaitable<void> remove(const std::int64_t& id) const;
+    net::awaitable<void> create(UserEntity& entity) const override;
+    net::awaitable<void> update(UserEntity& entity) const override;
+    net::awaitable<void> remove(const std::int64_t& id) const override;
 };
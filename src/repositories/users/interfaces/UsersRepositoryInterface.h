@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <boost/asio/awaitable.hpp>
+
+#include "entities/UserEntity.h"
+#include "filters/users/UserFilter.h"
+#include "filters/users/UserListFilter.h"
+
+namespace net = boost::asio;
+
+/// Lets services depend on a repository without knowing whether it is cached or not
+struct UsersRepositoryInterface {
+    virtual ~UsersRepositoryInterface() = default;
+
+    virtual net::awaitable<std::vector<UserEntity>> getList(UserListFilter& filters) const = 0;
+    [[nodiscard]] virtual net::awaitable<UserEntity> getOne(const UserFilter& filters) const = 0;
+    [[nodiscard]] virtual net::awaitable<bool> exists(const UserFilter& filters) const = 0;
+
+    virtual net::awaitable<void> create(UserEntity& entity) const = 0;
+    virtual net::awaitable<void> update(UserEntity& entity) const = 0;
+    virtual net::awaitable<void> remove(const std::int64_t& id) const = 0;
+};
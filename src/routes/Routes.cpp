@@ -4,13 +4,20 @@
 #include "core/openapi/controllers/SwaggerController.h"
 #include "core/openapi/services/SwaggerService.h"
 #include "core/openapi/types/OpenApiResponses.h"
+#include "core/middlewares/CaptureMiddleware.h"
+#include "core/middlewares/ResponseCacheMiddleware.h"
+#include "core/middlewares/RequestIdMiddleware.h"
+#include "core/middlewares/ServeStaleMiddleware.h"
 #include "middlewares/AuthenticationMiddleware.h"
 
 namespace app{
     void define_routes(Router& router, const std::shared_ptr<AppContext>& ctx){
         /// Middlewares
         /// Global
-        // router.use(std::make_shared<RequestIdMiddleware>());
+        router.use(std::make_shared<RequestIdMiddleware>());
+        if (ctx->captureWriter) {
+            router.use(std::make_shared<CaptureMiddleware>(ctx->captureWriter));
+        }
         // router.use(std::make_shared<LoggingMiddleware>());
         /// Scoped
         router.get(
@@ -25,6 +32,11 @@ namespace app{
             }
         );
 
+        router.get(
+            "/metrics",
+            bind_handler(ctx->metricsController.get(), &MetricsController::index)
+        );
+
         /// Authentication
         router.post("/register", bind_handler(
             ctx->authenticationController.get(), &AuthenticationController::registration
@@ -60,6 +72,23 @@ namespace app{
         );
 
         router.use("/users", ctx->authenticationMiddleware);
+        /// Response cache and serve-stale go after auth: stored responses are per user
+        if (ctx->cache && ctx->config.response_cache_ttl > 0) {
+            const auto usersResponseCache = std::make_shared<ResponseCacheMiddleware>(
+                ctx->cache,
+                ResponseCacheMiddleware::Options{.scope = "users", .ttl = ctx->config.response_cache_ttl}
+            );
+            router.use("/users", usersResponseCache);
+            // Registration creates a user -> invalidates cached lists
+            router.use("/register", usersResponseCache);
+        }
+        if (ctx->cache) {
+            router.use("/users", std::make_shared<ServeStaleMiddleware>(
+                ctx->cache,
+                ctx->pg,
+                ServeStaleMiddleware::Options{.maxStale = std::chrono::seconds(60)}
+            ));
+        }
         /// Users CRUD
         router.get(
             "/users",
@@ -137,11 +166,28 @@ namespace app{
             }
         );
 
+        /// Debug: profiling exposes code layout and costs CPU, authenticated users only
+        if (ctx->profilerController) {
+            router.use("/debug", ctx->authenticationMiddleware);
+            router.get(
+                "/debug/pprof/profile",
+                bind_handler(ctx->profilerController.get(), &ProfilerController::profile)
+            );
+            router.get(
+                "/debug/heap",
+                bind_handler(ctx->profilerController.get(), &ProfilerController::heap)
+            );
+        }
+
         // Swagger docs
         router.get(
             "/swagger",
             bind_handler(ctx->swaggerController.get(), &SwaggerController::index)
         );
+        router.get(
+            "/openapi.json",
+            bind_handler(ctx->swaggerController.get(), &SwaggerController::document)
+        );
 
         /// OpenApi registration for controllers
         HealthController::registerOpenApi();
@@ -159,6 +205,6 @@ namespace app{
         });
 
         /// Swagger generation
-        SwaggerService::generate(router, ctx->rootPath);
+        ctx->swaggerController->setDocument(SwaggerService::generate(router, ctx->rootPath));
     };
 }
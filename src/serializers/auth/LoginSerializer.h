@@ -1,7 +1,7 @@
 #ifndef BEAST_API_LOGINSERIALIZER_H
 #define BEAST_API_LOGINSERIALIZER_H
-#include <regex>
 #include "core/serializers/BaseSerializer.h"
+#include "core/serializers/Validators.h"
 #include "entities/UserEntity.h"
 #include "core/loggers/LoggerSingleton.h"
 #include "core/errors/Errors.h"
@@ -47,7 +47,7 @@ public:
         if (!j.contains("email") || !j["email"].is_string() || j["email"].get<std::string>().empty()) {
             throw ValidationError("Email is required");
         }
-        if (!std::regex_match(j["email"].get<std::string>(), std::regex(R"(^[^@\s]+@[^@\s]+\.[^@\s]+$)"))) {
+        if (!validators::isEmail(j["email"].get<std::string>())) {
             throw ValidationError("Email is invalid");
         }
 
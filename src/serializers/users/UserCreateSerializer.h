@@ -1,11 +1,11 @@
 #pragma once
 #include <optional>
 #include <string>
-#include <regex>
 
 #include "core/errors/Errors.h"
 #include "entities/UserEntity.h"
 #include "core/serializers/BaseSerializer.h"
+#include "core/serializers/Validators.h"
 #include "core/loggers/LoggerSingleton.h"
 #include "core/openapi/specs/OpenApiSchemaSpec.h"
 
@@ -86,7 +86,7 @@ public:
         if (!j.contains("email") || !j["email"].is_string() || j["email"].get<std::string>().empty()) {
             throw ValidationError("Email is required");
         }
-        if (!std::regex_match(j["email"].get<std::string>(), std::regex(R"(^[^@\s]+@[^@\s]+\.[^@\s]+$)"))) {
+        if (!validators::isEmail(j["email"].get<std::string>())) {
             throw ValidationError("Email is invalid");
         }
 
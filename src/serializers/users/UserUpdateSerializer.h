@@ -2,8 +2,8 @@
 #include "core/errors/Errors.h"
 #include "entities/UserEntity.h"
 #include "core/serializers/BaseSerializer.h"
+#include "core/serializers/Validators.h"
 #include "core/loggers/LoggerSingleton.h"
-#include <regex>
 
 class UserUpdateSerializer final : public BaseSerializer<UserUpdateSerializer, UserEntity> {
 public:
@@ -39,7 +39,8 @@ public:
 
     friend void from_json(const nlohmann::json& j, UserUpdateSerializer& s) {
         LoggerSingleton::get().debug("UserUpdateSerializer::from_json: called", {
-            {"json", j.dump()},
+            // Multipart fields are not UTF-8 checked: a strict dump would throw out of a debug line
+            {"json", j.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace)},
         });
 
         LoggerSingleton::get().debug(
@@ -58,7 +59,7 @@ public:
             throw ValidationError("Email cannot be empty");
         }
 
-        if (j.contains("email") && !std::regex_match(j["email"].get<std::string>(), std::regex(R"(^[^@\s]+@[^@\s]+\.[^@\s]+$)"))) {
+        if (j.contains("email") && !validators::isEmail(j["email"].get<std::string>())) {
             throw ValidationError("Email is invalid");
         }
 
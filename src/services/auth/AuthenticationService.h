@@ -1,7 +1,7 @@
 #ifndef BEAST_API_AUTHENTICATIONSERVICE_H
 #define BEAST_API_AUTHENTICATIONSERVICE_H
 #include "core/hashers/SodiumPasswordHasher.h"
-#include "repositories/users/UsersRepository.h"
+#include "repositories/users/interfaces/UsersRepositoryInterface.h"
 #include "serializers/auth/LoginSerializer.h"
 #include "serializers/auth/RegisterSerializer.h"
 #include "serializers/auth/TokenResponseSerializer.h"
@@ -10,7 +10,7 @@
 class AuthenticationService {
 public:
     explicit AuthenticationService(
-        UsersRepository& usersRepository,
+        UsersRepositoryInterface& usersRepository,
         JwtService& jwtService,
         net::thread_pool& blockingPool,
         const std::shared_ptr<app::security::SodiumPasswordHasher>& passwordHasher
@@ -22,7 +22,7 @@ public:
     net::awaitable<TokenResponseSerializer> obtainTokens(LoginSerializer data) const;
     net::awaitable<void> registerUser(RegisterSerializer data) const;
 private:
-    UsersRepository& usersRepository_;
+    UsersRepositoryInterface& usersRepository_;
     JwtService& jwtService_;
     net::thread_pool& blockingPool_;
     std::shared_ptr<app::security::SodiumPasswordHasher> passwordHasher_;
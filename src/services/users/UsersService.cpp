@@ -1,20 +1,19 @@
 #include "services/users/UsersService.h"
+#include "core/loggers/Log.h"
 #include "core/loggers/LoggerSingleton.h"
 #include <algorithm>
 
 #include "core/helpers/Offload.h"
 
 net::awaitable<std::vector<UserSerializer>> UsersService::list(UserListFilter& filters, std::string host) const {
-    LoggerSingleton::get().info(
-        "UsersService::list: started", {
-            {"id", filters.id.has_value() ? std::to_string(filters.id.value()) : "null"},
-            {"id__in", filters.id__in.value_or(std::vector<int64_t>{})},
-            {"username", filters.username.value_or("null")},
-            {"username__in", filters.username__in.value_or(std::vector<std::string>{})},
-            {"email", filters.email.value_or("null")},
-            {"limit", filters.limit.has_value() ? std::to_string(filters.limit.value()) : "null"},
-            {"offset", filters.offset.has_value() ? std::to_string(filters.offset.value()) : "null"}
-        }
+    LOG_INFO("UsersService::list: started",
+        {"id", filters.id},
+        {"id__in", filters.id__in},
+        {"username", filters.username},
+        {"username__in", filters.username__in},
+        {"email", filters.email},
+        {"limit", filters.limit},
+        {"offset", filters.offset}
     );
     filters.limit = std::clamp<std::size_t>(filters.limit.value_or(50), 1, 1000);
 
@@ -23,7 +22,7 @@ net::awaitable<std::vector<UserSerializer>> UsersService::list(UserListFilter& f
     std::vector<UserSerializer> serializedUsers;
     serializedUsers.reserve(users.size());
 
-    LoggerSingleton::get().debug("Filling response serializer with data");
+    LOG_DEBUG("Filling response serializer with data");
     // We can retrieve various variants of data, modified too
 
     for (UserEntity& user : users) {
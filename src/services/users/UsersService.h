@@ -5,14 +5,14 @@
 #include "serializers/users/UserUpdateSerializer.h"
 #include "filters/users/UserListFilter.h"
 #include "core/file_system/FileSystemService.h"
-#include "repositories/users/UsersRepository.h"
+#include "repositories/users/interfaces/UsersRepositoryInterface.h"
 #include <boost/asio/thread_pool.hpp>
 #include "core/hashers/SodiumPasswordHasher.h"
 
 class UsersService {
 public:
     explicit UsersService(
-        UsersRepository& repo,
+        UsersRepositoryInterface& repo,
         FileSystemService& fs,
         net::thread_pool& blockingPool,
         const std::shared_ptr<app::security::SodiumPasswordHasher>& passwordHasher
@@ -27,7 +27,7 @@ public:
     net::awaitable<void> update(UserUpdateSerializer data, IncomingFile picture) const;
     net::awaitable<void> remove(const uint64_t& id) const;
 private:
-    UsersRepository& repo_;
+    UsersRepositoryInterface& repo_;
     FileSystemService& fs_;
     net::thread_pool& blockingPool_;
     std::shared_ptr<app::security::SodiumPasswordHasher> passwordHasher_;
@@ -0,0 +1,22 @@
+#include <gtest/gtest.h>
+#include "../../base/TestHTTPClient.h"
+
+TEST(MetricsEndpoint, ExposesRequestCountersInTextFormat)
+{
+    test::http::TestHttpClient client("test_nginx", "80");
+
+    const auto health = client.get("/health");
+    ASSERT_EQ(health.status, boost::beast::http::status::ok);
+
+    const auto response = client.get("/metrics");
+    ASSERT_EQ(response.status, boost::beast::http::status::ok);
+
+    const auto contentType = response.headers.find("Content-Type");
+    ASSERT_NE(contentType, response.headers.end());
+    EXPECT_NE(contentType->second.find("text/plain"), std::string::npos);
+
+    EXPECT_NE(response.body.find("# TYPE http_requests_total counter"), std::string::npos);
+    EXPECT_NE(response.body.find("http_requests_total{method=\"GET\",route=\"/health\",status=\"200\"}"), std::string::npos);
+    EXPECT_NE(response.body.find("# TYPE http_request_duration_seconds histogram"), std::string::npos);
+    EXPECT_NE(response.body.find("db_pool_connections{state=\"idle\"}"), std::string::npos);
+}
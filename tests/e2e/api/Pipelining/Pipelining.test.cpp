@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "../../base/TestHTTPClient.h"
+#include "../../auth/AuthSession.h"
+#include "../Users/UsersClient.h"
+
+// nginx talks to the app one request at a time: these go to the app directly
+namespace {
+    namespace net = boost::asio;
+    namespace beast = boost::beast;
+    namespace http = beast::http;
+    using tcp = net::ip::tcp;
+
+    constexpr auto kHost = "test_app";
+    constexpr auto kPort = "8080";
+
+    std::string get(const std::string& target, const std::string& requestId, const bool close = false,
+                    const std::string& extraHeaders = "") {
+        std::string raw = "GET " + target + " HTTP/1.1\r\nHost: test_app\r\nX-Request-Id: " + requestId + "\r\n";
+        if (close) raw += "Connection: close\r\n";
+        return raw + extraHeaders + "\r\n";
+    }
+
+    std::string patchUsername(const std::int64_t id, const std::string& username, const std::string& bearer) {
+        const std::string boundary = "PipeliningBoundary";
+        const std::string body = "--" + boundary + "\r\nContent-Disposition: form-data; name=\"username\"\r\n\r\n"
+            + username + "\r\n--" + boundary + "--\r\n";
+        return "PATCH /users/" + std::to_string(id) + " HTTP/1.1\r\nHost: test_app\r\nX-Request-Id: patch\r\n"
+            "Authorization: " + bearer + "\r\n"
+            "Content-Type: multipart/form-data; boundary=" + boundary + "\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+    }
+
+    class PipelinedConnection {
+    public:
+        PipelinedConnection() : socket_(ioc_) {
+            tcp::resolver resolver(ioc_);
+            net::connect(socket_, resolver.resolve(kHost, kPort));
+        }
+
+        /// All requests in one write, as a pipelining client sends them
+        void send(const std::string& requests) { net::write(socket_, net::buffer(requests)); }
+
+        bool read(http::response<http::string_body>& response) {
+            beast::error_code ec;
+            http::read(socket_, buffer_, response, ec);
+            return !ec;
+        }
+
+    private:
+        net::io_context ioc_;
+        tcp::socket socket_;
+        beast::flat_buffer buffer_;
+    };
+}
+
+TEST(Pipelining, ResponsesKeepRequestOrder)
+{
+    PipelinedConnection connection;
+    connection.send(get("/users?limit=5", "pipe-1") + get("/health", "pipe-2") + get("/metrics", "pipe-3")
+        + get("/health", "pipe-4", true));
+
+    for (const std::string expected : {"pipe-1", "pipe-2", "pipe-3", "pipe-4"}) {
+        http::response<http::string_body> response;
+        ASSERT_TRUE(connection.read(response)) << "no response for " << expected;
+        // Each response carries the context of its own request, not of a neighbour dispatched at the same time
+        EXPECT_EQ(response["X-Request-Id"], expected);
+    }
+
+    // Connection: close on the last request: the app closes after answering it
+    http::response<http::string_body> extra;
+    EXPECT_FALSE(connection.read(extra));
+}
+
+TEST(Pipelining, NothingIsServedAfterConnectionClose)
+{
+    PipelinedConnection connection;
+    connection.send(get("/health", "close-1", true) + get("/health", "close-2"));
+
+    http::response<http::string_body> response;
+    ASSERT_TRUE(connection.read(response));
+    EXPECT_EQ(response["X-Request-Id"], "close-1");
+    EXPECT_FALSE(response.keep_alive());
+
+    http::response<http::string_body> extra;
+    EXPECT_FALSE(connection.read(extra));
+}
+
+TEST(Pipelining, WriteIsVisibleToTheReadPipelinedAfterIt)
+{
+    auto [bearer] = test::http::AuthSession::obtain("test_nginx", "80");
+    test::http::UsersClient api("test_nginx", "80", bearer);
+
+    const std::string suffix = std::to_string(::getpid());
+    auto [stCreated, created, rawCreated] = api.store({
+        {"username", "pipeline_" + suffix},
+        {"email", "pipeline_" + suffix + "@example.com"},
+        {"password", "Passw0rd!"}
+    });
+    ASSERT_EQ(stCreated, http::status::created) << rawCreated;
+    const std::int64_t id = created["id"].get<std::int64_t>();
+
+    // The GET arrives together with the PATCH: it must not run before the update finished
+    const std::string renamed = "pipeline_renamed_" + suffix;
+    PipelinedConnection connection;
+    connection.send(patchUsername(id, renamed, bearer)
+        + get("/users?id__in=" + std::to_string(id), "read", true, "Authorization: " + bearer + "\r\n"));
+
+    http::response<http::string_body> patched;
+    ASSERT_TRUE(connection.read(patched));
+    EXPECT_EQ(patched["X-Request-Id"], "patch");
+    ASSERT_TRUE(patched.result() == http::status::ok || patched.result() == http::status::no_content) << patched.body();
+
+    http::response<http::string_body> read;
+    ASSERT_TRUE(connection.read(read));
+    EXPECT_EQ(read["X-Request-Id"], "read");
+    ASSERT_EQ(read.result(), http::status::ok) << read.body();
+    const json users = json::parse(read.body());
+    ASSERT_EQ(users.size(), 1u) << read.body();
+    EXPECT_EQ(users[0]["username"], renamed);
+
+    (void)api.remove(id);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "../../base/TestHTTPClient.h"
+#include "../../auth/AuthSession.h"
+
+#include <sstream>
+
+TEST(Profiler, RequiresAuthentication)
+{
+    test::http::TestHttpClient client("test_nginx", "80");
+
+    const auto response = client.getRaw("/debug/pprof/profile?seconds=1");
+    EXPECT_EQ(response.status, boost::beast::http::status::unauthorized);
+}
+
+TEST(Profiler, RejectsInvalidDuration)
+{
+    auto [bearer] = test::http::AuthSession::obtain("test_nginx", "80");
+    test::http::TestHttpClient client("test_nginx", "80");
+
+    const auto response = client.getRaw("/debug/pprof/profile?seconds=abc", {{"Authorization", bearer}});
+    EXPECT_EQ(response.status, boost::beast::http::status::bad_request);
+}
+
+TEST(Profiler, ReturnsFoldedStacks)
+{
+    auto [bearer] = test::http::AuthSession::obtain("test_nginx", "80");
+    test::http::TestHttpClient client("test_nginx", "80");
+
+    const auto response = client.getRaw("/debug/pprof/profile?seconds=1&hz=199", {{"Authorization", bearer}});
+    ASSERT_EQ(response.status, boost::beast::http::status::ok) << response.rawBody;
+
+    const auto contentType = response.headers.find("content-type");
+    ASSERT_NE(contentType, response.headers.end());
+    EXPECT_NE(contentType->second.find("text/plain"), std::string::npos);
+    ASSERT_NE(response.headers.find("x-profile-samples"), response.headers.end());
+    EXPECT_EQ(response.headers.at("x-profile-hz"), "199");
+
+    // An idle server may burn no CPU at all: only the shape of the lines is checked
+    std::istringstream lines(response.rawBody);
+    for (std::string line; std::getline(lines, line);) {
+        const auto space = line.rfind(' ');
+        ASSERT_NE(space, std::string::npos) << line;
+        EXPECT_GT(std::stoul(line.substr(space + 1)), 0u) << line;
+    }
+}
+
+TEST(Profiler, ReturnsHeapSnapshot)
+{
+    auto [bearer] = test::http::AuthSession::obtain("test_nginx", "80");
+    test::http::TestHttpClient client("test_nginx", "80");
+
+    const auto response = client.getRaw("/debug/heap", {{"Authorization", bearer}});
+    ASSERT_EQ(response.status, boost::beast::http::status::ok) << response.rawBody;
+    ASSERT_TRUE(response.body.contains("tracking"));
+    ASSERT_TRUE(response.body.contains("malloc"));
+    EXPECT_TRUE(response.body["malloc"]["in_use_bytes"].is_number_unsigned());
+    if (response.body["tracking"].get<bool>()) {
+        EXPECT_GT(response.body["allocations"]["total"].get<std::uint64_t>(), 0u);
+    }
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "../../base/TestHTTPClient.h"
+
+namespace {
+    constexpr auto kTraceId = "4bf92f3577b34da6a3ce929d0e0e4736";
+}
+
+TEST(Tracing, EchoesValidRequestId)
+{
+    test::http::TestHttpClient client("test_nginx", "80");
+
+    const auto response = client.getRaw("/health", {{"X-Request-Id", "e2e-request.42"}});
+    ASSERT_EQ(response.status, boost::beast::http::status::ok);
+
+    const auto requestId = response.headers.find("x-request-id");
+    ASSERT_NE(requestId, response.headers.end());
+    EXPECT_EQ(requestId->second, "e2e-request.42");
+}
+
+TEST(Tracing, ReplacesInvalidRequestIdWithTraceId)
+{
+    test::http::TestHttpClient client("test_nginx", "80");
+
+    const auto response = client.getRaw("/health", {{"X-Request-Id", "bad id with spaces"}});
+    ASSERT_EQ(response.status, boost::beast::http::status::ok);
+
+    const auto requestId = response.headers.find("x-request-id");
+    const auto traceParent = response.headers.find("traceparent");
+    ASSERT_NE(requestId, response.headers.end());
+    ASSERT_NE(traceParent, response.headers.end());
+    EXPECT_EQ(requestId->second.size(), 32u);
+    EXPECT_EQ(traceParent->second.substr(3, 32), requestId->second);
+}
+
+TEST(Tracing, ContinuesIncomingTraceParent)
+{
+    test::http::TestHttpClient client("test_nginx", "80");
+
+    const std::string incoming = std::string("00-") + kTraceId + "-00f067aa0ba902b7-01";
+    const auto response = client.getRaw("/health", {{"traceparent", incoming}});
+    ASSERT_EQ(response.status, boost::beast::http::status::ok);
+
+    const auto traceParent = response.headers.find("traceparent");
+    ASSERT_NE(traceParent, response.headers.end());
+    ASSERT_EQ(traceParent->second.size(), 55u);
+    EXPECT_EQ(traceParent->second.substr(0, 36), std::string("00-") + kTraceId + "-");
+    // Our root span becomes the parent of whatever the caller does next
+    EXPECT_NE(traceParent->second.substr(36, 16), "00f067aa0ba902b7");
+}
+
+TEST(Tracing, UnmatchedRoutesCarryRequestId)
+{
+    test::http::TestHttpClient client("test_nginx", "80");
+
+    const auto response = client.getRaw("/definitely-not-a-route", {{"X-Request-Id", "missing-route"}});
+    ASSERT_EQ(response.status, boost::beast::http::status::not_found);
+
+    const auto requestId = response.headers.find("x-request-id");
+    ASSERT_NE(requestId, response.headers.end());
+    EXPECT_EQ(requestId->second, "missing-route");
+}
+
+TEST(Tracing, ReportsServerTimingPhases)
+{
+    test::http::TestHttpClient client("test_nginx", "80");
+
+    const auto response = client.getRaw("/health");
+    ASSERT_EQ(response.status, boost::beast::http::status::ok);
+
+    // Test environment runs with REQUEST_TIMING=header
+    const auto timing = response.headers.find("server-timing");
+    ASSERT_NE(timing, response.headers.end());
+    EXPECT_NE(timing->second.find("parse;dur="), std::string::npos);
+    EXPECT_NE(timing->second.find("cpu;dur="), std::string::npos);
+    EXPECT_NE(timing->second.find("total;dur="), std::string::npos);
+}
@@ -258,6 +258,53 @@ TEST(UsersUpdate, PatchMultipartPng_ThenIndexFindById_ThenFetchSameFileBytes)
     ) << fileRes2.rawBody;
 }
 
+/// CONDITIONAL REQUESTS
+
+TEST(UsersIndex, ReturnsEtag_ThenNotModifiedOnIfNoneMatch)
+{
+    auto [bearer] = test::http::AuthSession::obtain("test_nginx", "80");
+    test::http::UsersClient api("test_nginx", "80", bearer);
+
+    auto first = api.getRaw("/users?limit=5&offset=0");
+    ASSERT_EQ(first.status, boost::beast::http::status::ok) << first.rawBody;
+    ASSERT_TRUE(first.headers.contains("etag"));
+    const std::string etag = first.headers.at("etag");
+
+    // Query parameter order must not matter
+    auto second = api.getRaw("/users?offset=0&limit=5", {{"If-None-Match", etag}});
+    ASSERT_EQ(second.status, boost::beast::http::status::not_modified) << second.rawBody;
+    ASSERT_TRUE(second.rawBody.empty());
+    ASSERT_EQ(second.headers.at("etag"), etag);
+}
+
+TEST(UsersIndex, WriteInvalidatesEtag)
+{
+    auto [bearer] = test::http::AuthSession::obtain("test_nginx", "80");
+    test::http::UsersClient api("test_nginx", "80", bearer);
+
+    const std::string username = "etag_user_" + std::to_string(std::random_device{}());
+    const std::string target = "/users?username=" + username;
+
+    auto before = api.getRaw(target);
+    ASSERT_EQ(before.status, boost::beast::http::status::ok) << before.rawBody;
+    ASSERT_TRUE(before.body.is_array());
+    ASSERT_TRUE(before.body.empty());
+    const std::string etag = before.headers.at("etag");
+
+    json payload{
+        {"username", username},
+        {"email",    username + "@example.com"},
+        {"password", username + "@example.com"}
+    };
+    auto [stStore, created, rawStore] = api.store(payload);
+    ASSERT_EQ(stStore, boost::beast::http::status::created) << rawStore;
+
+    auto after = api.getRaw(target, {{"If-None-Match", etag}});
+    ASSERT_EQ(after.status, boost::beast::http::status::ok) << after.rawBody;
+    ASSERT_EQ(after.body.size(), 1u);
+    ASSERT_NE(after.headers.at("etag"), etag);
+}
+
 //
 // Created by user on 21.02.2026.
 //
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <boost/asio/experimental/awaitable_operators.hpp>
+#include "../base/EchoServer.h"
+#include "../proxy/FaultProxy.h"
+#include "core/helpers/Offload.h"
+
+using namespace fault::test;
+using namespace boost::asio::experimental::awaitable_operators;
+
+TEST(FaultOffload, DeadlineAbandonsStalledBlockingCall)
+{
+    EchoServer echo;
+    fault::FaultProxy proxy("127.0.0.1", echo.port());
+    net::io_context blockingIo;
+    tcp::socket client = connect(blockingIo, proxy.port());
+    proxy.set({.stall = true});
+
+    // A blocking client library on the blocking pool, its dependency stops answering
+    net::thread_pool blocking(1);
+    net::io_context ioc{1};
+    bool timedOut = false;
+    double ms = 0;
+    net::co_spawn(ioc, [&]() -> net::awaitable<void> {
+        net::steady_timer deadline(ioc, std::chrono::milliseconds(200));
+        auto call = [&client] {
+            net::write(client, net::buffer(std::string("ping")));
+            std::string back(4, '\0');
+            net::read(client, net::buffer(back));
+            return back;
+        };
+        const auto startedAt = std::chrono::steady_clock::now();
+        auto offloaded = async_offload(blocking.get_executor(), call);
+        auto timer = deadline.async_wait(net::use_awaitable);
+        const auto winner = co_await (std::move(offloaded) || std::move(timer));
+        timedOut = winner.index() == 1;
+        ms = elapsedMs(startedAt);
+    }, [&ioc](const std::exception_ptr& e) {
+        // The parked task still holds work on ioc, run() would not return before it does
+        ioc.stop();
+        if (e) std::rethrow_exception(e);
+    });
+    ioc.run();
+
+    // The awaiting coroutine moves on, the blocking thread stays parked until the stall is lifted
+    EXPECT_TRUE(timedOut);
+    EXPECT_LT(ms, 1000.0);
+
+    proxy.heal();
+    blocking.join();
+}
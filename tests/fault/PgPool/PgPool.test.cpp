@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include "../base/EchoServer.h"
+#include "../base/PgFaultTest.h"
+#include "core/metrics/HdrHistogram.h"
+
+using namespace fault::test;
+using namespace std::chrono_literals;
+
+namespace {
+    /// Asks until a statement succeeds, returns how long it took from the call
+    net::awaitable<double> recover(PgPool& pool, const std::chrono::milliseconds limit) {
+        net::steady_timer pause(co_await net::this_coro::executor);
+        const auto startedAt = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - startedAt < limit) {
+            std::string error;
+            (void)co_await PgFaultTest::timed(pool, "SELECT 1", &error);
+            if (error.empty()) break;
+            pause.expires_after(50ms);
+            co_await pause.async_wait(net::use_awaitable);
+        }
+        co_return elapsedMs(startedAt);
+    }
+}
+
+TEST_F(PgFaultTest, LatencyShowsUpInP99)
+{
+    PgPool& pool = makePool(4, 1000ms);
+    run([&]() -> net::awaitable<void> {
+        metrics::HdrHistogram baseline;
+        for (int i = 0; i < 100; ++i) baseline.record(static_cast<std::uint64_t>(co_await timed(pool, "SELECT 1") * 1000));
+
+        proxy->set({.latency = fault::Faults::Latency::LogNormal, .meanLatency = 5ms});
+        metrics::HdrHistogram slow;
+        std::string error;
+        for (int i = 0; i < 200; ++i) slow.record(static_cast<std::uint64_t>(co_await timed(pool, "SELECT 1", &error) * 1000));
+
+        EXPECT_TRUE(error.empty()) << error;
+        // Request and response are delayed independently, each with a median of ~3ms
+        EXPECT_GT(slow.percentile(50), baseline.percentile(50) + 3000);
+        EXPECT_GT(slow.percentile(99), 2 * slow.percentile(50));
+        EXPECT_LT(slow.percentile(99), 1'000'000u);
+    });
+}
+
+TEST_F(PgFaultTest, StatementTimeoutFiresUnderStall)
+{
+    PgPool& pool = makePool(2, 200ms);
+    run([&]() -> net::awaitable<void> {
+        std::string error;
+        (void)co_await timed(pool, "SELECT 1", &error);
+        if (!error.empty()) {
+            ADD_FAILURE() << error;
+            co_return;
+        }
+
+        proxy->set({.stall = true});
+        const double ms = co_await timed(pool, "SELECT 1", &error);
+        EXPECT_NE(error.find("timeout"), std::string::npos) << error;
+        EXPECT_GE(ms, 190.0);
+        // The loop must not wait for the cancel request, which is stuck behind the same stall
+        EXPECT_LT(ms, 1000.0);
+
+        proxy->heal();
+        error.clear();
+        (void)co_await timed(pool, "SELECT 1", &error);
+        EXPECT_TRUE(error.empty()) << error;
+    });
+}
+
+TEST_F(PgFaultTest, BreakerOpensFailsFastAndRecovers)
+{
+    PgPool& pool = makePool(5, 100ms);
+    run([&]() -> net::awaitable<void> {
+        co_await warm(pool, 5);
+        EXPECT_EQ(pool.stats().open, 5u);
+
+        // Five connections time out together: five failures in a row
+        proxy->set({.stall = true});
+        co_await warm(pool, 5);
+        EXPECT_TRUE(pool.stats().breakerOpen);
+        EXPECT_TRUE(pool.degraded());
+
+        std::string error;
+        const double rejectedMs = co_await timed(pool, "SELECT 1", &error);
+        EXPECT_NE(error.find("circuit open"), std::string::npos) << error;
+        EXPECT_LT(rejectedMs, 20.0);
+
+        proxy->heal();
+        const double recoveryMs = co_await recover(pool, 10s);
+        // Open for 3s after the last failure, then one half-open probe closes it
+        EXPECT_LT(recoveryMs, 4500.0);
+        EXPECT_FALSE(pool.stats().breakerOpen);
+        EXPECT_FALSE(pool.degraded());
+    });
+}
+
+TEST_F(PgFaultTest, ResetConnectionsAreReplaced)
+{
+    PgPool& pool = makePool(4, 1000ms);
+    run([&]() -> net::awaitable<void> {
+        co_await warm(pool, 4);
+        EXPECT_EQ(pool.stats().open, 4u);
+
+        proxy->resetAll();
+        int failures = 0;
+        const auto startedAt = std::chrono::steady_clock::now();
+        for (int i = 0; i < 8; ++i) {
+            std::string error;
+            (void)co_await timed(pool, "SELECT 1", &error);
+            if (error.empty()) break;
+            ++failures;
+        }
+        // Each broken connection fails once and is dropped, below the breaker threshold
+        EXPECT_LE(failures, 4);
+        EXPECT_LT(elapsedMs(startedAt), 1000.0);
+        EXPECT_FALSE(pool.stats().breakerOpen);
+    });
+}
+
+TEST_F(PgFaultTest, RefusedConnectionsOpenTheBreaker)
+{
+    PgPool& pool = makePool(2, 1000ms);
+    proxy->set({.refuse = true});
+    run([&]() -> net::awaitable<void> {
+        for (int i = 0; i < 5; ++i) {
+            std::string error;
+            const double ms = co_await timed(pool, "SELECT 1", &error);
+            EXPECT_FALSE(error.empty());
+            EXPECT_LT(ms, 500.0);
+        }
+        EXPECT_TRUE(pool.stats().breakerOpen);
+        EXPECT_EQ(pool.stats().open, 0u);
+    });
+}
+
+TEST_F(PgFaultTest, BandwidthCapSlowsLargeResults)
+{
+    PgPool& pool = makePool(1, 10'000ms);
+    run([&]() -> net::awaitable<void> {
+        const std::string sql = "SELECT repeat('x', 262144)";
+        std::string error;
+        const double fastMs = co_await timed(pool, sql, &error);
+        if (!error.empty()) {
+            ADD_FAILURE() << error;
+            co_return;
+        }
+
+        proxy->set({.bandwidth = 256 * 1024});
+        const double cappedMs = co_await timed(pool, sql, &error);
+        EXPECT_TRUE(error.empty()) << error;
+        EXPECT_GE(cappedMs, 800.0);
+        EXPECT_GT(cappedMs, 4 * fastMs);
+    });
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "../base/EchoServer.h"
+#include "../proxy/FaultProxy.h"
+#include "core/metrics/HdrHistogram.h"
+
+using namespace fault::test;
+
+namespace {
+    std::string roundTrip(tcp::socket& socket, const std::string& payload) {
+        net::write(socket, net::buffer(payload));
+        std::string back(payload.size(), '\0');
+        net::read(socket, net::buffer(back));
+        return back;
+    }
+}
+
+TEST(FaultProxy, ForwardsTransparently)
+{
+    EchoServer echo;
+    fault::FaultProxy proxy("127.0.0.1", echo.port());
+    net::io_context ioc;
+    tcp::socket socket = connect(ioc, proxy.port());
+
+    std::string payload(1024 * 1024, '\0');
+    for (std::size_t i = 0; i < payload.size(); ++i) payload[i] = static_cast<char>(i * 31);
+    // Written and read concurrently: a 1MB echo does not fit into the socket buffers
+    std::thread writer([&socket, &payload] { net::write(socket, net::buffer(payload)); });
+    std::string back(payload.size(), '\0');
+    net::read(socket, net::buffer(back));
+    writer.join();
+
+    EXPECT_EQ(back, payload);
+    EXPECT_EQ(proxy.acceptedConnections(), 1u);
+    EXPECT_EQ(proxy.relayedBytes(), 2 * payload.size());
+}
+
+TEST(FaultProxy, DelaysEachDirection)
+{
+    EchoServer echo;
+    fault::FaultProxy proxy("127.0.0.1", echo.port());
+    proxy.set({.meanLatency = std::chrono::milliseconds(50)});
+    net::io_context ioc;
+    tcp::socket socket = connect(ioc, proxy.port());
+
+    const auto startedAt = std::chrono::steady_clock::now();
+    EXPECT_EQ(roundTrip(socket, "ping"), "ping");
+    const double ms = elapsedMs(startedAt);
+    EXPECT_GE(ms, 100.0);
+    EXPECT_LT(ms, 400.0);
+}
+
+TEST(FaultProxy, LogNormalLatencyHasATail)
+{
+    EchoServer echo;
+    fault::FaultProxy proxy("127.0.0.1", echo.port());
+    proxy.set({.latency = fault::Faults::Latency::LogNormal, .meanLatency = std::chrono::milliseconds(2)});
+    net::io_context ioc;
+    tcp::socket socket = connect(ioc, proxy.port());
+
+    metrics::HdrHistogram latency;
+    for (int i = 0; i < 200; ++i) {
+        const auto startedAt = std::chrono::steady_clock::now();
+        roundTrip(socket, "ping");
+        latency.record(static_cast<std::uint64_t>(elapsedMs(startedAt) * 1000));
+    }
+    // sigma 1 per direction: the tail is several medians away, a fixed delay would keep them together
+    EXPECT_GT(latency.percentile(99), 2 * latency.percentile(50));
+    EXPECT_GT(latency.mean(), 2000.0);
+}
+
+TEST(FaultProxy, CapsBandwidth)
+{
+    EchoServer echo;
+    fault::FaultProxy proxy("127.0.0.1", echo.port());
+    proxy.set({.bandwidth = 64 * 1024});
+    net::io_context ioc;
+    tcp::socket socket = connect(ioc, proxy.port());
+
+    const auto startedAt = std::chrono::steady_clock::now();
+    roundTrip(socket, std::string(32 * 1024, 'x'));
+    // 32KB at 64KB/s each way, the directions overlap
+    EXPECT_GE(elapsedMs(startedAt), 400.0);
+}
+
+TEST(FaultProxy, StallHoldsBytesUntilLifted)
+{
+    EchoServer echo;
+    fault::FaultProxy proxy("127.0.0.1", echo.port());
+    net::io_context ioc;
+    tcp::socket socket = connect(ioc, proxy.port());
+    EXPECT_EQ(roundTrip(socket, "warm"), "warm");
+
+    proxy.set({.stall = true});
+    net::write(socket, net::buffer(std::string("held")));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(socket.available(), 0u);
+    EXPECT_EQ(proxy.openConnections(), 1u);
+
+    proxy.heal();
+    std::string back(4, '\0');
+    net::read(socket, net::buffer(back));
+    EXPECT_EQ(back, "held");
+}
+
+TEST(FaultProxy, ResetAllSendsRst)
+{
+    EchoServer echo;
+    fault::FaultProxy proxy("127.0.0.1", echo.port());
+    net::io_context ioc;
+    tcp::socket socket = connect(ioc, proxy.port());
+    EXPECT_EQ(roundTrip(socket, "warm"), "warm");
+
+    proxy.resetAll();
+    boost::system::error_code ec;
+    char byte = 0;
+    net::read(socket, net::buffer(&byte, 1), ec);
+    EXPECT_EQ(ec, net::error::connection_reset);
+}
+
+TEST(FaultProxy, ResetsAfterByteBudget)
+{
+    EchoServer echo;
+    fault::FaultProxy proxy("127.0.0.1", echo.port());
+    proxy.set({.resetAfterBytes = 1000});
+    net::io_context ioc;
+    tcp::socket socket = connect(ioc, proxy.port());
+
+    EXPECT_EQ(roundTrip(socket, std::string(400, 'a')), std::string(400, 'a'));
+    boost::system::error_code ec;
+    net::write(socket, net::buffer(std::string(400, 'b')), ec);
+    std::string back(400, '\0');
+    net::read(socket, net::buffer(back), ec);
+    EXPECT_EQ(ec, net::error::connection_reset);
+}
+
+TEST(FaultProxy, RefuseResetsNewConnections)
+{
+    EchoServer echo;
+    fault::FaultProxy proxy("127.0.0.1", echo.port());
+    proxy.set({.refuse = true});
+    net::io_context ioc;
+    tcp::socket socket = connect(ioc, proxy.port());
+
+    boost::system::error_code ec;
+    char byte = 0;
+    net::read(socket, net::buffer(&byte, 1), ec);
+    EXPECT_TRUE(ec == net::error::connection_reset || ec == net::error::eof) << ec.message();
+    EXPECT_EQ(proxy.openConnections(), 0u);
+}
+
+TEST(FaultProxy, LatencyDoesNotThrottleStreams)
+{
+    EchoServer echo;
+    fault::FaultProxy proxy("127.0.0.1", echo.port());
+    proxy.set({.meanLatency = std::chrono::milliseconds(50)});
+    net::io_context ioc;
+    tcp::socket socket = connect(ioc, proxy.port());
+
+    // 1MB is 64 chunks each way: delayed from arrival they overlap, one delay per read would take 6s
+    const std::string payload(1024 * 1024, 'x');
+    const auto startedAt = std::chrono::steady_clock::now();
+    std::thread writer([&socket, &payload] { net::write(socket, net::buffer(payload)); });
+    std::string back(payload.size(), '\0');
+    net::read(socket, net::buffer(back));
+    writer.join();
+
+    EXPECT_EQ(back, payload);
+    EXPECT_GE(elapsedMs(startedAt), 100.0);
+    EXPECT_LT(elapsedMs(startedAt), 2000.0);
+}
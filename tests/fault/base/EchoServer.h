@@ -0,0 +1,61 @@
+#ifndef BEAST_API_FAULT_ECHOSERVER_H
+#define BEAST_API_FAULT_ECHOSERVER_H
+
+#include <boost/asio.hpp>
+#include <array>
+#include <thread>
+
+namespace fault::test {
+    namespace net = boost::asio;
+    using tcp = net::ip::tcp;
+
+    /// Dependency stand-in for the proxy's own tests: echoes every byte back, on its own thread
+    class EchoServer {
+    public:
+        EchoServer() : acceptor_(ioc_, tcp::endpoint(net::ip::make_address("127.0.0.1"), 0)) {
+            net::co_spawn(ioc_, accept(), net::detached);
+            thread_ = std::thread([this] { ioc_.run(); });
+        }
+
+        ~EchoServer() {
+            ioc_.stop();
+            thread_.join();
+        }
+
+        [[nodiscard]] std::uint16_t port() const { return acceptor_.local_endpoint().port(); }
+
+    private:
+        net::io_context ioc_{1};
+        tcp::acceptor acceptor_;
+        std::thread thread_;
+
+        net::awaitable<void> accept() {
+            while (true) {
+                tcp::socket socket = co_await acceptor_.async_accept(net::use_awaitable);
+                net::co_spawn(ioc_, echo(std::move(socket)), net::detached);
+            }
+        }
+
+        static net::awaitable<void> echo(tcp::socket socket) {
+            std::array<char, 16 * 1024> buffer{};
+            while (true) {
+                const std::size_t n = co_await socket.async_read_some(net::buffer(buffer), net::use_awaitable);
+                co_await net::async_write(socket, net::buffer(buffer.data(), n), net::use_awaitable);
+            }
+        }
+    };
+
+    /// Blocking client: the test thread plays the code under test
+    inline tcp::socket connect(net::io_context& ioc, const std::uint16_t port) {
+        tcp::socket socket(ioc);
+        socket.connect(tcp::endpoint(net::ip::make_address("127.0.0.1"), port));
+        socket.set_option(tcp::no_delay(true));
+        return socket;
+    }
+
+    inline double elapsedMs(const std::chrono::steady_clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+    }
+} // namespace fault::test
+
+#endif //BEAST_API_FAULT_ECHOSERVER_H
@@ -0,0 +1,90 @@
+#ifndef BEAST_API_FAULT_PGFAULTTEST_H
+#define BEAST_API_FAULT_PGFAULTTEST_H
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "../proxy/FaultProxy.h"
+#include "core/db/postgres/interfaces/PgPool.h"
+#include "core/errors/Errors.h"
+
+namespace fault::test {
+    /// PgPool behind a FaultProxy. Skipped unless a Postgres is configured:
+    ///   FAULT_PG_DSN   libpq keywords without host/port, e.g. "dbname=core_db user=core_db_user password=..."
+    ///   FAULT_PG_HOST  server the proxy forwards to, 127.0.0.1 by default
+    ///   FAULT_PG_PORT  5432 by default
+    class PgFaultTest : public ::testing::Test {
+    protected:
+        std::unique_ptr<FaultProxy> proxy;
+        net::io_context ioc{1};
+
+        void SetUp() override {
+            const char* dsn = std::getenv("FAULT_PG_DSN");
+            if (!dsn || !*dsn) GTEST_SKIP() << "FAULT_PG_DSN is not set";
+            const char* host = std::getenv("FAULT_PG_HOST");
+            const char* port = std::getenv("FAULT_PG_PORT");
+            proxy = std::make_unique<FaultProxy>(
+                host ? host : "127.0.0.1",
+                static_cast<std::uint16_t>(port ? std::atoi(port) : 5432)
+            );
+            dsn_ = std::string(dsn) + " host=127.0.0.1 port=" + std::to_string(proxy->port());
+        }
+
+        void TearDown() override {
+            // Connections still held by the pool get an RST instead of hanging on a stalled proxy
+            if (proxy) proxy->stop();
+        }
+
+        /// Breaker defaults: open after 5 failures in a row, for 3 seconds
+        PgPool& makePool(const std::size_t size, const std::chrono::milliseconds timeout) {
+            pool_ = std::make_shared<PgPool>(ioc.get_executor(), dsn_, size);
+            pool_->setDefaultTimeout(timeout);
+            return *pool_;
+        }
+
+        /// Runs body on ioc until it completes, assertion failures inside are reported as usual
+        template <class Body>
+        void run(Body body) {
+            net::co_spawn(ioc, std::move(body), [](const std::exception_ptr& e) {
+                if (e) std::rethrow_exception(e);
+            });
+            ioc.run();
+            ioc.restart();
+        }
+
+    public:
+        /// Milliseconds a statement took, failure or not; error gets what() of the failure
+        static net::awaitable<double> timed(PgPool& pool, const std::string sql, std::string* error = nullptr) {
+            const std::vector<std::optional<std::string>> params;
+            const auto startedAt = std::chrono::steady_clock::now();
+            try {
+                (void)co_await pool.query(sql, params);
+            } catch (const std::exception& e) {
+                if (error) *error = e.what();
+            }
+            co_return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startedAt).count();
+        }
+
+        /// count statements at once: each one holds its own connection while it sleeps
+        static net::awaitable<void> warm(PgPool& pool, const std::size_t count) {
+            auto executor = co_await net::this_coro::executor;
+            std::size_t pending = count;
+            net::steady_timer done(executor, std::chrono::steady_clock::time_point::max());
+            for (std::size_t i = 0; i < count; ++i) {
+                net::co_spawn(executor, timed(pool, "SELECT pg_sleep(0.05)"), [&pending, &done](const std::exception_ptr&, double) {
+                    if (--pending == 0) done.cancel();
+                });
+            }
+            boost::system::error_code ec;
+            co_await done.async_wait(net::redirect_error(net::use_awaitable, ec));
+        }
+
+    private:
+        std::string dsn_;
+        std::shared_ptr<PgPool> pool_;
+    };
+} // namespace fault::test
+
+#endif //BEAST_API_FAULT_PGFAULTTEST_H
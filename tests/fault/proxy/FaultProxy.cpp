@@ -0,0 +1,281 @@
+#include "FaultProxy.h"
+
+#include <algorithm>
+#include <deque>
+#include <future>
+
+namespace fault {
+    namespace {
+        constexpr std::size_t kChunk = 16 * 1024;
+        /// Stalled and throttled pumps look at the faults again this often
+        constexpr auto kPoll = std::chrono::milliseconds(5);
+
+        /// Bytes read ahead per direction while earlier chunks wait out their latency, then TCP pushes back
+        constexpr std::size_t kMaxQueued = 1024 * 1024;
+
+        std::chrono::microseconds sampleLatency(const Faults& faults) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                LatencyDistribution::sample(faults.latency, faults.meanLatency)
+            );
+        }
+
+        /// Parks until the timer is cancelled, operation_aborted is the wake-up signal
+        net::awaitable<void> wait(net::steady_timer& event) {
+            event.expires_at(net::steady_timer::time_point::max());
+            boost::system::error_code ignored;
+            co_await event.async_wait(net::redirect_error(net::use_awaitable, ignored));
+        }
+
+        /// SO_LINGER 0: close() sends RST instead of FIN
+        void resetSocket(tcp::socket& socket) {
+            boost::system::error_code ignored;
+            if (!socket.is_open()) return;
+            socket.set_option(tcp::socket::linger(true, 0), ignored);
+            socket.close(ignored);
+        }
+    } // namespace
+
+    Faults::Latency Faults::parseLatency(const std::string_view name) {
+        return LatencyDistribution::parse(name);
+    }
+
+    class FaultProxy::Session : public std::enable_shared_from_this<Session> {
+    public:
+        Session(FaultProxy& proxy, tcp::socket client)
+            : proxy_(proxy), client_(std::move(client)), upstream_(client_.get_executor()) {}
+
+        /// The session owns itself through self: the proxy keeps weak references only
+        static net::awaitable<void> run(std::shared_ptr<Session> self) {
+            co_await self->connectUpstream();
+        }
+
+        void reset() {
+            resetSocket(client_);
+            resetSocket(upstream_);
+        }
+
+    private:
+        FaultProxy& proxy_;
+        tcp::socket client_;
+        tcp::socket upstream_;
+        std::uint64_t relayed_ = 0;
+        int pumps_ = 2;
+
+        net::awaitable<void> connectUpstream() {
+            auto self = shared_from_this();
+            proxy_.open_.fetch_add(1, std::memory_order_relaxed);
+            try {
+                tcp::resolver resolver(client_.get_executor());
+                const auto endpoints = co_await resolver.async_resolve(
+                    proxy_.upstreamHost_, std::to_string(proxy_.upstreamPort_), net::use_awaitable
+                );
+                co_await net::async_connect(upstream_, endpoints, net::use_awaitable);
+                upstream_.set_option(tcp::no_delay(true));
+                client_.set_option(tcp::no_delay(true));
+            } catch (const std::exception&) {
+                // Upstream is down: the client sees what it would see without the proxy
+                reset();
+                proxy_.open_.fetch_sub(1, std::memory_order_relaxed);
+                co_return;
+            }
+
+            const auto executor = client_.get_executor();
+            net::co_spawn(executor, pump(client_, upstream_), [self](const std::exception_ptr&) { self->finished(); });
+            net::co_spawn(executor, pump(upstream_, client_), [self](const std::exception_ptr&) { self->finished(); });
+        }
+
+        /// First pump to end closes both sides (FIN), the other one then ends on its read
+        void finished() {
+            boost::system::error_code ignored;
+            if (client_.is_open()) client_.shutdown(tcp::socket::shutdown_send, ignored);
+            if (upstream_.is_open()) upstream_.shutdown(tcp::socket::shutdown_send, ignored);
+            if (--pumps_ == 0) {
+                client_.close(ignored);
+                upstream_.close(ignored);
+                proxy_.open_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        /// One direction: the reader stamps each chunk with its arrival, the writer forwards it once its delay
+        /// from that arrival has passed. Single-threaded io_context: no locking, a cancelled timer is a wake-up
+        struct Lane {
+            struct Chunk {
+                std::string bytes;
+                std::chrono::steady_clock::time_point due;
+            };
+
+            explicit Lane(const net::any_io_executor& executor) : readerWake(executor), writerWake(executor) {}
+
+            std::deque<Chunk> chunks;
+            std::size_t queued = 0;
+            std::chrono::steady_clock::time_point lastDue;
+            bool readDone = false;
+            bool writeDone = false;
+            net::steady_timer readerWake;
+            net::steady_timer writerWake;
+        };
+
+        /// Kept alive by the completion handler co_spawn got in connectUpstream(), the reader by its own reference
+        net::awaitable<void> pump(tcp::socket& from, tcp::socket& to) {
+            const auto lane = std::make_shared<Lane>(from.get_executor());
+            net::co_spawn(from.get_executor(), read(shared_from_this(), from, lane), net::detached);
+
+            try {
+                co_await write(to, *lane);
+            } catch (...) {
+                lane->writeDone = true;
+                lane->readerWake.cancel();
+                throw;
+            }
+            lane->writeDone = true;
+            lane->readerWake.cancel();
+        }
+
+        static net::awaitable<void> read(const std::shared_ptr<Session> self, tcp::socket& from, const std::shared_ptr<Lane> lane) {
+            try {
+                while (true) {
+                    while (lane->queued >= kMaxQueued && !lane->writeDone) co_await wait(lane->readerWake);
+                    if (lane->writeDone) break;
+
+                    const Faults faults = self->proxy_.faults();
+                    const std::size_t window = faults.bandwidth
+                        ? std::clamp<std::size_t>(faults.bandwidth / 20, 1, kChunk)
+                        : kChunk;
+                    std::string bytes(window, '\0');
+                    const std::size_t n = co_await from.async_read_some(net::buffer(bytes), net::use_awaitable);
+                    bytes.resize(n);
+
+                    // Delay counts from arrival, a chunk never overtakes the one ahead of it
+                    const auto due = std::max(std::chrono::steady_clock::now() + sampleLatency(faults), lane->lastDue);
+                    lane->lastDue = due;
+                    lane->queued += n;
+                    lane->chunks.push_back({std::move(bytes), due});
+                    lane->writerWake.cancel();
+                }
+            } catch (const std::exception&) {
+                // EOF or a reset: the writer forwards what is queued and ends
+            }
+            lane->readDone = true;
+            lane->writerWake.cancel();
+        }
+
+        net::awaitable<void> write(tcp::socket& to, Lane& lane) {
+            net::steady_timer timer(to.get_executor());
+
+            while (true) {
+                while (lane.chunks.empty() && !lane.readDone) co_await wait(lane.writerWake);
+                if (lane.chunks.empty()) co_return;
+
+                // Held, not dropped: the bytes go out once the stall is lifted
+                Faults faults;
+                while ((faults = proxy_.faults()).stall && to.is_open()) {
+                    timer.expires_after(kPoll);
+                    co_await timer.async_wait(net::use_awaitable);
+                }
+
+                Lane::Chunk chunk = std::move(lane.chunks.front());
+                lane.chunks.pop_front();
+                lane.queued -= chunk.bytes.size();
+                lane.readerWake.cancel();
+
+                if (chunk.due > std::chrono::steady_clock::now()) {
+                    timer.expires_at(chunk.due);
+                    co_await timer.async_wait(net::use_awaitable);
+                }
+
+                const std::size_t n = chunk.bytes.size();
+                if (faults.resetAfterBytes && relayed_ + n > faults.resetAfterBytes) {
+                    reset();
+                    co_return;
+                }
+
+                // Counted before the write: the peer may see the bytes before this coroutine resumes
+                relayed_ += n;
+                proxy_.relayed_.fetch_add(n, std::memory_order_relaxed);
+                const auto startedAt = std::chrono::steady_clock::now();
+                co_await net::async_write(to, net::buffer(chunk.bytes), net::use_awaitable);
+
+                if (faults.bandwidth) {
+                    const auto budget = std::chrono::microseconds(
+                        static_cast<std::int64_t>(1e6 * static_cast<double>(n) / static_cast<double>(faults.bandwidth))
+                    );
+                    timer.expires_at(startedAt + budget);
+                    co_await timer.async_wait(net::use_awaitable);
+                }
+            }
+        }
+    };
+
+    FaultProxy::FaultProxy(
+        std::string upstreamHost,
+        const std::uint16_t upstreamPort,
+        const std::uint16_t listenPort,
+        const std::string& listenAddress
+    )
+        : upstreamHost_(std::move(upstreamHost))
+        , upstreamPort_(upstreamPort)
+        , acceptor_(ioc_, tcp::endpoint(net::ip::make_address(listenAddress), listenPort)) {
+        port_ = acceptor_.local_endpoint().port();
+        net::co_spawn(ioc_, accept(), net::detached);
+        thread_ = std::thread([this] { ioc_.run(); });
+    }
+
+    FaultProxy::~FaultProxy() {
+        stop();
+    }
+
+    void FaultProxy::set(const Faults& faults) {
+        const std::lock_guard lock(mutex_);
+        faults_ = faults;
+    }
+
+    Faults FaultProxy::faults() const {
+        const std::lock_guard lock(mutex_);
+        return faults_;
+    }
+
+    void FaultProxy::resetAll() {
+        std::promise<void> done;
+        net::post(ioc_, [this, &done] {
+            for (const auto& weak : sessions_) {
+                if (const auto session = weak.lock()) session->reset();
+            }
+            done.set_value();
+        });
+        done.get_future().wait();
+    }
+
+    void FaultProxy::stop() {
+        if (!thread_.joinable()) return;
+        net::post(ioc_, [this] {
+            boost::system::error_code ignored;
+            acceptor_.close(ignored);
+            for (const auto& weak : sessions_) {
+                if (const auto session = weak.lock()) session->reset();
+            }
+            ioc_.stop();
+        });
+        thread_.join();
+    }
+
+    net::awaitable<void> FaultProxy::accept() {
+        while (acceptor_.is_open()) {
+            boost::system::error_code ec;
+            tcp::socket client = co_await acceptor_.async_accept(net::redirect_error(net::use_awaitable, ec));
+            if (ec) {
+                if (ec == net::error::operation_aborted) co_return;
+                continue;
+            }
+            accepted_.fetch_add(1, std::memory_order_relaxed);
+            if (faults().refuse) {
+                resetSocket(client);
+                continue;
+            }
+
+            std::erase_if(sessions_, [](const std::weak_ptr<Session>& weak) { return weak.expired(); });
+            auto session = std::make_shared<Session>(*this, std::move(client));
+            sessions_.push_back(session);
+            net::co_spawn(ioc_, Session::run(std::move(session)), net::detached);
+        }
+    }
+} // namespace fault
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include "core/helpers/LatencyDistribution.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace fault {
+    namespace net = boost::asio;
+    using tcp = net::ip::tcp;
+
+    /// What the proxy does to the bytes. Read per chunk, so a change applies to open connections at once
+    struct Faults {
+        using Latency = LatencyDistribution::Kind;
+
+        /// Delay of every chunk from its arrival, each direction. Chunks keep their order: a chunk is never
+        /// forwarded before the one ahead of it, reading goes on while earlier chunks wait
+        Latency latency = Latency::Fixed;
+        std::chrono::microseconds meanLatency{0};
+        /// Bytes per second per direction per connection, 0 -> unlimited
+        std::size_t bandwidth = 0;
+        /// Nothing is forwarded while set, connections stay open (half-dead peer, full queue, GC pause)
+        bool stall = false;
+        /// New connections are reset right after accept (service down, port closed)
+        bool refuse = false;
+        /// A connection is reset once it has relayed this many bytes, 0 -> never
+        std::uint64_t resetAfterBytes = 0;
+
+        static Latency parseLatency(std::string_view name);
+    };
+
+    /// TCP proxy between the code under test and a dependency (Postgres, Redis, anything over TCP).
+    /// Runs its own io_context on a background thread, so the test thread and the code under test are free
+    /// to block, and faults can be scripted from the test while traffic flows.
+    ///
+    ///   FaultProxy proxy("127.0.0.1", 5432);
+    ///   pool = PgPool(..., "host=127.0.0.1 port=" + std::to_string(proxy.port()) + ...);
+    ///   proxy.set({.stall = true});   // every query from now on hangs
+    ///   proxy.resetAll();             // every open connection gets an RST
+    class FaultProxy {
+    public:
+        /// listenPort 0 -> an ephemeral port, see port()
+        FaultProxy(
+            std::string upstreamHost,
+            std::uint16_t upstreamPort,
+            std::uint16_t listenPort = 0,
+            const std::string& listenAddress = "127.0.0.1"
+        );
+        ~FaultProxy();
+        FaultProxy(const FaultProxy&) = delete;
+        FaultProxy& operator=(const FaultProxy&) = delete;
+
+        [[nodiscard]] std::uint16_t port() const noexcept { return port_; }
+
+        void set(const Faults& faults);
+        [[nodiscard]] Faults faults() const;
+        /// Back to a transparent proxy
+        void heal() { set({}); }
+
+        /// RST to both sides of every open connection
+        void resetAll();
+
+        [[nodiscard]] std::size_t openConnections() const noexcept { return open_.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::uint64_t acceptedConnections() const noexcept { return accepted_.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::uint64_t relayedBytes() const noexcept { return relayed_.load(std::memory_order_relaxed); }
+
+        void stop();
+
+    private:
+        class Session;
+
+        std::string upstreamHost_;
+        std::uint16_t upstreamPort_;
+        net::io_context ioc_{1};
+        tcp::acceptor acceptor_;
+        std::uint16_t port_ = 0;
+        std::thread thread_;
+
+        mutable std::mutex mutex_;
+        Faults faults_;
+
+        /// Touched on the proxy thread only
+        std::list<std::weak_ptr<Session>> sessions_;
+
+        std::atomic<std::size_t> open_{0};
+        std::atomic<std::uint64_t> accepted_{0};
+        std::atomic<std::uint64_t> relayed_{0};
+
+        net::awaitable<void> accept();
+    };
+} // namespace fault
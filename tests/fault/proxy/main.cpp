@@ -0,0 +1,125 @@
+/// Standalone FaultProxy: put it between the app and a dependency, then script faults on stdin.
+///
+/// Usage: fault_proxy --upstream 127.0.0.1:5432 [--listen 15432] [--listen-address 0.0.0.0] < script
+/// One command per line, `#` starts a comment; a file piped in replays a scenario, `sleep` paces it:
+///   latency <mean_ms> [fixed|uniform|exponential|lognormal]
+///   bandwidth <bytes_per_second>        0 -> unlimited
+///   stall | unstall
+///   refuse | accept
+///   reset-after <bytes>                 0 -> never
+///   reset                               RST every open connection
+///   heal                                transparent again
+///   sleep <ms>
+///   stats
+#include "FaultProxy.h"
+
+#include <cstdio>
+#include <future>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    struct Settings {
+        std::string upstreamHost;
+        std::uint16_t upstreamPort = 0;
+        std::uint16_t listenPort = 0;
+        std::string listenAddress = "127.0.0.1";
+    };
+
+    void printUsage() {
+        std::printf("fault_proxy --upstream host:port [--listen port] [--listen-address 127.0.0.1] < script\n");
+    }
+
+    Settings parse(const int argc, char** argv) {
+        Settings s;
+        for (int i = 1; i < argc; ++i) {
+            const std::string key = argv[i];
+            if (key == "--help" || key == "-h") {
+                printUsage();
+                std::exit(0);
+            }
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + key);
+            const std::string value = argv[++i];
+            if (key == "--upstream") {
+                const auto colon = value.rfind(':');
+                if (colon == std::string::npos) throw std::invalid_argument("--upstream must be host:port");
+                s.upstreamHost = value.substr(0, colon);
+                s.upstreamPort = static_cast<std::uint16_t>(std::stoi(value.substr(colon + 1)));
+            }
+            else if (key == "--listen") s.listenPort = static_cast<std::uint16_t>(std::stoi(value));
+            else if (key == "--listen-address") s.listenAddress = value;
+            else throw std::invalid_argument("unknown option " + key);
+        }
+        if (s.upstreamHost.empty()) throw std::invalid_argument("--upstream is required");
+        return s;
+    }
+
+    /// false -> unknown command
+    bool runCommand(fault::FaultProxy& proxy, const std::string& line) {
+        std::istringstream in(line);
+        std::string command;
+        in >> command;
+        if (command.empty() || command.starts_with('#')) return true;
+
+        fault::Faults faults = proxy.faults();
+        if (command == "latency") {
+            double ms = 0;
+            std::string distribution = "fixed";
+            in >> ms >> distribution;
+            faults.meanLatency = std::chrono::microseconds(static_cast<std::int64_t>(ms * 1000));
+            faults.latency = fault::Faults::parseLatency(distribution);
+        }
+        else if (command == "bandwidth") in >> faults.bandwidth;
+        else if (command == "stall") faults.stall = true;
+        else if (command == "unstall") faults.stall = false;
+        else if (command == "refuse") faults.refuse = true;
+        else if (command == "accept") faults.refuse = false;
+        else if (command == "reset-after") in >> faults.resetAfterBytes;
+        else if (command == "heal") faults = {};
+        else if (command == "reset") {
+            proxy.resetAll();
+            return true;
+        }
+        else if (command == "sleep") {
+            int ms = 0;
+            in >> ms;
+            std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+            return true;
+        }
+        else if (command == "stats") {
+            std::printf("open=%zu accepted=%llu relayed=%llu\n",
+                proxy.openConnections(),
+                static_cast<unsigned long long>(proxy.acceptedConnections()),
+                static_cast<unsigned long long>(proxy.relayedBytes()));
+            return true;
+        }
+        else return false;
+
+        proxy.set(faults);
+        return true;
+    }
+} // namespace
+
+int main(const int argc, char** argv) {
+    Settings settings;
+    try {
+        settings = parse(argc, argv);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "fault_proxy: %s\n", e.what());
+        printUsage();
+        return 2;
+    }
+
+    fault::FaultProxy proxy(settings.upstreamHost, settings.upstreamPort, settings.listenPort, settings.listenAddress);
+    std::printf("listening on %s:%u -> %s:%u\n",
+        settings.listenAddress.c_str(), proxy.port(), settings.upstreamHost.c_str(), settings.upstreamPort);
+    std::fflush(stdout);
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (!runCommand(proxy, line)) std::fprintf(stderr, "fault_proxy: unknown command: %s\n", line.c_str());
+        std::fflush(stdout);
+    }
+    // End of script: keep proxying with the last faults until killed
+    std::promise<void>().get_future().wait();
+}
@@ -0,0 +1,39 @@
+/// FileSystemService name checks: the input is the entity name and, with non-numeric ids allowed, the entity id.
+/// maxBytes of 1 fails the file right after both are validated, nothing reaches the disk
+#include "../base/Budget.h"
+#include "core/file_system/FileSystemService.h"
+#include "core/file_system/errors/FileSystemErrors.h"
+
+#include <filesystem>
+
+std::vector<fuzz::Growth> fuzz::growthCases() {
+    return {
+        {"valid_name", "", "a", ""},
+        {"invalid_tail", "", "a", "!"},
+        {"dashes", "", "-", ""},
+    };
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, const std::size_t size) {
+    fuzz::env();
+    static const FileSystemService service(FileSystemService::Options{
+        .rootPath = std::filesystem::temp_directory_path() / "fuzz_file_system",
+        .mediaPath = "media",
+        .maxBytes = 1,
+        .allowNonNumericEntityId = true
+    });
+    const std::string_view input(reinterpret_cast<const char*>(data), size);
+    const IncomingFile file{.bytes = {0, 0}, .originalFileName = "a.png", .contentType = "image/png"};
+
+    fuzz::withinBudget("FileSystemService entity name", size, {}, [&] {
+        try {
+            (void)service.store(input, "1", file);
+        } catch (const FileError&) {}
+    });
+    fuzz::withinBudget("FileSystemService entity id", size, {}, [&] {
+        try {
+            (void)service.store("users", input, file);
+        } catch (const FileError&) {}
+    });
+    return 0;
+}
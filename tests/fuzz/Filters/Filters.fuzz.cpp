@@ -0,0 +1,23 @@
+/// BaseFilter::parseIds / parseStrings: the comma separated value of an `__in` filter is the input
+#include "../base/Budget.h"
+#include "core/filters/BaseFilter.h"
+
+std::vector<fuzz::Growth> fuzz::growthCases() {
+    return {
+        {"ids", "", "1,", ""},
+        {"overflowing_ids", "", "99999999999999999999,", ""},
+        {"empty_tokens", "1", ",", "2"},
+        {"strings", "", "alice,", ""},
+    };
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, const std::size_t size) {
+    const std::string input(reinterpret_cast<const char*>(data), size);
+    fuzz::withinBudget("BaseFilter::parseIds", size, {}, [&] {
+        (void)BaseFilter::parseIds(input);
+    });
+    fuzz::withinBudget("BaseFilter::parseStrings", size, {}, [&] {
+        (void)BaseFilter::parseStrings(input);
+    });
+    return 0;
+}
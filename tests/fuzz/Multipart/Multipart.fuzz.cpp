@@ -0,0 +1,31 @@
+/// POCOMultipartAdapter::parse: the body is the input, the boundary is fixed
+#include "../base/Budget.h"
+#include "core/errors/Errors.h"
+#include "core/multipart/adapters/POCOMultipartAdapter.h"
+
+namespace {
+    constexpr auto kContentType = "multipart/form-data; boundary=FuzzBoundary";
+}
+
+std::vector<fuzz::Growth> fuzz::growthCases() {
+    const std::string part = "--FuzzBoundary\r\nContent-Disposition: form-data; name=\"a\"\r\n\r\nx\r\n";
+    return {
+        // Whitespace in front of a disposition parameter: trimCopy used to erase it one char at a time
+        {"padded_param", "--FuzzBoundary\r\nContent-Disposition: form-data;", " ", "name=\"a\"\r\n\r\nx\r\n--FuzzBoundary--\r\n"},
+        {"many_params", "--FuzzBoundary\r\nContent-Disposition: form-data; name=\"a\"", "; k=v", "\r\n\r\nx\r\n--FuzzBoundary--\r\n"},
+        {"many_parts", "", part, "--FuzzBoundary--\r\n"},
+        {"large_field", "--FuzzBoundary\r\nContent-Disposition: form-data; name=\"a\"\r\n\r\n", "-", "\r\n--FuzzBoundary--\r\n"},
+    };
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, const std::size_t size) {
+    fuzz::env();
+    static const POCOMultipartAdapter adapter;
+    const std::string body(reinterpret_cast<const char*>(data), size);
+    fuzz::withinBudget("POCOMultipartAdapter::parse", size, {}, [&] {
+        try {
+            (void)adapter.parse(kContentType, body);
+        } catch (const MultipartError&) {}
+    });
+    return 0;
+}
@@ -0,0 +1,28 @@
+/// Request::query: the input is the query string of a GET /users target
+#include "../base/Budget.h"
+#include "core/request/Request.h"
+
+namespace {
+    /// Beast's default header limit: a longer request line never becomes a Request
+    constexpr std::size_t kMaxTarget = 8 * 1024;
+}
+
+std::vector<fuzz::Growth> fuzz::growthCases() {
+    return {
+        {"many_params", "", "a=1&", ""},
+        {"same_key", "", "id__in=1&", ""},
+        {"escapes", "q=", "%41", ""},
+        {"ampersands", "a=1", "&", ""},
+    };
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, const std::size_t size) {
+    if (size > kMaxTarget) return 0;
+    const EnvConfig& env = fuzz::env();
+    const std::string target = "/users?" + std::string(reinterpret_cast<const char*>(data), size);
+    const Request request{Request::RawRequest{http::verb::get, target, 11}, env};
+    fuzz::withinBudget("Request::query", size, {}, [&] {
+        (void)request.query();
+    });
+    return 0;
+}
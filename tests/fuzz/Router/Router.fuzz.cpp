@@ -0,0 +1,58 @@
+/// Router::dispatch over the app's route table: the target is the input, matched against every route regex
+#include "../base/Budget.h"
+#include "core/routers/Router.h"
+
+namespace {
+    net::awaitable<Outcome> okHandler(Request& request) {
+        co_return JsonResult{json{{"ok", true}}, http::status::ok, request.keep_alive()};
+    }
+
+    const Router& router() {
+        static const Router r = [] {
+            Router routes;
+            routes.get("/health", okHandler);
+            routes.get("/metrics", okHandler);
+            routes.post("/register", okHandler);
+            routes.post("/login", okHandler);
+            routes.get("/users", okHandler);
+            routes.post("/users", okHandler);
+            routes.patch("/users/{id}", okHandler);
+            routes.delete_("/users/{id}", okHandler);
+            routes.get("/debug/pprof/profile", okHandler);
+            routes.get("/debug/heap", okHandler);
+            routes.get("/swagger", okHandler);
+            routes.get("/openapi.json", okHandler);
+            return routes;
+        }();
+        return r;
+    }
+
+    /// Beast's default header limit: a longer request line never reaches the router
+    constexpr std::size_t kMaxTarget = 8 * 1024;
+
+    /// Every route's regex runs over a miss: the share per byte is per route
+    constexpr fuzz::Budget kBudget{.nsPerByte = 5'000};
+}
+
+std::vector<fuzz::Growth> fuzz::growthCases() {
+    return {
+        {"long_param", "/users/", "a", ""},
+        {"many_segments", "/users", "/1", ""},
+        {"long_query", "/users?limit=", "9", ""},
+    };
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, const std::size_t size) {
+    if (size > kMaxTarget) return 0;
+    const EnvConfig& env = fuzz::env();
+    std::string target(reinterpret_cast<const char*>(data), size);
+    if (!target.starts_with('/')) target.insert(target.begin(), '/');
+
+    Request::RawRequest raw{http::verb::get, target, 11};
+    fuzz::withinBudget("Router::dispatch", size, kBudget, [&] {
+        net::io_context ioc{1};
+        net::co_spawn(ioc, router().dispatch(Request{raw, env}, env), net::detached);
+        ioc.run();
+    });
+    return 0;
+}
@@ -0,0 +1,39 @@
+/// Email validation of the request serializers: the input is the email of a login, create and update body
+#include "../base/Budget.h"
+#include "serializers/auth/LoginSerializer.h"
+#include "serializers/users/UserCreateSerializer.h"
+#include "serializers/users/UserUpdateSerializer.h"
+
+std::vector<fuzz::Growth> fuzz::growthCases() {
+    return {
+        // A dotted domain that fails at the very end: the regex this replaced backtracked over every dot
+        {"dotted_domain", "a@", "a.", "@"},
+        {"long_local", "", "a", "@example.com"},
+        {"spaces", "a@b.c", " ", ""},
+    };
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, const std::size_t size) {
+    fuzz::env();
+    const nlohmann::json body{
+        {"email", std::string(reinterpret_cast<const char*>(data), size)},
+        {"username", "fuzz"},
+        {"password", "Passw0rd!"}
+    };
+    fuzz::withinBudget("LoginSerializer", size, {}, [&] {
+        try {
+            (void)body.get<LoginSerializer>();
+        } catch (const ValidationError&) {}
+    });
+    fuzz::withinBudget("UserCreateSerializer", size, {}, [&] {
+        try {
+            (void)body.get<UserCreateSerializer>();
+        } catch (const ValidationError&) {}
+    });
+    fuzz::withinBudget("UserUpdateSerializer", size, {}, [&] {
+        try {
+            (void)body.get<UserUpdateSerializer>();
+        } catch (const ValidationError&) {}
+    });
+    return 0;
+}
@@ -0,0 +1,113 @@
+#ifndef BEAST_API_FUZZ_BUDGET_H
+#define BEAST_API_FUZZ_BUDGET_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "core/configs/EnvConfig.h"
+#include "core/loggers/LoggerFactory.h"
+#include "core/loggers/LoggerSingleton.h"
+#include "core/profiling/AllocationTracker.h"
+
+namespace fuzz {
+    /// What one input may cost: a fixed allowance plus a share per input byte. A linear parser stays below it
+    /// at any length, a super-linear one crosses it once inputs grow. Allocations are counted only in builds
+    /// with APP_ALLOC_TRACKING (operator new is not hooked otherwise)
+    struct Budget {
+        double fixedNs = 2'000'000;
+        double nsPerByte = 500;
+        double fixedAllocBytes = 256 * 1024;
+        double allocBytesPerByte = 64;
+    };
+
+    struct Measurement {
+        std::size_t bytes = 0;
+        double ns = 0;
+        std::uint64_t allocatedBytes = 0;
+    };
+
+    /// Input shaped as prefix + repeat * n + suffix: the standalone driver grows n to expose the complexity
+    struct Growth {
+        std::string name;
+        std::string prefix;
+        std::string repeat;
+        std::string suffix;
+    };
+
+    /// Defined by every target next to LLVMFuzzerTestOneInput, the standalone driver runs them
+    std::vector<Growth> growthCases();
+
+    /// FUZZ_BUDGET_SCALE stretches every budget: sanitizer builds, slow CI machines
+    inline double budgetScale() {
+        static const double scale = [] {
+            const char* value = std::getenv("FUZZ_BUDGET_SCALE");
+            const double parsed = value ? std::atof(value) : 1.0;
+            return parsed > 0 ? parsed : 1.0;
+        }();
+        return scale;
+    }
+
+    /// Slowest call measured on this thread since the standalone driver last reset it, one input may feed
+    /// several parsers
+    inline Measurement& last() {
+        thread_local Measurement measurement;
+        return measurement;
+    }
+
+    /// Runs fn over an input of size bytes. Over the time budget it is retried twice and the best of three counts:
+    /// a preempted run is not a finding. Over either budget the process aborts, so the fuzzer keeps the input
+    template <class Fn>
+    void withinBudget(const char* target, const std::size_t size, const Budget& budget, Fn&& fn) {
+        using profiling::AllocationTracker;
+        const double scale = budgetScale();
+        const double timeLimit = (budget.fixedNs + budget.nsPerByte * static_cast<double>(size)) * scale;
+        const double allocLimit = (budget.fixedAllocBytes + budget.allocBytesPerByte * static_cast<double>(size)) * scale;
+
+        Measurement best{size, std::numeric_limits<double>::max(), std::numeric_limits<std::uint64_t>::max()};
+        for (int attempt = 0; attempt < 3; ++attempt) {
+            const auto allocatedBefore = AllocationTracker::thisThread();
+            const auto startedAt = std::chrono::steady_clock::now();
+            fn();
+            const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startedAt).count();
+            best.ns = std::min(best.ns, ns);
+            best.allocatedBytes = std::min(best.allocatedBytes, (AllocationTracker::thisThread() - allocatedBefore).bytes);
+            if (best.ns <= timeLimit) break;
+        }
+        if (best.ns > last().ns) last() = best;
+
+        if (best.ns > timeLimit) {
+            std::fflush(stdout);
+            std::fprintf(stderr, "%s: %zu bytes took %.0f ns (%.1f ns/byte), budget %.0f ns\n",
+                target, size, best.ns, best.ns / static_cast<double>(std::max<std::size_t>(1, size)), timeLimit);
+            std::abort();
+        }
+        if (AllocationTracker::kEnabled && static_cast<double>(best.allocatedBytes) > allocLimit) {
+            std::fprintf(stderr, "%s: %zu bytes allocated %llu bytes, budget %.0f\n",
+                target, size, static_cast<unsigned long long>(best.allocatedBytes), allocLimit);
+            std::abort();
+        }
+    }
+
+    /// Loggers are process-wide: error level keeps formatting out of the measurements
+    inline const EnvConfig& env() {
+        static const EnvConfig config = [] {
+            EnvConfig c;
+            c.log_driver = "console";
+            c.log_level = "error";
+            c.multipart_adapter = "POCO";
+            c.file_upload_limit_size = 10 * 1024 * 1024;
+            LoggerSingleton::init(LoggerFactory::create("console", c));
+            LoggerSingleton::get().setLevel(LoggerInterface::parseLevel(c.log_level));
+            return c;
+        }();
+        return config;
+    }
+}
+
+#endif //BEAST_API_FUZZ_BUDGET_H
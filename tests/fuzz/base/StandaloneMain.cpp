@@ -0,0 +1,135 @@
+/// Driver for compilers without libFuzzer (GCC): same targets, no coverage guidance.
+///
+/// Usage: fuzz_<target> [--max-len 65536] [--runs 0] [--seed 1] [corpus files or directories...]
+///  - every corpus input runs once;
+///  - every growth case of the target runs at doubling lengths up to --max-len, bytes, ns/byte and allocated
+///    bytes/byte are printed per step: a super-linear parser shows a growing ns/byte long before the budget trips;
+///  - --runs N mutates corpus inputs at random (flips, inserts, duplicated ranges), N inputs in total.
+/// A budget violation aborts the process, as it does under libFuzzer.
+#include "Budget.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size);
+
+namespace {
+    struct Settings {
+        std::size_t maxLen = 64 * 1024;
+        std::size_t runs = 0;
+        std::uint32_t seed = 1;
+        std::vector<std::filesystem::path> corpus;
+    };
+
+    void run(const std::string& input) {
+        LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(input.data()), input.size());
+    }
+
+    std::vector<std::string> loadCorpus(const std::vector<std::filesystem::path>& paths) {
+        std::vector<std::string> inputs;
+        const auto load = [&inputs](const std::filesystem::path& file) {
+            std::ifstream in(file, std::ios::binary);
+            inputs.emplace_back(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        };
+        for (const auto& path : paths) {
+            if (std::filesystem::is_directory(path)) {
+                for (const auto& entry : std::filesystem::directory_iterator(path)) {
+                    if (entry.is_regular_file()) load(entry.path());
+                }
+            } else {
+                load(path);
+            }
+        }
+        return inputs;
+    }
+
+    std::string mutate(std::string input, std::mt19937& rng, const std::size_t maxLen) {
+        const auto pick = [&rng](const std::size_t bound) { return bound == 0 ? 0 : std::uniform_int_distribution<std::size_t>(0, bound - 1)(rng); };
+        switch (pick(3)) {
+            case 0:
+                if (!input.empty()) input[pick(input.size())] = static_cast<char>(pick(256));
+                break;
+            case 1:
+                input.insert(input.begin() + static_cast<std::ptrdiff_t>(pick(input.size() + 1)), static_cast<char>(pick(256)));
+                break;
+            default:
+                // Repeated ranges are what super-linear parsers choke on
+                if (!input.empty()) {
+                    const std::size_t from = pick(input.size());
+                    const std::size_t length = 1 + pick(std::min<std::size_t>(16, input.size() - from));
+                    const std::string range = input.substr(from, length);
+                    for (std::size_t i = pick(64) + 1; i > 0; --i) input.insert(from, range);
+                }
+        }
+        if (input.size() > maxLen) input.resize(maxLen);
+        return input;
+    }
+
+    Settings parse(const int argc, char** argv) {
+        Settings s;
+        for (int i = 1; i < argc; ++i) {
+            const std::string key = argv[i];
+            if (key.starts_with("--")) {
+                if (i + 1 >= argc) throw std::invalid_argument("missing value for " + key);
+                const std::string value = argv[++i];
+                if (key == "--max-len") s.maxLen = std::stoul(value);
+                else if (key == "--runs") s.runs = std::stoul(value);
+                else if (key == "--seed") s.seed = static_cast<std::uint32_t>(std::stoul(value));
+                else throw std::invalid_argument("unknown option " + key);
+            } else {
+                s.corpus.emplace_back(key);
+            }
+        }
+        return s;
+    }
+} // namespace
+
+int main(const int argc, char** argv) {
+    Settings settings;
+    try {
+        settings = parse(argc, argv);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s: %s\nusage: %s [--max-len 65536] [--runs 0] [--seed 1] [corpus...]\n", argv[0], e.what(), argv[0]);
+        return 2;
+    }
+
+    const std::vector<std::string> corpus = loadCorpus(settings.corpus);
+    for (const auto& input : corpus) run(input);
+    std::printf("corpus: %zu inputs\n", corpus.size());
+
+    std::printf("%-24s %10s %12s %14s\n", "growth", "bytes", "ns/byte", "alloc/byte");
+    for (const auto& growth : fuzz::growthCases()) {
+        for (std::size_t repeats = 16; ; repeats *= 2) {
+            std::string input = growth.prefix;
+            for (std::size_t i = 0; i < repeats; ++i) input += growth.repeat;
+            input += growth.suffix;
+            if (input.size() > settings.maxLen) break;
+
+            fuzz::last() = {};
+            run(input);
+            const fuzz::Measurement& m = fuzz::last();
+            // Longer than anything the target can receive in production, it returned without measuring
+            if (m.bytes == 0) break;
+            const double bytes = static_cast<double>(std::max<std::size_t>(1, m.bytes));
+            std::printf("%-24s %10zu %12.1f %14s\n", growth.name.c_str(), m.bytes, m.ns / bytes,
+                profiling::AllocationTracker::kEnabled ? std::to_string(static_cast<double>(m.allocatedBytes) / bytes).c_str() : "-");
+        }
+    }
+
+    if (settings.runs > 0 && !corpus.empty()) {
+        std::mt19937 rng(settings.seed);
+        // Mutations stack up on every input, back to the original every 64 rounds
+        std::vector<std::string> current = corpus;
+        for (std::size_t i = 0; i < settings.runs; ++i) {
+            const std::size_t slot = i % corpus.size();
+            if ((i / corpus.size()) % 64 == 0) current[slot] = corpus[slot];
+            current[slot] = mutate(std::move(current[slot]), rng, settings.maxLen);
+            run(current[slot]);
+        }
+        std::printf("mutations: %zu\n", settings.runs);
+    }
+    return 0;
+}
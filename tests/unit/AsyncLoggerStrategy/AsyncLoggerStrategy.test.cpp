@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "core/loggers/strategies/AsyncLoggerStrategy.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+    std::filesystem::path logPath(const std::string& name) {
+        auto path = std::filesystem::temp_directory_path() / (name + "-" + std::to_string(::getpid()) + ".log");
+        std::filesystem::remove(path);
+        return path;
+    }
+
+    std::string readFile(const std::filesystem::path& path) {
+        std::ifstream in(path);
+        std::stringstream out;
+        out << in.rdbuf();
+        return out.str();
+    }
+}
+
+TEST(AsyncLoggerStrategyRings, RingRegisteredWhileAnotherIsRemovedIsDrained)
+{
+    const auto path = logPath("async-logger-rings");
+    constexpr int kSpawners = 8;
+    constexpr int kThreadsEach = 200;
+    {
+        // Short-lived threads: closed rings are removed by the writer while new ones keep registering
+        AsyncLoggerStrategy logger({.ringCapacity = 16, .filePath = path.string(), .maxIdle = std::chrono::milliseconds(1)});
+
+        std::vector<std::thread> spawners;
+        for (int s = 0; s < kSpawners; ++s) {
+            spawners.emplace_back([&, s] {
+                for (int t = 0; t < kThreadsEach; ++t) {
+                    const std::string msg = "thread-" + std::to_string(s * kThreadsEach + t);
+                    std::thread([&] { logger.log(LogLevel::INFO, msg, std::nullopt); }).join();
+                }
+            });
+        }
+        for (auto& spawner : spawners) spawner.join();
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (logger.stats().written < kSpawners * kThreadsEach && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_EQ(logger.stats().written, std::uint64_t{kSpawners * kThreadsEach});
+    }
+
+    const std::string text = readFile(path);
+    std::filesystem::remove(path);
+    for (int n = 0; n < kSpawners * kThreadsEach; ++n) {
+        EXPECT_NE(text.find(": thread-" + std::to_string(n) + "\n"), std::string::npos) << n;
+    }
+}
+
+TEST(AsyncLoggerStrategyFields, NullCStringIsLoggedAsNull)
+{
+    const auto path = logPath("async-logger-null");
+    {
+        AsyncLoggerStrategy logger({.filePath = path.string()});
+        const char* missing = nullptr;
+        static_cast<LoggerInterface&>(logger).write(LogLevel::INFO, "env", {{"value", missing}});
+        logger.flush();
+    }
+
+    const std::string text = readFile(path);
+    std::filesystem::remove(path);
+    EXPECT_NE(text.find(": env | Params: value=null\n"), std::string::npos) << text;
+}
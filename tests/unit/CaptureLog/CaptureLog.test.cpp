@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "core/capture/CaptureLog.h"
+
+#include <nlohmann/json.hpp>
+
+using capture::Redactor;
+
+TEST(RedactorTarget, KeepsTargetsWithoutSensitiveParameters)
+{
+    const Redactor redactor;
+    EXPECT_EQ(redactor.target("/users"), "/users");
+    EXPECT_EQ(redactor.target("/users?limit=20&offset=40"), "/users?limit=20&offset=40");
+    EXPECT_EQ(redactor.target("/users?id__in=1,2,3&flag"), "/users?id__in=1,2,3&flag");
+    EXPECT_EQ(redactor.target("/users?"), "/users?");
+}
+
+TEST(RedactorTarget, PseudonymizesSensitiveValues)
+{
+    const Redactor redactor;
+    EXPECT_EQ(redactor.target("/users?limit=5&username=alice"),
+        "/users?limit=5&username=" + redactor.pseudonym("alice"));
+    // Decoded first: the same pseudonym as the email in a JSON body
+    EXPECT_EQ(redactor.target("/users?email=a%40b.c"),
+        "/users?email=" + redactor.pseudonym("a@b.c") + "@example.com");
+    EXPECT_EQ(redactor.target("/users?username__like=al+ice"),
+        "/users?username__like=" + redactor.pseudonym("al ice"));
+    EXPECT_EQ(redactor.target("/login?token=abc&next=%2Fhome"),
+        "/login?token=" + redactor.pseudonym("abc") + "&next=%2Fhome");
+}
+
+TEST(RedactorTarget, InListsItemByItem)
+{
+    const Redactor redactor;
+    EXPECT_EQ(redactor.target("/users?username__in=alice,bob&limit=2"),
+        "/users?username__in=" + redactor.pseudonym("alice") + "," + redactor.pseudonym("bob") + "&limit=2");
+}
+
+TEST(RedactorTarget, EncodedParameterNamesAreMatched)
+{
+    const Redactor redactor;
+    EXPECT_EQ(redactor.target("/users?e%6Dail=x"),
+        "/users?e%6Dail=" + redactor.pseudonym("x") + "@example.com");
+}
+
+TEST(RedactorBody, JsonFieldsMatchTargetPseudonyms)
+{
+    const Redactor redactor;
+    const nlohmann::json body = nlohmann::json::parse(
+        redactor.body("application/json", R"({"username":"alice","email":"a@b.c","age":3})"));
+    EXPECT_EQ(body["username"], redactor.pseudonym("alice"));
+    EXPECT_EQ(body["email"], redactor.pseudonym("a@b.c") + "@example.com");
+    EXPECT_EQ(body["age"], 3);
+}
+
+TEST(RedactorHeaders, SensitiveRedactedHopByHopDropped)
+{
+    const Redactor redactor;
+    const auto headers = redactor.headers({{"Authorization", "Bearer x"}, {"Connection", "close"}, {"Accept", "*/*"}});
+    ASSERT_EQ(headers.size(), 2u);
+    EXPECT_EQ(headers[0].second, capture::kRedacted);
+    EXPECT_EQ(headers[1].second, "*/*");
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "core/metrics/HdrHistogram.h"
+
+#include <cstdint>
+
+using metrics::HdrHistogram;
+
+TEST(HdrHistogramBuckets, SmallValuesAreExact)
+{
+    for (std::uint64_t v = 0; v < HdrHistogram::kSubBuckets; ++v) {
+        EXPECT_EQ(HdrHistogram::bucketFor(v), v);
+        EXPECT_EQ(HdrHistogram::upperBound(v), v);
+    }
+}
+
+TEST(HdrHistogramBuckets, PowerOfTwoBoundaries)
+{
+    // [8, 16) still has width 1, [16, 32) is split into 8 buckets of width 2
+    EXPECT_EQ(HdrHistogram::bucketFor(8), 8u);
+    EXPECT_EQ(HdrHistogram::bucketFor(15), 15u);
+    EXPECT_EQ(HdrHistogram::bucketFor(16), 16u);
+    EXPECT_EQ(HdrHistogram::bucketFor(17), 16u);
+    EXPECT_EQ(HdrHistogram::bucketFor(18), 17u);
+    EXPECT_EQ(HdrHistogram::upperBound(16), 17u);
+    EXPECT_EQ(HdrHistogram::bucketFor(31), 23u);
+    EXPECT_EQ(HdrHistogram::bucketFor(32), 24u);
+    EXPECT_EQ(HdrHistogram::upperBound(23), 31u);
+}
+
+TEST(HdrHistogramBuckets, EveryValueFallsBetweenNeighbouringUpperBounds)
+{
+    std::size_t previous = 0;
+    for (std::uint64_t v = 0; v < 200000; ++v) {
+        const std::size_t bucket = HdrHistogram::bucketFor(v);
+        ASSERT_GE(bucket, previous) << v;
+        ASSERT_LE(v, HdrHistogram::upperBound(bucket)) << v;
+        if (bucket > 0) ASSERT_GT(v, HdrHistogram::upperBound(bucket - 1)) << v;
+        previous = bucket;
+    }
+}
+
+TEST(HdrHistogramBuckets, RelativeWidthIsBounded)
+{
+    for (std::size_t bucket = HdrHistogram::kSubBuckets; bucket < HdrHistogram::kBuckets; ++bucket) {
+        const std::uint64_t lower = HdrHistogram::upperBound(bucket - 1) + 1;
+        const std::uint64_t upper = HdrHistogram::upperBound(bucket);
+        EXPECT_LE(static_cast<double>(upper - lower + 1) / static_cast<double>(lower), 1.0 / HdrHistogram::kSubBuckets)
+            << bucket;
+    }
+}
+
+TEST(HdrHistogramBuckets, HugeValuesLandInTheLastBucket)
+{
+    const std::uint64_t top = std::uint64_t{1} << (HdrHistogram::kMaxExponent + 1);
+    EXPECT_EQ(HdrHistogram::bucketFor(top - 1), HdrHistogram::kBuckets - 1);
+    EXPECT_EQ(HdrHistogram::upperBound(HdrHistogram::kBuckets - 1), top - 1);
+    EXPECT_EQ(HdrHistogram::bucketFor(top), HdrHistogram::kBuckets - 1);
+    EXPECT_EQ(HdrHistogram::bucketFor(UINT64_MAX), HdrHistogram::kBuckets - 1);
+}
+
+TEST(HdrHistogramPercentile, UniformDistributionWithinBucketError)
+{
+    HdrHistogram h;
+    for (std::uint64_t v = 1; v <= 100000; ++v) h.record(v);
+
+    EXPECT_EQ(h.count(), 100000u);
+    EXPECT_DOUBLE_EQ(h.mean(), 50000.5);
+    // Reported as the bucket's upper bound: never below the exact value, at most 1/8 above
+    for (const double p : {1.0, 25.0, 50.0, 90.0, 99.0, 99.9}) {
+        const auto exact = static_cast<double>(p * 1000.0);
+        const auto reported = static_cast<double>(h.percentile(p));
+        EXPECT_GE(reported, exact) << p;
+        EXPECT_LE(reported, exact * (1.0 + 1.0 / HdrHistogram::kSubBuckets)) << p;
+    }
+    EXPECT_EQ(h.percentile(100), 100000u);
+}
+
+TEST(HdrHistogramPercentile, TailOfBimodalDistribution)
+{
+    HdrHistogram h;
+    h.record(100, 990);
+    h.record(10000, 10);
+
+    EXPECT_LE(h.percentile(50), 100u * 9 / 8);
+    EXPECT_LE(h.percentile(99), 100u * 9 / 8);
+    EXPECT_GE(h.percentile(99.1), 10000u);
+    EXPECT_EQ(h.percentile(100), 10000u);
+}
+
+TEST(HdrHistogramPercentile, EmptyAndCappedByMax)
+{
+    HdrHistogram h;
+    EXPECT_EQ(h.percentile(50), 0u);
+
+    // 1000 sits in a bucket reaching 1023, the observed max wins
+    h.record(1000);
+    EXPECT_EQ(h.percentile(50), 1000u);
+    EXPECT_EQ(h.max(), 1000u);
+}
+
+TEST(HdrHistogramMerge, SameAsRecordingEverythingInOne)
+{
+    HdrHistogram all;
+    HdrHistogram a;
+    HdrHistogram b;
+    for (std::uint64_t v = 1; v <= 5000; ++v) {
+        all.record(v * 7);
+        (v % 3 ? a : b).record(v * 7);
+    }
+    a.merge(b);
+
+    EXPECT_EQ(a.buckets(), all.buckets());
+    EXPECT_EQ(a.count(), all.count());
+    EXPECT_EQ(a.sum(), all.sum());
+    EXPECT_EQ(a.max(), all.max());
+    EXPECT_EQ(a.percentile(99), all.percentile(99));
+
+    a.reset();
+    EXPECT_EQ(a.count(), 0u);
+    EXPECT_EQ(a.percentile(50), 0u);
+}
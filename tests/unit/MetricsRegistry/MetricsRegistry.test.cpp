@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "core/metrics/MetricsRegistry.h"
+
+#include <barrier>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using metrics::HdrHistogram;
+using metrics::MetricsRegistry;
+
+namespace {
+    /// The registry is process-wide: every test registers its own metric names
+    MetricsRegistry& registry() {
+        return MetricsRegistry::instance();
+    }
+
+    /// Value of one rendered series line, "" when it is missing
+    std::string scraped(const std::string& series) {
+        const std::string text = "\n" + registry().render();
+        const std::string prefix = "\n" + series + " ";
+        const auto at = text.find(prefix);
+        if (at == std::string::npos) return "";
+        const auto begin = at + prefix.size();
+        return text.substr(begin, text.find('\n', begin) - begin);
+    }
+
+    /// Runs fn on n threads; all of them are still alive when whileAlive runs, then they exit
+    template <class Fn, class Check>
+    void onThreads(const int n, Fn fn, Check whileAlive) {
+        std::barrier recorded(n + 1);
+        std::barrier checked(n + 1);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < n; ++i) {
+            threads.emplace_back([&, i] {
+                fn(i);
+                recorded.arrive_and_wait();
+                checked.arrive_and_wait();
+            });
+        }
+        recorded.arrive_and_wait();
+        whileAlive();
+        checked.arrive_and_wait();
+        for (auto& thread : threads) thread.join();
+    }
+}
+
+TEST(MetricsRegistryShards, CounterSumsLiveAndExitedThreads)
+{
+    const auto counter = registry().counter("unit_shard_counter_total", "test");
+
+    onThreads(4, [&](const int) {
+        for (int i = 0; i < 1000; ++i) counter.inc();
+    }, [] {
+        EXPECT_EQ(scraped("unit_shard_counter_total"), "4000");
+    });
+    // Exited threads were folded into the retired values
+    EXPECT_EQ(scraped("unit_shard_counter_total"), "4000");
+
+    counter.inc(5);
+    EXPECT_EQ(scraped("unit_shard_counter_total"), "4005");
+}
+
+TEST(MetricsRegistryShards, GaugeDeltasCancelAcrossThreads)
+{
+    const auto gauge = registry().gauge("unit_shard_gauge", "test");
+
+    std::thread([&] { for (int i = 0; i < 10; ++i) gauge.inc(); }).join();
+    std::thread([&] { for (int i = 0; i < 13; ++i) gauge.dec(); }).join();
+    EXPECT_EQ(scraped("unit_shard_gauge"), "-3");
+
+    gauge.add(3);
+    EXPECT_EQ(scraped("unit_shard_gauge"), "0");
+}
+
+TEST(MetricsRegistryShards, HistogramSnapshotMergesShards)
+{
+    const auto histogram = registry().histogram("unit_shard_histogram", "test");
+
+    HdrHistogram expected;
+    for (int t = 0; t < 4; ++t) {
+        for (std::uint64_t v = 1; v <= 1000; ++v) expected.record(v * (t + 1));
+    }
+
+    onThreads(4, [&](const int t) {
+        for (std::uint64_t v = 1; v <= 1000; ++v) histogram.record(v * (t + 1));
+    }, [&] {
+        const HdrHistogram live = registry().snapshot(histogram);
+        EXPECT_EQ(live.buckets(), expected.buckets());
+        EXPECT_EQ(live.sum(), expected.sum());
+    });
+
+    const HdrHistogram merged = registry().snapshot(histogram);
+    EXPECT_EQ(merged.buckets(), expected.buckets());
+    EXPECT_EQ(merged.count(), 4000u);
+    EXPECT_EQ(merged.sum(), expected.sum());
+    EXPECT_EQ(merged.percentile(50), expected.percentile(50));
+}
+
+TEST(MetricsRegistryRender, HistogramBucketsAreCumulative)
+{
+    const auto family = registry().histogramFamily("unit_render_seconds", "test", {"route"}, {0.001, 0.01});
+    const auto histogram = family.with({"/a"});
+
+    // 500 us -> fine bucket up to 511, 5000 us -> up to 5119, 20 ms only in +Inf
+    histogram.record(500);
+    histogram.record(5000);
+    histogram.record(20000);
+
+    EXPECT_EQ(scraped(R"(unit_render_seconds_bucket{route="/a",le="0.001"})"), "1");
+    EXPECT_EQ(scraped(R"(unit_render_seconds_bucket{route="/a",le="0.01"})"), "2");
+    EXPECT_EQ(scraped(R"(unit_render_seconds_bucket{route="/a",le="+Inf"})"), "3");
+    EXPECT_EQ(scraped(R"(unit_render_seconds_count{route="/a"})"), "3");
+    EXPECT_DOUBLE_EQ(std::stod(scraped(R"(unit_render_seconds_sum{route="/a"})")), 0.0255);
+}
+
+TEST(MetricsRegistryRender, LabelValuesAreEscaped)
+{
+    registry().counterFamily("unit_escaped_total", "test", {"path"}).with({"a\"b\\c\nd"}).inc();
+    EXPECT_EQ(scraped(R"(unit_escaped_total{path="a\"b\\c\nd"})"), "1");
+}
+
+TEST(MetricsRegistryRegistration, SameNameReturnsSameSeries)
+{
+    registry().counter("unit_twice_total", "test").inc();
+    registry().counter("unit_twice_total", "test").inc();
+    EXPECT_EQ(scraped("unit_twice_total"), "2");
+}
+
+TEST(MetricsRegistryRegistration, RejectsShapeMismatch)
+{
+    registry().counterFamily("unit_shape_total", "test", {"a"});
+    EXPECT_THROW(registry().gaugeFamily("unit_shape_total", "test", {"a"}), std::logic_error);
+    EXPECT_THROW(registry().counterFamily("unit_shape_total", "test", {"b"}), std::logic_error);
+    EXPECT_THROW(registry().counterFamily("unit_shape_total", "test", {"a"}).with({"1", "2"}), std::logic_error);
+}
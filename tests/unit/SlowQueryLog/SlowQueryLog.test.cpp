@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "core/db/postgres/interfaces/SlowQueryLog.h"
+
+TEST(SlowQueryLogNormalize, StringLiteralsBecomePlaceholders)
+{
+    EXPECT_EQ(SlowQueryLog::normalize("SELECT * FROM users WHERE email = 'a@b.c'"),
+        "SELECT * FROM users WHERE email = ?");
+    // Doubled quote is part of the literal, not its end
+    EXPECT_EQ(SlowQueryLog::normalize("UPDATE users SET bio = 'it''s me' WHERE id = 1"),
+        "UPDATE users SET bio = ? WHERE id = ?");
+    // Unterminated literal is swallowed up to the end
+    EXPECT_EQ(SlowQueryLog::normalize("SELECT 'oops"), "SELECT ?");
+}
+
+TEST(SlowQueryLogNormalize, NumericLiteralsBecomePlaceholders)
+{
+    EXPECT_EQ(SlowQueryLog::normalize("SELECT * FROM users LIMIT 20 OFFSET 40"),
+        "SELECT * FROM users LIMIT ? OFFSET ?");
+    EXPECT_EQ(SlowQueryLog::normalize("SELECT price * 1.25 FROM items"), "SELECT price * ? FROM items");
+    EXPECT_EQ(SlowQueryLog::normalize("SELECT * FROM t WHERE id IN (1,2,3)"), "SELECT * FROM t WHERE id IN (?,?,?)");
+}
+
+TEST(SlowQueryLogNormalize, KeepsPlaceholdersAndIdentifiersWithDigits)
+{
+    EXPECT_EQ(SlowQueryLog::normalize("SELECT col1 FROM t2 WHERE id = $1 AND name = $12"),
+        "SELECT col1 FROM t2 WHERE id = $1 AND name = $12");
+}
+
+TEST(SlowQueryLogNormalize, CollapsesWhitespace)
+{
+    EXPECT_EQ(SlowQueryLog::normalize("  SELECT\n\t id\n  FROM   users  \n"), "SELECT id FROM users");
+}
+
+TEST(SlowQueryLogNormalize, SameShapeForDifferentLiterals)
+{
+    EXPECT_EQ(SlowQueryLog::normalize("SELECT * FROM users WHERE id = 7 AND name = 'x'"),
+        SlowQueryLog::normalize("SELECT * FROM users WHERE id = 123456 AND name = 'another'"));
+}
+
+TEST(SlowQueryLogNormalize, CapsLength)
+{
+    const std::string sql = "SELECT " + std::string(10000, 'x');
+    EXPECT_LE(SlowQueryLog::normalize(sql).size(), 2048u);
+}
+
+TEST(SlowQueryLogExplainable, AcceptsReadOnlyStatements)
+{
+    EXPECT_TRUE(SlowQueryLog::explainable("SELECT 1"));
+    EXPECT_TRUE(SlowQueryLog::explainable("  select * from users"));
+    EXPECT_TRUE(SlowQueryLog::explainable("(SELECT id FROM a) UNION (SELECT id FROM b)"));
+    EXPECT_TRUE(SlowQueryLog::explainable("WITH recent AS (SELECT * FROM users) SELECT * FROM recent"));
+}
+
+TEST(SlowQueryLogExplainable, RejectsWrites)
+{
+    EXPECT_FALSE(SlowQueryLog::explainable("INSERT INTO users (id) VALUES ($1)"));
+    EXPECT_FALSE(SlowQueryLog::explainable("UPDATE users SET name = $1"));
+    EXPECT_FALSE(SlowQueryLog::explainable("DELETE FROM users"));
+    EXPECT_FALSE(SlowQueryLog::explainable("BEGIN"));
+    EXPECT_FALSE(SlowQueryLog::explainable(""));
+}
+
+TEST(SlowQueryLogExplainable, RejectsDataModifyingCte)
+{
+    EXPECT_FALSE(SlowQueryLog::explainable(
+        "WITH gone AS (DELETE FROM users WHERE id = $1 RETURNING id) SELECT * FROM gone"));
+    EXPECT_FALSE(SlowQueryLog::explainable(
+        "with moved as (update users set name = 'x' returning id) select id from moved"));
+}
+
+TEST(SlowQueryLogExplainable, MatchesWholeWordsOnly)
+{
+    EXPECT_FALSE(SlowQueryLog::explainable("selection_refresh()"));
+    EXPECT_FALSE(SlowQueryLog::explainable("without_rows"));
+    // Column names that merely contain a verb do not disqualify a CTE
+    EXPECT_TRUE(SlowQueryLog::explainable("WITH u AS (SELECT updated_at FROM users) SELECT * FROM u"));
+}